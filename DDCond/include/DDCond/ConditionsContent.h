@@ -19,7 +19,10 @@
 #include "DD4hep/ConditionDerived.h"
 
 // C/C++ include files
+#include <mutex>
+#include <vector>
 #include <memory>
+#include <cstdint>
 #include <unordered_map>
 
 /// Namespace for the AIDA detector description toolkit
@@ -60,6 +63,9 @@ namespace dd4hep {
       template<typename T> T*       data() const {  return (T*)ptr(); }
     };
 
+    // Forward declarations
+    class ConditionsDependencyGraph;
+
     /// Conditions content object. Defines which conditions should be loaded by the ConditionsManager.
     /**
      *  Object contains set of required conditions keys to be loaded to the user pool.
@@ -107,6 +113,10 @@ namespace dd4hep {
       Conditions        m_conditions;
       /// Container of derived conditions required by this content
       Dependencies      m_derived;
+      /// Cached dependency graph of the derived conditions
+      mutable std::shared_ptr<const ConditionsDependencyGraph> m_graph;   //!
+      /// Lock protecting the creation of the dependency graph
+      mutable std::mutex                                       m_graphLock;   //!
 
     private:
       /// Default assignment operator
@@ -155,6 +165,50 @@ namespace dd4hep {
       /// Add a new conditions dependency (Built internally from arguments)
       std::pair<Condition::key_type, ConditionDependency*>
       addDependency(DetElement de, Condition::itemkey_type item, std::shared_ptr<ConditionUpdateCall> callback);
+      /// Access the dependency graph of the derived conditions. Built on first access.
+      /** The graph is rebuilt if the derived conditions changed. Thread safe.   */
+      std::shared_ptr<const ConditionsDependencyGraph> dependencyGraph()  const;
+    };
+
+    /// Dependency graph of the derived conditions of a ConditionsContent object
+    /**
+     *  Nodes are the derived conditions in the order of the content's container.
+     *  An edge connects a derived condition to all derived conditions,
+     *  which declare it as an input in their list of dependencies.
+     *  Inputs, which are not derived themselves, are kept in a separate table
+     *  pointing to the derived conditions using them.
+     *  The graph is immutable once built and may be shared between threads.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsDependencyGraph  {
+    public:
+      /// Keys of the derived conditions (sorted)
+      std::vector<Condition::key_type>  keys;
+      /// Successors of node i are successors[offsets[i]] ... successors[offsets[i+1]-1]
+      std::vector<std::uint32_t>        offsets;
+      /// Successor table: nodes using a node as input
+      std::vector<std::uint32_t>        successors;
+      /// Keys of the input conditions, which are not derived (sorted)
+      std::vector<Condition::key_type>  inputs;
+      /// Users of input i are users[input_offsets[i]] ... users[input_offsets[i+1]-1]
+      std::vector<std::uint32_t>        input_offsets;
+      /// User table: derived nodes using a non-derived input
+      std::vector<std::uint32_t>        users;
+
+    public:
+      /// Initializing constructor
+      ConditionsDependencyGraph(const ConditionsContent::Dependencies& derived);
+      /// Number of nodes
+      std::size_t size()  const  {  return keys.size();  }
+      /// Access the node index of a derived condition. Returns size() if not present
+      std::size_t index(Condition::key_type key)  const;
+      /// Collect the keys of all derived conditions depending directly or indirectly on one of the changed keys
+      /** The keys are appended to the result in ascending order without duplicates. */
+      std::size_t dependents(const std::vector<Condition::key_type>& changed,
+                             std::vector<Condition::key_type>& result)  const;
     };
 
     template <> inline
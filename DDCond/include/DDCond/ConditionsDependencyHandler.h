@@ -19,6 +19,14 @@
 #include "DDCond/ConditionsPool.h"
 #include "DDCond/ConditionsManager.h"
 
+// C/C++ include files
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <shared_mutex>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -29,6 +37,7 @@ namespace dd4hep {
     class UserPool;
     class ConditionsPool;
     class ConditionsManagerObject;
+    class ConditionsDependencyGraph;
     
     /// Callback handler to update condition dependencies.
     /** 
@@ -44,6 +53,19 @@ namespace dd4hep {
      *  ConditionResolver interface in order to allow for upgrades of
      *  this implementation which might not be polymorph.
      *
+     *  Parallel execution:
+     *  If a dependency graph is supplied and the conditions manager property
+     *  "NumberOfThreads" is larger than 1, the items of both passes are
+     *  executed concurrently on a TBB task arena. An item is only started once
+     *  all derived conditions declared as its inputs are processed. Accesses
+     *  to other items (declared or not) follow the recursive on-demand
+     *  resolution of the serial execution. Each item is protected by its own
+     *  lock, hence circular dependencies between items processed by different
+     *  threads must not occur. Items on circular declared dependencies are
+     *  processed serially after the parallel pass. The callbacks and the
+     *  optional user parameter must be thread safe in this mode.
+     *  Without TBB support all items are processed serially.
+     *
      *  \author  M.Frank
      *  \version 1.0
      */
@@ -64,7 +86,9 @@ namespace dd4hep {
         /// Flag to detect non resolvable circular dependencies
         int                        callstack = 0;
         /// Current conversion state of the item
-        State                      state     = INVALID;
+        std::atomic<State>         state     { INVALID };
+        /// Lock protecting the item against concurrent creation and resolution
+        std::recursive_mutex       lock;
       public:
         /// Inhibit default constructor
         Work() = delete;
@@ -74,10 +98,10 @@ namespace dd4hep {
              ConditionUpdateUserContext* u,
              const IOV& i)
           : _iov(i), context(r,d,&_iov,u) {}
-        /// Copy constructor
-        Work(const Work&) = default;
-        /// Assignment operator
-        Work& operator=(const Work&) = default;
+        /// Inhibit copy constructor
+        Work(const Work&) = delete;
+        /// Inhibit assignment operator
+        Work& operator=(const Work&) = delete;
         /// Helper to determine the IOV intersection taking into account dependencies
         void do_intersection(const IOV* iov);
         /// Helper function for the second level dependency resolution
@@ -103,15 +127,21 @@ namespace dd4hep {
       State                       m_state = CREATED;
       /// Current block work item
       Work*                       m_block = 0;
-      /// Current item of the block
-      Work*                       m_currentWork = 0;
+      /// Optional dependency graph to execute the items in parallel
+      std::shared_ptr<const ConditionsDependencyGraph> m_graph;
+      /// Lock protecting the user pool against insertions during parallel execution
+      std::shared_timed_mutex     m_poolLock;
     public:
       /// Number of callbacks to the handler for monitoring
-      mutable size_t              num_callback;
+      mutable std::atomic<size_t> num_callback;
 
     protected:
+      /// Current item of the block. Thread local to allow for parallel execution
+      static Work*& currentWork();
       /// Internal call to trigger update callback
       void do_callback(Work* dep);
+      /// Execute a processing step for all items. In parallel if possible
+      void execute(const std::function<void(Work*)>& step);
 
     public:
       /// Initializing constructor
@@ -124,6 +154,8 @@ namespace dd4hep {
 
       /// Access the conditions created during processing
       //const CreatedConditions& created()  const                  { return m_created;         }
+      /// Supply the dependency graph of the content to enable parallel execution
+      void setDependencyGraph(std::shared_ptr<const ConditionsDependencyGraph> graph);
       /// 1rst pass: Compute/create the missing conditions
       void compute();
       /// 2nd pass:  Handler callback for the second turn to resolve missing dependencies
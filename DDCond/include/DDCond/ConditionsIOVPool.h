@@ -18,7 +18,12 @@
 
 // C/C++ include files
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <vector>
+#include <cstdint>
+#include <shared_mutex>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -31,6 +36,20 @@ namespace dd4hep {
      *  Purely internal class to the conditions manager implementation.
      *  Not at all to be accessed by clients!
      *
+     *  Thread safety:
+     *  The container of pools is protected by a reader-writer lock.
+     *  All selections acquire shared ownership and may run in parallel.
+     *  Pool insertions, condition registrations and cleanups acquire exclusive ownership.
+     *  Every registration and cleanup increments the generation counter, so that clients
+     *  may detect whether a previous selection is still complete.
+     *  Loading and computing missing conditions is serialized by the update lock.
+     *
+     *  Selections by IOV use a search index over the validity ranges of the pools,
+     *  which is rebuilt on the first selection after a modification of the container.
+     *  The pool ages are derived from a selection clock rather than being updated
+     *  for every pool at each selection. Hence the selection cost grows with the
+     *  logarithm of the number of pools plus the number of selected pools.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_CONDITIONS
@@ -42,16 +61,72 @@ namespace dd4hep {
       /// Shortcut name for the actual conditions container
       typedef std::map<IOV::Key, Element >    Elements;      
 
+      /// Search index over the validity ranges of the pools
+      /**
+       *  The pools are kept in the order of the container, i.e. sorted by the lower
+       *  bound of the validity. A segment tree stores the maximal upper bound of
+       *  every sub-range. A second table sorts the pools by the upper bound.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Index  {
+      public:
+        /// Validity keys of the pools (sorted)
+        std::vector<IOV::Key>             keys;
+        /// Pools in the order of the keys
+        std::vector<Element>              pools;
+        /// Segment tree of the maximal upper bound. Leaves start at index 'width'
+        std::vector<IOV::Key_value_type>  max_upper;
+        /// Pool indices sorted by the upper bound of the validity
+        std::vector<std::uint32_t>        by_upper;
+        /// Number of leaves of the segment tree (power of 2)
+        std::size_t                       width = 0;
+      public:
+        /// Rebuild the index from the container of pools
+        void build(const Elements& elements);
+        /// Collect the indices of all pools containing the range [req.first, req.second] (sorted)
+        std::size_t containing(const IOV::Key& req, std::vector<std::uint32_t>& result)  const;
+        /// Collect the indices of all pools with a boundary inside [range.first, range.second] (sorted)
+        std::size_t bounded(const IOV::Key& range, std::vector<std::uint32_t>& result)  const;
+      };
+
       /// Container of IOV dependent conditions pools
       Elements elements;     //! Not ROOT persistent
       /// Reference to the IOV container
       const IOVType* type;   //! Not ROOT persistent
+      /// Reader-writer lock protecting the container of pools and the pool content
+      mutable std::shared_timed_mutex lock;   //! Not ROOT persistent
+      /// Lock to serialize loading and computing of missing conditions
+      std::mutex                      update_lock;   //! Not ROOT persistent
+      /// Modification counter. Incremented at each pool insertion, condition registration or cleanup
+      std::atomic<long>               generation  { 0 };   //! Not ROOT persistent
+      /// Number of aging selections. The age of a pool is the difference to its stamp
+      std::atomic<long>               age_clock   { 0 };   //! Not ROOT persistent
+
+    protected:
+      /// Search index over the validity ranges. Only valid if 'index_valid' is set
+      Index                           index;         //! Not ROOT persistent
+      /// Flag indicating that the index corresponds to the container of pools
+      std::atomic<bool>               index_valid { false };   //! Not ROOT persistent
+      /// Lock serializing the rebuild of the index by concurrent selections
+      std::mutex                      index_lock;    //! Not ROOT persistent
+
+      /// Access the search index. Rebuilt if necessary. Requires (shared) ownership of the lock
+      const Index& i_index();
+      /// Update the age value of all pools from the selection clock
+      void i_updateAges();
       
     public:
       /// Default constructor
       ConditionsIOVPool(const IOVType* type);
       /// Default destructor
       virtual ~ConditionsIOVPool();
+      /// Access the pool for a given IOV key. Returns NULL if not present
+      ConditionsPool* find(const IOV::Key& key)  const;
+      /// Insert a new pool for the given IOV key. If already present, the existing pool is returned
+      ConditionsPool* insert(const IOV::Key& key, Element pool);
       /// Retrieve  a condition set given the key according to their validity
       size_t select(Condition::key_type key, const IOV& req_validity, RangeConditions& result);
       /// Retrieve  a condition set given the key according to their validity
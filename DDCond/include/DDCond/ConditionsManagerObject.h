@@ -72,6 +72,12 @@ namespace dd4hep {
       bool                   m_doLoad = true;
       /// Property: Flag to indicate if unloaded items should be saved to the slice (or not)
       bool                   m_doOutputUnloaded = false;
+      /// Property: Number of threads to compute derived conditions. Serial if smaller than 2.
+      int                    m_numThreads = 0;
+      /// Property: Flag to update the user pools incrementally at IOV changes
+      bool                   m_doIncremental = false;
+      /// Property: Flag to load missing conditions on first access instead of during the preparation
+      bool                   m_doLazyLoad = false;
 
       /// Register callback listener object
       void registerCallee(Listeners& listeners, const Listener& callee, bool add);
@@ -96,6 +102,15 @@ namespace dd4hep {
       /// Access to flag to indicate if unloaded items should be saved to the slice (or not)
       bool doOutputUnloaded()  const        {  return m_doOutputUnloaded;     }
 
+      /// Access to the number of threads used to compute derived conditions
+      int numThreads()  const               {  return m_numThreads;           }
+
+      /// Access to flag to update the user pools incrementally at IOV changes
+      bool doIncrementalPrepare()  const    {  return m_doIncremental;        }
+
+      /// Access to flag to load missing conditions on first access
+      bool doLazyLoad()  const              {  return m_doLazyLoad;           }
+
       /// Listener invocation when a condition is registered to the cache
       void onRegister(Condition condition);
 
@@ -0,0 +1,220 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDCOND_CONDITIONSMMAPPERSISTENCY_H
+#define DDCOND_CONDITIONSMMAPPERSISTENCY_H
+
+// Framework include files
+#include "DDCond/ConditionsPool.h"
+
+// C/C++ include files
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <typeinfo>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Forward declarations
+  class BasicGrammar;
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond {
+
+    /// Forward declarations
+    class ConditionsIOVPool;
+
+    /// Helper to save conditions pools to a flat binary snapshot, which is memory mapped when read
+    /**
+     *  Like the ConditionsRootPersistency this mechanism stores and retrieves
+     *  entire snapshots of the conditions store. Contrary to ROOT I/O the
+     *  snapshot is not streamed when read: the file is mapped into memory and
+     *  the conditions are only materialized when accessed for the first time.
+     *  Hence startup does not depend on the size of the snapshot.
+     *
+     *  Layout of the snapshot (native byte order, all sections 8 byte aligned):
+     *  - FileHeader:   magic word, format version and the section table.
+     *  - PoolRecords:  one record per conditions pool sorted by IOV type and IOV key.
+     *  - EntryRecords: one record per condition. The entries of a pool are contiguous
+     *                  and sorted by the condition key.
+     *  - Strings:      zero terminated names, types and values of the conditions.
+     *  - Data:         flat payloads of the conditions referenced by offset.
+     *
+     *  Only payloads with a flat binary representation are supported:
+     *  basic types, std::string, std::vector of basic types, Delta and AlignmentData.
+     *  The geometry references of AlignmentData (detector element, placements)
+     *  are not saved. Conditions with other payload types are skipped when saving.
+     *
+     *  Materialization is not protected against concurrent access.
+     *  Callers like the snapshot loader are serialized by the conditions manager.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsMmapPersistency  {
+    public:
+      typedef std::vector<Condition>  pool_type;
+
+      /// Current version of the snapshot format
+      enum { FORMAT_VERSION = 1 };
+
+      /// Snapshot file header
+      struct FileHeader   {
+        /// Magic word "DD4hCOND"
+        char           magic[8];
+        /// Format version
+        std::uint32_t  version;
+        /// Size of the file header in bytes
+        std::uint32_t  header_size;
+        /// Total size of the snapshot in bytes
+        std::uint64_t  file_size;
+        /// Number of pool records and offset of the first record
+        std::uint64_t  num_pools,     pool_offset;
+        /// Number of entry records and offset of the first record
+        std::uint64_t  num_entries,   entry_offset;
+        /// Offset and size of the string section
+        std::uint64_t  string_offset, string_size;
+        /// Offset and size of the data section
+        std::uint64_t  data_offset,   data_size;
+      };
+      /// Snapshot record of one conditions pool
+      struct PoolRecord   {
+        /// IOV key of the pool
+        std::int64_t   lower, upper;
+        /// IOV type index
+        std::uint32_t  iov_type;
+        /// Offset of the IOV type name in the string section
+        std::uint32_t  iov_name;
+        /// Index of the first entry record of this pool
+        std::uint64_t  first_entry;
+        /// Number of entry records of this pool
+        std::uint64_t  num_entries;
+      };
+      /// Snapshot record of one condition
+      struct EntryRecord   {
+        /// Condition key
+        std::uint64_t  key;
+        /// Hash code of the payload grammar
+        std::uint64_t  grammar;
+        /// Payload offset relative to the data section
+        std::uint64_t  offset;
+        /// Payload size in bytes
+        std::uint64_t  size;
+        /// Number of payload items (containers)
+        std::uint64_t  count;
+        /// Offsets of the condition name, type and value in the string section
+        std::uint32_t  name, type, value;
+        /// Condition flags
+        std::uint32_t  flags;
+      };
+      /// Flat binary conversion of a payload type
+      struct Codec   {
+        /// Payload type
+        const std::type_info* type;
+        /// Append the flat payload to the buffer and set the number of items
+        void (*write)(const void* object, std::string& buffer, std::uint64_t& count);
+        /// Fill the bound payload object from its flat representation
+        void (*read)(void* object, const char* data, std::uint64_t size, std::uint64_t count);
+      };
+
+    protected:
+      /// Definition of a pool to be saved
+      struct SavePool   {
+        std::string iov_name;
+        std::size_t iov_type;
+        IOV::Key    key;
+        pool_type   conditions;
+      };
+      /// Pools to be saved. The conditions are reference counted
+      std::vector<SavePool>          m_save;
+      /// Start address of the mapped snapshot
+      const char*                    m_base    = 0;
+      /// Length of the mapped snapshot
+      std::size_t                    m_length  = 0;
+      /// Section pointers into the mapped snapshot
+      const FileHeader*              m_header  = 0;
+      const PoolRecord*              m_pools   = 0;
+      const EntryRecord*             m_entries = 0;
+      const char*                    m_strings = 0;
+      const char*                    m_data    = 0;
+      /// Conditions materialized by get() (one slot per entry record, filled on first access)
+      std::vector<Condition::Object*> m_objects;
+      /// Payload grammars and codecs resolved from the grammar hash codes
+      std::map<std::uint64_t,std::pair<const BasicGrammar*,const Codec*> > m_codecs;
+
+      /// Map the snapshot file and check the header
+      void i_map(const std::string& file_name);
+      /// Release the mapping
+      void i_unmap();
+      /// Create a new condition object from an entry record
+      Condition i_materialize(const EntryRecord& entry);
+
+    public:
+      /// Duration of the last save, load or import operation in seconds
+      float duration = 0;
+
+    public:
+      /// Default constructor
+      ConditionsMmapPersistency() = default;
+      /// No copy constructor
+      ConditionsMmapPersistency(const ConditionsMmapPersistency& copy) = delete;
+      /// Default destructor
+      virtual ~ConditionsMmapPersistency();
+      /// No assignment
+      ConditionsMmapPersistency& operator=(const ConditionsMmapPersistency& copy) = delete;
+
+      /// Access the codec of a payload type. Returns NULL if the type is not supported
+      static const Codec* codec(const std::type_info& type);
+
+      /// Clear object content: release conditions and the mapping
+      void clear();
+
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const IOV& iov, const std::vector<Condition>& conditions);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(ConditionsPool& pool);
+      /// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+      std::size_t add(const ConditionsIOVPool& pool);
+      /// Save the data content to a snapshot file. Returns the number of bytes written or -1
+      long save(const std::string& file_name);
+
+      /// Map a snapshot file into memory. No condition is materialized.
+      static std::unique_ptr<ConditionsMmapPersistency> load(const std::string& file_name);
+
+      /// Access the snapshot header
+      const FileHeader& header()  const           {  return *m_header;              }
+      /// Number of pools in the snapshot
+      std::size_t numPools()  const               {  return m_header ? m_header->num_pools : 0;  }
+      /// Access a pool record of the snapshot
+      const PoolRecord& pool(std::size_t i)  const  {  return m_pools[i];           }
+      /// Access a string of the snapshot
+      const char* string(std::uint32_t offset)  const {  return m_strings + offset; }
+      /// Select the pools of the IOV type, which contain the required IOV
+      std::size_t select(const IOV& required, std::vector<std::size_t>& pools)  const;
+      /// Find the condition of a pool by key. Returns NULL if the key is not present
+      const EntryRecord* find(const PoolRecord& pool, Condition::key_type key)  const;
+      /// Access the condition of an entry record. The condition is materialized on first access and owned by the snapshot
+      Condition get(const EntryRecord& entry);
+
+      /// Materialize a condition of a snapshot pool and register it to the conditions manager, which takes ownership
+      Condition registerCondition(const PoolRecord& pool, const EntryRecord& entry, ConditionsManager mgr);
+      /// Load conditions IOV pools of a given IOV type ("*": all) and populate conditions manager
+      std::size_t importIOVPool(const std::string& iov_type, ConditionsManager mgr);
+    };
+
+  }        /* End namespace cond                            */
+}          /* End namespace dd4hep                          */
+#endif // DDCOND_CONDITIONSMMAPPERSISTENCY_H
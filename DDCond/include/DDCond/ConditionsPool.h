@@ -19,6 +19,7 @@
 #include "DDCond/ConditionsManager.h"
 
 // C/C++ include files
+#include <atomic>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -63,8 +64,10 @@ namespace dd4hep {
       };
       /// The IOV of the conditions hosted
       IOV* iov;
-      /// Aging value
-      int  age_value;
+      /// Aging value: number of selections since the last use. Updated before cleanups
+      std::atomic<int>  age_value;
+      /// Value of the selection clock of the IOV pool at the last use
+      std::atomic<long> age_stamp  { 0 };
 
     public:
       /// Listener invocation when a condition is registered to the cache
@@ -16,6 +16,9 @@
 #include <DD4hep/InstanceCount.h>
 #include <DD4hep/Printout.h>
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep::cond;
 
 /// Default constructor
@@ -43,6 +46,7 @@ ConditionsContent::~ConditionsContent()   {
 
 /// Clear the container. Destroys the contained stuff
 void ConditionsContent::clear()   {
+  m_graph.reset();
   detail::releaseObjects(m_derived);
   detail::releaseObjects(m_conditions);
 }
@@ -51,6 +55,7 @@ void ConditionsContent::clear()   {
 void ConditionsContent::merge(const ConditionsContent& to_add)    {
   auto& cond  = to_add.conditions();
   auto& deriv = to_add.derived();
+  m_graph.reset();
   for( const auto& c : cond )   {
     auto ret = m_conditions.emplace(c);
     if ( ret.second )  {
@@ -86,6 +91,7 @@ bool ConditionsContent::remove(Condition::key_type hash)   {
   }
   auto j = m_derived.find(hash);
   if ( j != m_derived.end() )  {
+    m_graph.reset();
     detail::releasePtr((*j).second);
     m_derived.erase(j);
     return true;
@@ -122,6 +128,7 @@ ConditionsContent::addDependency(ConditionDependency* dep)
 {
   auto ret = m_derived.emplace(dep->key(),dep);
   if ( ret.second )  {
+    m_graph.reset();
     //printout(DEBUG,"ConditionsContent","++ Add dependency key: %016X",dep->key());
     dep->addRef();
     return *(ret.first);
@@ -150,3 +157,94 @@ ConditionsContent::addDependency(DetElement de,
   return addDependency(dep);
 }
 
+
+/// Access the dependency graph of the derived conditions. Built on first access.
+std::shared_ptr<const ConditionsDependencyGraph> ConditionsContent::dependencyGraph()  const   {
+  std::lock_guard<std::mutex> lock(m_graphLock);
+  // The derived container is publicly accessible: check for external modifications
+  if ( !m_graph || m_graph->size() != m_derived.size() )   {
+    m_graph = std::make_shared<const ConditionsDependencyGraph>(m_derived);
+  }
+  return m_graph;
+}
+
+/// Initializing constructor
+ConditionsDependencyGraph::ConditionsDependencyGraph(const ConditionsContent::Dependencies& derived)  {
+  std::size_t num_nodes = derived.size();
+  std::vector<std::pair<std::uint32_t,std::uint32_t> > edges;
+  std::vector<std::pair<Condition::key_type,std::uint32_t> > input_edges;
+  keys.reserve(num_nodes);
+  for( const auto& d : derived )
+    keys.emplace_back(d.first);
+  std::uint32_t node = 0;
+  for( const auto& d : derived )   {
+    for( const auto& input : d.second->dependencies )   {
+      std::size_t j = index(input.hash);
+      if ( j >= num_nodes )
+        input_edges.emplace_back(input.hash, node);
+      else if ( j != node )
+        edges.emplace_back(j, node);
+    }
+    ++node;
+  }
+  std::sort(edges.begin(), edges.end());
+  offsets.resize(num_nodes+1, 0);
+  successors.reserve(edges.size());
+  for( const auto& e : edges )   {
+    ++offsets[e.first+1];
+    successors.emplace_back(e.second);
+  }
+  for( std::size_t i = 0; i < num_nodes; ++i )
+    offsets[i+1] += offsets[i];
+
+  std::sort(input_edges.begin(), input_edges.end());
+  input_offsets.emplace_back(0);
+  users.reserve(input_edges.size());
+  for( const auto& e : input_edges )   {
+    if ( inputs.empty() || inputs.back() != e.first )   {
+      inputs.emplace_back(e.first);
+      input_offsets.emplace_back(users.size());
+    }
+    users.emplace_back(e.second);
+    input_offsets.back() = users.size();
+  }
+}
+
+/// Access the node index of a derived condition. Returns size() if not present
+std::size_t ConditionsDependencyGraph::index(Condition::key_type key)  const   {
+  auto i = std::lower_bound(keys.begin(), keys.end(), key);
+  return (i != keys.end() && *i == key) ? i - keys.begin() : keys.size();
+}
+
+/// Collect the keys of all derived conditions depending directly or indirectly on one of the changed keys
+std::size_t ConditionsDependencyGraph::dependents(const std::vector<Condition::key_type>& changed,
+                                                  std::vector<Condition::key_type>& result)  const   {
+  std::vector<bool> used(keys.size(), false);
+  std::vector<std::uint32_t> todo;
+  for( Condition::key_type key : changed )   {
+    std::size_t node = index(key);
+    if ( node < keys.size() )   {
+      // A changed derived condition invalidates its users, but not itself
+      for( std::uint32_t e = offsets[node]; e < offsets[node+1]; ++e )
+        todo.emplace_back(successors[e]);
+      continue;
+    }
+    auto i = std::lower_bound(inputs.begin(), inputs.end(), key);
+    if ( i != inputs.end() && *i == key )   {
+      std::size_t j = i - inputs.begin();
+      todo.insert(todo.end(), users.begin()+input_offsets[j], users.begin()+input_offsets[j+1]);
+    }
+  }
+  while( !todo.empty() )   {
+    std::uint32_t node = todo.back();
+    todo.pop_back();
+    if ( used[node] ) continue;
+    used[node] = true;
+    for( std::uint32_t e = offsets[node]; e < offsets[node+1]; ++e )
+      todo.emplace_back(successors[e]);
+  }
+  std::size_t len = result.size();
+  for( std::size_t i = 0; i < keys.size(); ++i )
+    if ( used[i] ) result.emplace_back(keys[i]);
+  return result.size() - len;
+}
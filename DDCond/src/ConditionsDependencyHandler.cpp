@@ -14,13 +14,44 @@
 // Framework include files
 #include <DDCond/ConditionsDependencyHandler.h>
 #include <DDCond/ConditionsManagerObject.h>
+#include <DDCond/ConditionsContent.h>
 #include <DD4hep/ConditionsProcessor.h>
 #include <DD4hep/Printout.h>
 #include <TTimeStamp.h>
 
+// C/C++ include files
+#include <algorithm>
+
+#ifdef DD4HEP_USE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/task_group.h>
+#endif
+
 using namespace dd4hep::cond;
 
 namespace {
+
+  /// Helper to set and restore the current work item of the executing thread
+  struct CurrentWork  {
+    ConditionsDependencyHandler::Work*& current;
+    ConditionsDependencyHandler::Work*  previous;
+    CurrentWork(ConditionsDependencyHandler::Work*& c, ConditionsDependencyHandler::Work* w)
+      : current(c), previous(c)  {  current = w;         }
+    ~CurrentWork()               {  current = previous;  }
+  };
+
+#ifdef DD4HEP_USE_TBB
+  /// Access a task arena with the requested concurrency. Arenas are kept for reuse
+  tbb::task_arena& task_arena(int num_threads)  {
+    static std::mutex lock;
+    static std::map<int, std::unique_ptr<tbb::task_arena> > arenas;
+    std::lock_guard<std::mutex> guard(lock);
+    auto& arena = arenas[num_threads];
+    if ( !arena ) arena.reset(new tbb::task_arena(num_threads));
+    return *arena;
+  }
+#endif
+
   std::string dependency_name(const ConditionDependency* d)  {
 #if defined(DD4HEP_CONDITIONS_HAVE_NAME)
     return d->target.name;
@@ -80,6 +111,8 @@ ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager   mgr
 
 /// Default destructor
 ConditionsDependencyHandler::~ConditionsDependencyHandler()   {
+  for( const auto& t : m_todo )
+    t.second->~Work();
   m_todo.clear();
   if ( m_block ) delete [] m_block;
   m_block = 0;
@@ -90,19 +123,102 @@ dd4hep::Detector& ConditionsDependencyHandler::detectorDescription() const  {
   return m_manager->detectorDescription();
 }
 
+/// Current item of the block. Thread local to allow for parallel execution
+ConditionsDependencyHandler::Work*& ConditionsDependencyHandler::currentWork()   {
+  static thread_local Work* current = 0;
+  return current;
+}
+
+/// Supply the dependency graph of the content to enable parallel execution
+void ConditionsDependencyHandler::setDependencyGraph(std::shared_ptr<const ConditionsDependencyGraph> graph)   {
+  m_graph = std::move(graph);
+}
+
+/// Execute a processing step for all items. In parallel if possible
+void ConditionsDependencyHandler::execute(const std::function<void(Work*)>& step)   {
+  CurrentWork top(currentWork(), 0);
+  int num_threads = m_manager->numThreads();
+#ifdef DD4HEP_USE_TBB
+  if ( m_graph && num_threads > 1 && m_todo.size() > 1 )   {
+    std::size_t num_items = m_todo.size();
+    std::vector<Condition::key_type> keys;
+    std::vector<Work*> items;
+    std::vector<std::uint32_t> offsets(num_items+1, 0), successors, roots;
+    std::vector<std::atomic<std::uint32_t> > pending(num_items);
+
+    keys.reserve(num_items);
+    items.reserve(num_items);
+    for( const auto& t : m_todo )   {
+      keys.emplace_back(t.first);
+      items.emplace_back(t.second);
+    }
+    // Restrict the dependency graph to the items to be processed.
+    // Inputs not part of the work are already present in the user pool.
+    for( std::size_t k = 0; k < num_items; ++k )   {
+      std::size_t node = m_graph->index(keys[k]);
+      if ( node < m_graph->size() )   {
+        for( std::uint32_t e = m_graph->offsets[node]; e < m_graph->offsets[node+1]; ++e )   {
+          Condition::key_type key = m_graph->keys[m_graph->successors[e]];
+          auto j = std::lower_bound(keys.begin(), keys.end(), key);
+          if ( j != keys.end() && *j == key )   {
+            std::uint32_t succ = j - keys.begin();
+            successors.emplace_back(succ);
+            ++pending[succ];
+          }
+        }
+      }
+      offsets[k+1] = successors.size();
+    }
+    for( std::uint32_t k = 0; k < num_items; ++k )   {
+      if ( pending[k] == 0 ) roots.emplace_back(k);
+    }
+    task_arena(num_threads).execute([&]()  {
+        tbb::task_group group;
+        std::function<void(std::uint32_t)> run = [&](std::uint32_t k)  {
+          CurrentWork task(currentWork(), 0);
+          step(items[k]);
+          for( std::uint32_t e = offsets[k]; e < offsets[k+1]; ++e )   {
+            std::uint32_t succ = successors[e];
+            if ( --pending[succ] == 0 )
+              group.run([&run, succ]()  {  run(succ);  });
+          }
+        };
+        for( std::uint32_t k : roots )
+          group.run([&run, k]()  {  run(k);  });
+        group.wait();
+      });
+    // Items on circular dependencies were never started
+    for( std::size_t k = 0; k < num_items; ++k )   {
+      if ( pending[k] > 0 ) step(items[k]);
+    }
+    return;
+  }
+#else
+  if ( num_threads > 1 )   {
+    static std::once_flag warn;
+    std::call_once(warn, []()  {
+        printout(WARNING,"DependencyHandler",
+                 "+++ No TBB support: Derived conditions are computed serially.");
+      });
+  }
+#endif
+  for( const auto& t : m_todo )
+    step(t.second);
+}
+
 /// 1rst pass: Compute/create the missing conditions
 void ConditionsDependencyHandler::compute()   {
   m_state = CREATED;
-  for( const auto& i : m_todo )   {
-    if ( !i.second->condition )  {
-      do_callback(i.second);
-      if ( !i.second->condition )  {
-        except("DependencyHandler",
-               "Derived condition was not created after calling the creation callback!");
+  execute([this](Work* w)  {
+      std::lock_guard<std::recursive_mutex> guard(w->lock);
+      if ( !w->condition )  {
+        do_callback(w);
+        if ( !w->condition )  {
+          except("DependencyHandler",
+                 "Derived condition was not created after calling the creation callback!");
+        }
       }
-    }
-    // printout(INFO,"UserPool","Already calcluated: %s",d->name());
-  }
+    });
 }
 
 /// 2nd pass:  Handler callback for the second turn to resolve missing dependencies
@@ -114,12 +230,15 @@ void ConditionsDependencyHandler::resolve()    {
   Work* w;
 
   m_state = RESOLVED;
+  execute([](Work* item)  {
+      std::lock_guard<std::recursive_mutex> guard(item->lock);
+      CurrentWork current(currentWork(), item);
+      if ( item->state != RESOLVED )   {
+        item->resolve(current.current);
+      }
+    });
   for( const auto& c : m_todo )   {
     w = c.second;
-    m_currentWork = w;
-    if ( w->state != RESOLVED )   {
-      w->resolve(m_currentWork);
-    }
     ++num_resolved;
     // Fill an empty map of condition vectors for the block inserts
     auto ret = work_pools.emplace(w->iov->keyData,tmp);
@@ -160,12 +279,14 @@ void ConditionsDependencyHandler::resolve()    {
 
 /// Interface to handle multi-condition inserts by callbacks: One single insert
 bool ConditionsDependencyHandler::registerOne(const IOV& iov, Condition cond)    {
+  std::unique_lock<std::shared_timed_mutex> guard(m_poolLock);
   return m_pool.registerOne(iov, cond);
 }
 
 /// Handle multi-condition inserts by callbacks: block insertions of conditions with identical IOV
 std::size_t
 ConditionsDependencyHandler::registerMany(const IOV& iov, const std::vector<Condition>& values)   {
+  std::unique_lock<std::shared_timed_mutex> guard(m_poolLock);
   return m_pool.registerMany(iov, values);
 }
 
@@ -189,9 +310,11 @@ ConditionsDependencyHandler::getByItem(Condition::itemkey_type key)   {
         return 1;
       }
     };
-    item_selector proc(key);
-    m_pool.scan(conditionsProcessor(proc));
-    for (auto c : proc.conditions ) m_currentWork->do_intersection(c->iov);
+    item_selector proc(key);  {
+      std::shared_lock<std::shared_timed_mutex> guard(m_poolLock);
+      m_pool.scan(conditionsProcessor(proc));
+    }
+    for (auto c : proc.conditions ) currentWork()->do_intersection(c->iov);
     return proc.conditions;
   }
   except("DependencyHandler",
@@ -205,8 +328,11 @@ ConditionsDependencyHandler::get(Condition::detkey_type det_key)   {
   if ( m_state == RESOLVED )   {
     ConditionKey::KeyMaker lower(det_key, Condition::FIRST_ITEM_KEY);
     ConditionKey::KeyMaker upper(det_key, Condition::LAST_ITEM_KEY);
-    std::vector<Condition> conditions = m_pool.get(lower.hash, upper.hash);
-    for (auto c : conditions ) m_currentWork->do_intersection(c->iov);
+    std::vector<Condition> conditions;  {
+      std::shared_lock<std::shared_timed_mutex> guard(m_poolLock);
+      conditions = m_pool.get(lower.hash, upper.hash);
+    }
+    for (auto c : conditions ) currentWork()->do_intersection(c->iov);
     return conditions;
   }
   except("DependencyHandler",
@@ -227,26 +353,31 @@ ConditionsDependencyHandler::get(Condition::key_type key,
                                  bool throw_if_not)
 {
   /// If we are not already resolving here, we follow the normal procedure
-  Condition c = m_pool.get(key);
+  Condition c;  {
+    std::shared_lock<std::shared_timed_mutex> guard(m_poolLock);
+    c = m_pool.get(key);
+  }
   if ( c.isValid() )  {
-    m_currentWork->do_intersection(c->iov);
+    currentWork()->do_intersection(c->iov);
     return c;
   }
   auto i = m_todo.find(key);
   if ( i != m_todo.end() )   {
     Work* w = i->second;
+    // Wait if the item is being processed by another thread
+    std::lock_guard<std::recursive_mutex> guard(w->lock);
     if ( w->state == RESOLVED )   {
       return w->condition;
     }
     else if ( w->state == CREATED )   {
-      return w->resolve(m_currentWork);
+      return w->resolve(currentWork());
     }
     else if ( w->state == INVALID )  {
       do_callback(w);
       if ( w->condition && w->state == RESOLVED ) // cross-dependencies...
         return w->condition;
       else if ( w->condition )
-        return w->resolve(m_currentWork);
+        return w->resolve(currentWork());
     }
   }
   if ( throw_if_not )  {
@@ -293,8 +424,9 @@ ConditionsDependencyHandler::get(Condition::key_type key,
 void ConditionsDependencyHandler::do_callback(Work* work)   {
   const ConditionDependency* dep = work->context.dependency;
   try  {
-    Work* previous  = m_currentWork;
-    m_currentWork   = work;
+    Work*& current  = currentWork();
+    Work* previous  = current;
+    current         = work;
     if ( work->callstack > 0 )   {
       // if we end up here it means a previous construction call never finished
       // because the bugger tried to access another condition, which in turn
@@ -313,7 +445,7 @@ void ConditionsDependencyHandler::do_callback(Work* work)   {
     ++work->callstack;
     work->condition = (*dep->callback)(dep->target, work->context).ptr();
     --work->callstack;
-    m_currentWork   = previous;
+    current         = previous;
     if ( work->condition )  {
       if ( !work->iov )  {
         work->_iov = IOV(m_iovType,IOV::Key(IOV::MIN_KEY, IOV::MAX_KEY));
@@ -20,8 +20,91 @@
 
 #include <DD4hep/detail/ConditionsInterna.h>
 
+// C/C++ include files
+#include <limits>
+#include <algorithm>
+
 using namespace dd4hep::cond;
 
+namespace {
+  typedef dd4hep::IOV::Key_value_type key_value_t;
+
+  /// Collect the leaves of the segment tree below limit with an upper bound of at least 'bound'
+  void collect(const std::vector<key_value_t>& max_upper,
+               std::size_t node, std::size_t lo, std::size_t hi,
+               std::size_t limit, key_value_t bound,
+               std::vector<std::uint32_t>& result)
+  {
+    if ( lo >= limit || max_upper[node] < bound )
+      return;
+    if ( hi - lo == 1 )   {
+      result.emplace_back(lo);
+      return;
+    }
+    std::size_t mid = (lo + hi) / 2;
+    collect(max_upper, 2*node,   lo,  mid, limit, bound, result);
+    collect(max_upper, 2*node+1, mid, hi,  limit, bound, result);
+  }
+}
+
+/// Rebuild the index from the container of pools
+void ConditionsIOVPool::Index::build(const Elements& elements)   {
+  std::size_t num_pools = elements.size();
+  keys.clear();
+  pools.clear();
+  keys.reserve(num_pools);
+  pools.reserve(num_pools);
+  for( const auto& e : elements )   {
+    keys.emplace_back(e.first);
+    pools.emplace_back(e.second);
+  }
+  width = 1;
+  while ( width < num_pools ) width <<= 1;
+  max_upper.assign(2*width, std::numeric_limits<key_value_t>::min());
+  for( std::size_t i = 0; i < num_pools; ++i )
+    max_upper[width+i] = keys[i].second;
+  for( std::size_t i = width-1; i > 0; --i )
+    max_upper[i] = std::max(max_upper[2*i], max_upper[2*i+1]);
+  by_upper.resize(num_pools);
+  for( std::size_t i = 0; i < num_pools; ++i )
+    by_upper[i] = i;
+  std::sort(by_upper.begin(), by_upper.end(),
+            [this](std::uint32_t a, std::uint32_t b)  {  return keys[a].second < keys[b].second;  });
+}
+
+/// Collect the indices of all pools containing the range [req.first, req.second] (sorted)
+std::size_t ConditionsIOVPool::Index::containing(const IOV::Key& req, std::vector<std::uint32_t>& result)  const  {
+  std::size_t len = result.size();
+  // Only pools starting before the requested range are candidates
+  auto last = std::upper_bound(keys.begin(), keys.end(), req.first,
+                               [](key_value_t v, const IOV::Key& k)  {  return v < k.first;  });
+  collect(max_upper, 1, 0, width, last - keys.begin(), req.second, result);
+  return result.size() - len;
+}
+
+/// Collect the indices of all pools with a boundary inside [range.first, range.second] (sorted)
+std::size_t ConditionsIOVPool::Index::bounded(const IOV::Key& range, std::vector<std::uint32_t>& result)  const  {
+  std::size_t len = result.size();
+  // Pools with the lower bound inside the range are contiguous
+  auto first = std::lower_bound(keys.begin(), keys.end(), range.first,
+                                [](const IOV::Key& k, key_value_t v)  {  return k.first < v;  });
+  auto last  = std::upper_bound(first, keys.end(), range.second,
+                                [](key_value_t v, const IOV::Key& k)  {  return v < k.first;  });
+  for( auto i = first; i != last; ++i )
+    result.emplace_back(i - keys.begin());
+  // Pools with only the upper bound inside the range
+  std::size_t mid = result.size();
+  auto upper = std::lower_bound(by_upper.begin(), by_upper.end(), range.first,
+                                [this](std::uint32_t i, key_value_t v)  {  return keys[i].second < v;  });
+  for( ; upper != by_upper.end() && keys[*upper].second <= range.second; ++upper )   {
+    if ( keys[*upper].first < range.first )
+      result.emplace_back(*upper);
+  }
+  std::sort(result.begin()+mid, result.end());
+  std::inplace_merge(result.begin()+len, result.begin()+mid, result.end());
+  return result.size() - len;
+}
+
 /// Default constructor
 ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ)  {
   InstanceCount::increment(this);
@@ -38,16 +121,55 @@ ConditionsIOVPool::~ConditionsIOVPool()  {
   InstanceCount::decrement(this);
 }
 
+/// Access the pool for a given IOV key. Returns NULL if not present
+ConditionsPool* ConditionsIOVPool::find(const IOV::Key& key)  const   {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
+  Elements::const_iterator i = elements.find(key);
+  return i != elements.end() ? (*i).second.get() : 0;
+}
+
+/// Insert a new pool for the given IOV key. If already present, the existing pool is returned
+ConditionsPool* ConditionsIOVPool::insert(const IOV::Key& key, Element pool)   {
+  std::unique_lock<std::shared_timed_mutex> guard(lock);
+  auto ret = elements.emplace(key, pool);
+  if ( ret.second )   {
+    pool->age_stamp = age_clock.load();
+    index_valid = false;
+  }
+  ++generation;
+  return (*ret.first).second.get();
+}
+
+/// Access the search index. Rebuilt if necessary. Requires (shared) ownership of the lock
+const ConditionsIOVPool::Index& ConditionsIOVPool::i_index()   {
+  // Writers are excluded by the caller: concurrent selections only race for the rebuild
+  if ( !index_valid )   {
+    std::lock_guard<std::mutex> guard(index_lock);
+    if ( !index_valid )   {
+      index.build(elements);
+      index_valid = true;
+    }
+  }
+  return index;
+}
+
+/// Update the age value of all pools from the selection clock
+void ConditionsIOVPool::i_updateAges()   {
+  long now = age_clock;
+  for( const auto& e : elements )
+    e.second->age_value = int(now - e.second->age_stamp);
+}
+
 size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
   if ( !elements.empty() )  {
     size_t len = result.size();
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& e : elements )  {
-      if ( IOV::key_contains_range(e.first, req_key) )  {
-        e.second->select(key, result);
-      }
-    }
+    const Index& idx = i_index();
+    std::vector<std::uint32_t> found;
+    idx.containing(req_validity.key(), found);
+    for( std::uint32_t i : found )
+      idx.pools[i]->select(key, result);
     return result.size() - len;
   }
   return 0;
@@ -55,27 +177,25 @@ size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validit
 
 size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
   size_t len = result.size();
-  const IOV::Key range = req_validity.key();
-  for( const auto& e : elements )  {
-    const IOV::Key& k = e.first;
-    if ( IOV::key_is_contained(k,range) )
-      // IOV test contained in key. Take it!
-      e.second->select(key, result);
-    else if ( IOV::key_overlaps_lower_end(k,range) )
-      // IOV overlap on test on the lower end of key
-      e.second->select(key, result);
-    else if ( IOV::key_overlaps_higher_end(k,range) )
-      // IOV overlap of test on the higher end of key
-      e.second->select(key, result);
+  if ( !elements.empty() )  {
+    // Pools contained in the range or overlapping the lower or the higher end of the range
+    const Index& idx = i_index();
+    std::vector<std::uint32_t> found;
+    idx.bounded(req_validity.key(), found);
+    for( std::uint32_t i : found )
+      idx.pools[i]->select(key, result);
   }
   return result.size() - len;
 }
 
 /// Invoke cache cleanup with user defined policy
 int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
- Elements rest;
+  std::unique_lock<std::shared_timed_mutex> guard(lock);
+  Elements rest;
   int count = 0;
+  i_updateAges();
   for( const auto& e : elements )  {
     const ConditionsPool* p = e.second.get();
     if ( cleaner (*p) )   {
@@ -85,14 +205,22 @@ int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
     }
     rest.insert(e);
   }
+  if ( rest.size() != elements.size() )   {
+    // The index must not keep the removed pools alive
+    index = Index();
+    index_valid = false;
+    ++generation;
+  }
   elements = std::move(rest);
   return count;  
 }
 
 /// Remove all key based pools with an age beyon the minimum age
 int ConditionsIOVPool::clean(int max_age)   {
+  std::unique_lock<std::shared_timed_mutex> guard(lock);
   Elements rest;
   int count = 0;
+  i_updateAges();
   for( const auto& e : elements )  {
     if ( e.second->age_value >= max_age )   {
       count += e.second->size();
@@ -102,6 +230,12 @@ int ConditionsIOVPool::clean(int max_age)   {
       rest.insert(e);
     }
   }
+  if ( rest.size() != elements.size() )   {
+    // The index must not keep the removed pools alive
+    index = Index();
+    index_valid = false;
+    ++generation;
+  }
   elements = std::move(rest);
   return count;
 }
@@ -111,17 +245,18 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
                                  RangeConditions&  valid,
                                  IOV&              cond_validity)
 {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
   size_t num_selected = 0;
+  long   now = ++age_clock;
   if ( !elements.empty() )  {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      num_selected += i.second->select_all(valid);
-      i.second->age_value = 0;
+    const Index& idx = i_index();
+    std::vector<std::uint32_t> found;
+    idx.containing(req_validity.key(), found);
+    for( std::uint32_t i : found )  {
+      const Element& pool = idx.pools[i];
+      cond_validity.iov_intersection(idx.keys[i]);
+      num_selected += pool->select_all(valid);
+      pool->age_stamp = now;
     }
   }
   return num_selected;
@@ -132,18 +267,19 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
                                  const ConditionsSelect& predicate_processor,
                                  IOV&                    cond_validity)
 {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
   size_t num_selected = 0, pool_selected = 0;
+  long   now = ++age_clock;
   if ( !elements.empty() )  {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        ++i.second->age_value;
-        continue;
-      }
-      cond_validity.iov_intersection(i.first);
-      pool_selected = i.second->select_all(predicate_processor);
+    const Index& idx = i_index();
+    std::vector<std::uint32_t> found;
+    idx.containing(req_validity.key(), found);
+    for( std::uint32_t i : found )  {
+      const Element& pool = idx.pools[i];
+      cond_validity.iov_intersection(idx.keys[i]);
+      pool_selected = pool->select_all(predicate_processor);
       num_selected += pool_selected;
-      i.second->age_value = 0;
+      pool->age_stamp = now;
     }
   }
   return num_selected;
@@ -164,16 +300,14 @@ size_t ConditionsIOVPool::select(const IOV& req_validity,
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, Elements&  valid)
 {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )   {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        continue;
-      }
-      valid[i.first] = i.second;
-      ++num_selected;
-    }
+    const Index& idx = i_index();
+    std::vector<std::uint32_t> found;
+    num_selected = idx.containing(req_validity.key(), found);
+    for( std::uint32_t i : found )
+      valid[idx.keys[i]] = idx.pools[i];
   }
   return num_selected;
 }
@@ -193,16 +327,14 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
 /// Select all ACTIVE conditions, which do match the IOV requirement
 size_t ConditionsIOVPool::select(const IOV& req_validity, std::vector<Element>& valid)
 {
+  std::shared_lock<std::shared_timed_mutex> guard(lock);
   size_t num_selected = 0;
   if ( !elements.empty() )   {
-    const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
-    for( const auto& i : elements )  {
-      if ( !IOV::key_contains_range(i.first, req_key) )  {
-        continue;
-      }
-      valid.emplace_back(i.second);
-      ++num_selected;
-    }
+    const Index& idx = i_index();
+    std::vector<std::uint32_t> found;
+    num_selected = idx.containing(req_validity.key(), found);
+    for( std::uint32_t i : found )
+      valid.emplace_back(idx.pools[i]);
   }
   return num_selected;
 }
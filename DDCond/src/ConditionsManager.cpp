@@ -50,6 +50,9 @@ ConditionsManagerObject::ConditionsManagerObject(Detector& ref_description)
   InstanceCount::increment(this);
   declareProperty("LoadConditions",           m_doLoad);
   declareProperty("OutputUnloadedConditions", m_doOutputUnloaded);
+  declareProperty("NumberOfThreads",          m_numThreads);
+  declareProperty("IncrementalPrepare",       m_doIncremental);
+  declareProperty("LazyLoading",              m_doLazyLoad);
 }
 
 /// Default destructor
@@ -0,0 +1,570 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Printout.h>
+#include <DD4hep/Grammar.h>
+#include <DD4hep/Primitives.h>
+#include <DD4hep/AlignmentData.h>
+#include <DD4hep/detail/ConditionsInterna.h>
+#include <DDCond/ConditionsIOVPool.h>
+#include <DDCond/ConditionsManager.h>
+#include <DDCond/ConditionsMmapPersistency.h>
+
+#include <TTimeStamp.h>
+
+// C/C++ include files
+#include <limits>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <shared_mutex>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace dd4hep::cond;
+
+// Local namespace for anonymous stuff
+namespace  {
+
+  typedef ConditionsMmapPersistency::Codec Codec;
+
+  /// Magic word of the snapshot files
+  const char s_magic[8] = { 'D','D','4','h','C','O','N','D' };
+
+  /// Align section offsets and payloads to 8 bytes
+  inline std::uint64_t align8(std::uint64_t offset)   {
+    return (offset+7) & ~std::uint64_t(7);
+  }
+
+  /// Codec for trivially copyable payloads
+  template <typename T> struct BasicCodec  {
+    static void write(const void* object, std::string& buffer, std::uint64_t& count)   {
+      buffer.append(static_cast<const char*>(object), sizeof(T));
+      count = 1;
+    }
+    static void read(void* object, const char* data, std::uint64_t size, std::uint64_t)   {
+      if ( size != sizeof(T) )  {
+        dd4hep::except("ConditionsMmapPersistency","+++ Invalid payload size %ld for type %s",
+                       long(size), dd4hep::typeName(typeid(T)).c_str());
+      }
+      ::memcpy(object, data, sizeof(T));
+    }
+  };
+
+  /// Codec for vectors of trivially copyable items
+  template <typename T> struct VectorCodec  {
+    static void write(const void* object, std::string& buffer, std::uint64_t& count)   {
+      const std::vector<T>& v = *static_cast<const std::vector<T>*>(object);
+      buffer.append(reinterpret_cast<const char*>(v.data()), v.size()*sizeof(T));
+      count = v.size();
+    }
+    static void read(void* object, const char* data, std::uint64_t size, std::uint64_t count)   {
+      if ( size != count*sizeof(T) )  {
+        dd4hep::except("ConditionsMmapPersistency","+++ Invalid payload size %ld for type %s",
+                       long(size), dd4hep::typeName(typeid(std::vector<T>)).c_str());
+      }
+      // Payloads are 8 byte aligned: the items may be accessed in place
+      const T* items = reinterpret_cast<const T*>(data);
+      static_cast<std::vector<T>*>(object)->assign(items, items+count);
+    }
+  };
+
+  /// Codec for strings
+  struct StringCodec  {
+    static void write(const void* object, std::string& buffer, std::uint64_t& count)   {
+      const std::string& s = *static_cast<const std::string*>(object);
+      buffer.append(s);
+      count = s.length();
+    }
+    static void read(void* object, const char* data, std::uint64_t size, std::uint64_t)   {
+      static_cast<std::string*>(object)->assign(data, size);
+    }
+  };
+
+  /// Flat representation of an alignment delta
+  struct FlatDelta  {
+    double        translation[3];
+    double        pivot[3];
+    double        rotation[3];
+    std::uint64_t flags;
+    void from(const dd4hep::Delta& d)   {
+      d.translation.GetCoordinates(translation[0], translation[1], translation[2]);
+      d.pivot.GetComponents(pivot[0], pivot[1], pivot[2]);
+      d.rotation.GetComponents(rotation[0], rotation[1], rotation[2]);
+      flags = d.flags;
+    }
+    void to(dd4hep::Delta& d)  const   {
+      d.translation.SetCoordinates(translation[0], translation[1], translation[2]);
+      d.pivot.SetComponents(pivot[0], pivot[1], pivot[2]);
+      d.rotation.SetComponents(rotation[0], rotation[1], rotation[2]);
+      d.flags = (unsigned int)flags;
+    }
+  };
+
+  /// Codec for alignment deltas
+  struct DeltaCodec  {
+    static void write(const void* object, std::string& buffer, std::uint64_t& count)   {
+      FlatDelta flat;
+      flat.from(*static_cast<const dd4hep::Delta*>(object));
+      buffer.append(reinterpret_cast<const char*>(&flat), sizeof(flat));
+      count = 1;
+    }
+    static void read(void* object, const char* data, std::uint64_t size, std::uint64_t)   {
+      FlatDelta flat;
+      if ( size != sizeof(flat) )  {
+        dd4hep::except("ConditionsMmapPersistency","+++ Invalid payload size %ld for alignment delta",long(size));
+      }
+      ::memcpy(&flat, data, sizeof(flat));
+      flat.to(*static_cast<dd4hep::Delta*>(object));
+    }
+  };
+
+  /// Flat representation of alignment data. The geometry references are not saved
+  struct FlatAlignment  {
+    FlatDelta     delta;
+    double        worldTrafo[12];
+    double        detectorTrafo[12];
+    double        trToWorld[12];
+    std::uint32_t flag;
+    std::uint32_t magic;
+  };
+
+  /// Codec for alignment data
+  struct AlignmentCodec  {
+    static void from_matrix(const TGeoHMatrix& m, double* flat)   {
+      ::memcpy(flat,   m.GetRotationMatrix(), 9*sizeof(double));
+      ::memcpy(flat+9, m.GetTranslation(),    3*sizeof(double));
+    }
+    static void to_matrix(const double* flat, TGeoHMatrix& m)   {
+      m.SetRotation(flat);
+      m.SetTranslation(flat+9);
+    }
+    static void write(const void* object, std::string& buffer, std::uint64_t& count)   {
+      const dd4hep::AlignmentData& a = *static_cast<const dd4hep::AlignmentData*>(object);
+      FlatAlignment flat;
+      flat.delta.from(a.delta);
+      from_matrix(a.worldTrafo,    flat.worldTrafo);
+      from_matrix(a.detectorTrafo, flat.detectorTrafo);
+      a.trToWorld.GetComponents(flat.trToWorld, flat.trToWorld+12);
+      flat.flag  = a.flag;
+      flat.magic = a.magic;
+      buffer.append(reinterpret_cast<const char*>(&flat), sizeof(flat));
+      count = 1;
+    }
+    static void read(void* object, const char* data, std::uint64_t size, std::uint64_t)   {
+      dd4hep::AlignmentData& a = *static_cast<dd4hep::AlignmentData*>(object);
+      FlatAlignment flat;
+      if ( size != sizeof(flat) )  {
+        dd4hep::except("ConditionsMmapPersistency","+++ Invalid payload size %ld for alignment data",long(size));
+      }
+      ::memcpy(&flat, data, sizeof(flat));
+      flat.delta.to(a.delta);
+      to_matrix(flat.worldTrafo,    a.worldTrafo);
+      to_matrix(flat.detectorTrafo, a.detectorTrafo);
+      a.trToWorld.SetComponents(flat.trToWorld, flat.trToWorld+12);
+      a.flag  = flat.flag;
+      a.magic = flat.magic;
+    }
+  };
+
+  template <typename T> Codec basic_codec()   {
+    return { &typeid(T), BasicCodec<T>::write, BasicCodec<T>::read };
+  }
+  template <typename T> Codec vector_codec()   {
+    return { &typeid(std::vector<T>), VectorCodec<T>::write, VectorCodec<T>::read };
+  }
+
+  /// Registry of the supported payload types
+  const std::vector<Codec>& codecs()   {
+    static const std::vector<Codec> s_codecs = {
+      basic_codec<bool>(),      basic_codec<char>(),          basic_codec<unsigned char>(),
+      basic_codec<short>(),     basic_codec<unsigned short>(),
+      basic_codec<int>(),       basic_codec<unsigned int>(),
+      basic_codec<long>(),      basic_codec<unsigned long>(),
+      basic_codec<long long>(), basic_codec<unsigned long long>(),
+      basic_codec<float>(),     basic_codec<double>(),
+      vector_codec<char>(),     vector_codec<unsigned char>(),
+      vector_codec<short>(),    vector_codec<unsigned short>(),
+      vector_codec<int>(),      vector_codec<unsigned int>(),
+      vector_codec<long>(),     vector_codec<unsigned long>(),
+      vector_codec<float>(),    vector_codec<double>(),
+      { &typeid(std::string),            StringCodec::write,    StringCodec::read    },
+      { &typeid(dd4hep::Delta),          DeltaCodec::write,     DeltaCodec::read     },
+      { &typeid(dd4hep::AlignmentData),  AlignmentCodec::write, AlignmentCodec::read }
+    };
+    return s_codecs;
+  }
+
+  /// Write a block of data to the snapshot file
+  void write_block(std::FILE* file, const void* data, std::size_t length, const std::string& fname)   {
+    if ( length > 0 && std::fwrite(data, 1, length, file) != length )  {
+      int err = errno;
+      std::fclose(file);
+      dd4hep::except("ConditionsMmapPersistency","+++ FAILED to write snapshot %s: %s",
+                     fname.c_str(), std::strerror(err));
+    }
+  }
+
+  /// Write zero padding up to the next section offset
+  void write_padding(std::FILE* file, std::uint64_t& offset, std::uint64_t target, const std::string& fname)   {
+    static const char zeros[8] = { 0,0,0,0,0,0,0,0 };
+    write_block(file, zeros, target-offset, fname);
+    offset = target;
+  }
+}
+
+/// Default destructor
+ConditionsMmapPersistency::~ConditionsMmapPersistency()    {
+  clear();
+}
+
+/// Access the codec of a payload type. Returns NULL if the type is not supported
+const ConditionsMmapPersistency::Codec* ConditionsMmapPersistency::codec(const std::type_info& type)   {
+  for( const auto& c : codecs() )   {
+    if ( *c.type == type ) return &c;
+  }
+  return 0;
+}
+
+/// Clear object content: release conditions and the mapping
+void ConditionsMmapPersistency::clear()  {
+  for( auto& p : m_save )  {
+    for( Condition c : p.conditions )
+      c.ptr()->release();
+  }
+  m_save.clear();
+  for( Condition::Object* o : m_objects )  {
+    if ( o ) o->release();
+  }
+  m_objects.clear();
+  m_codecs.clear();
+  i_unmap();
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMmapPersistency::add(const IOV& iov, const std::vector<Condition>& conditions)   {
+  TTimeStamp start;
+  m_save.emplace_back(SavePool());
+  SavePool& p  = m_save.back();
+  p.iov_name   = iov.iovType->name;
+  p.iov_type   = iov.type;
+  p.key        = iov.key();
+  p.conditions = conditions;
+  for( auto c : p.conditions ) c.ptr()->addRef();
+  duration = TTimeStamp().AsDouble()-start.AsDouble();
+  return p.conditions.size();
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMmapPersistency::add(ConditionsPool& pool)   {
+  RangeConditions conditions;
+  pool.select_all(conditions);
+  return add(*pool.iov, conditions);
+}
+
+/// Add conditions content to be saved. Note, that dependent conditions shall not be saved!
+std::size_t ConditionsMmapPersistency::add(const ConditionsIOVPool& pool)   {
+  std::size_t count = 0;
+  std::shared_lock<std::shared_timed_mutex> guard(pool.lock);
+  for( const auto& p : pool.elements )
+    count += add(*p.second);
+  return count;
+}
+
+/// Save the data content to a snapshot file. Returns the number of bytes written or -1
+long ConditionsMmapPersistency::save(const std::string& fname)   {
+  TTimeStamp start;
+  std::vector<PoolRecord>  pools;
+  std::vector<EntryRecord> entries;
+  std::map<std::string,std::uint32_t> offsets;
+  std::string strings(1,'\0'), data;
+  std::size_t num_skipped = 0;
+
+  auto add_string = [&strings, &offsets](const std::string& value)  {
+    if ( value.empty() ) return std::uint32_t(0);
+    auto i = offsets.find(value);
+    if ( i != offsets.end() ) return i->second;
+    if ( strings.size()+value.size()+1 > std::numeric_limits<std::uint32_t>::max() )  {
+      except("ConditionsMmapPersistency","+++ String section exceeds the maximal size of the snapshot format.");
+    }
+    std::uint32_t off = std::uint32_t(strings.size());
+    strings.append(value.c_str(), value.size()+1);
+    offsets.emplace(value, off);
+    return off;
+  };
+  // Pools are sorted by IOV type and IOV key, the entries of a pool by the condition key
+  std::vector<const SavePool*> save_pools;
+  for( const auto& p : m_save ) save_pools.emplace_back(&p);
+  std::stable_sort(save_pools.begin(), save_pools.end(), [](const SavePool* a, const SavePool* b)  {
+      return a->iov_type < b->iov_type || (a->iov_type == b->iov_type && a->key < b->key);  });
+  for( const SavePool* p : save_pools )   {
+    PoolRecord rec;
+    ::memset(&rec, 0, sizeof(rec));
+    rec.lower       = p->key.first;
+    rec.upper       = p->key.second;
+    rec.iov_type    = std::uint32_t(p->iov_type);
+    rec.iov_name    = add_string(p->iov_name);
+    rec.first_entry = entries.size();
+    std::vector<Condition::Object*> conditions;
+    for( Condition c : p->conditions ) conditions.emplace_back(c.ptr());
+    std::sort(conditions.begin(), conditions.end(), [](const Condition::Object* a, const Condition::Object* b)  {
+        return a->hash < b->hash;  });
+    for( const Condition::Object* o : conditions )   {
+      const Codec* cod = o->data.is_bound() ? codec(o->data.typeInfo()) : 0;
+      if ( !cod )  {
+        ++num_skipped;
+        continue;
+      }
+      EntryRecord ent;
+      ::memset(&ent, 0, sizeof(ent));
+      data.append(align8(data.size())-data.size(), '\0');
+      ent.key     = o->hash;
+      ent.grammar = o->data.grammar->hash();
+      ent.offset  = data.size();
+      cod->write(o->data.ptr(), data, ent.count);
+      ent.size    = data.size()-ent.offset;
+#if defined(DD4HEP_CONDITIONS_HAVE_NAME)
+      ent.name    = add_string(o->GetName());
+      ent.type    = add_string(o->GetTitle());
+#endif
+      ent.value   = add_string(o->value);
+      ent.flags   = o->flags;
+      entries.emplace_back(ent);
+    }
+    rec.num_entries = entries.size()-rec.first_entry;
+    pools.emplace_back(rec);
+  }
+
+  FileHeader hdr;
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, s_magic, sizeof(hdr.magic));
+  hdr.version       = FORMAT_VERSION;
+  hdr.header_size   = sizeof(FileHeader);
+  hdr.num_pools     = pools.size();
+  hdr.pool_offset   = align8(sizeof(FileHeader));
+  hdr.num_entries   = entries.size();
+  hdr.entry_offset  = align8(hdr.pool_offset+pools.size()*sizeof(PoolRecord));
+  hdr.string_offset = align8(hdr.entry_offset+entries.size()*sizeof(EntryRecord));
+  hdr.string_size   = strings.size();
+  hdr.data_offset   = align8(hdr.string_offset+strings.size());
+  hdr.data_size     = data.size();
+  hdr.file_size     = hdr.data_offset+data.size();
+
+  std::FILE* file = std::fopen(fname.c_str(), "wb");
+  if ( !file )  {
+    printout(ERROR,"ConditionsMmapPersistency","+++ FAILED to open snapshot %s for writing: %s",
+             fname.c_str(), std::strerror(errno));
+    return -1;
+  }
+  std::uint64_t offset = sizeof(hdr);
+  write_block(file, &hdr, sizeof(hdr), fname);
+  write_padding(file, offset, hdr.pool_offset, fname);
+  write_block(file, pools.data(), pools.size()*sizeof(PoolRecord), fname);
+  offset += pools.size()*sizeof(PoolRecord);
+  write_padding(file, offset, hdr.entry_offset, fname);
+  write_block(file, entries.data(), entries.size()*sizeof(EntryRecord), fname);
+  offset += entries.size()*sizeof(EntryRecord);
+  write_padding(file, offset, hdr.string_offset, fname);
+  write_block(file, strings.data(), strings.size(), fname);
+  offset += strings.size();
+  write_padding(file, offset, hdr.data_offset, fname);
+  write_block(file, data.data(), data.size(), fname);
+  if ( 0 != std::fclose(file) )  {
+    printout(ERROR,"ConditionsMmapPersistency","+++ FAILED to close snapshot %s: %s",
+             fname.c_str(), std::strerror(errno));
+    return -1;
+  }
+  if ( num_skipped > 0 )  {
+    printout(WARNING,"ConditionsMmapPersistency",
+             "+++ Skipped %ld conditions with payloads without flat binary representation.",
+             num_skipped);
+  }
+  duration = TTimeStamp().AsDouble()-start.AsDouble();
+  return long(hdr.file_size);
+}
+
+/// Map the snapshot file and check the header
+void ConditionsMmapPersistency::i_map(const std::string& fname)   {
+  struct stat buff;
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if ( fd < 0 )  {
+    except("ConditionsMmapPersistency","+++ FAILED to open snapshot %s: %s",
+           fname.c_str(), std::strerror(errno));
+  }
+  if ( 0 != ::fstat(fd, &buff) || std::size_t(buff.st_size) < sizeof(FileHeader) )  {
+    ::close(fd);
+    except("ConditionsMmapPersistency","+++ Invalid snapshot %s: file too small.", fname.c_str());
+  }
+  void* addr = ::mmap(0, buff.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if ( addr == MAP_FAILED )  {
+    except("ConditionsMmapPersistency","+++ FAILED to map snapshot %s: %s",
+           fname.c_str(), std::strerror(errno));
+  }
+  m_base   = static_cast<const char*>(addr);
+  m_length = buff.st_size;
+  m_header = reinterpret_cast<const FileHeader*>(m_base);
+
+  const FileHeader& h = *m_header;
+  bool valid = 0 == ::memcmp(h.magic, s_magic, sizeof(h.magic)) &&
+    h.header_size == sizeof(FileHeader) && h.file_size == m_length &&
+    h.pool_offset   + h.num_pools*sizeof(PoolRecord)    <= m_length &&
+    h.entry_offset  + h.num_entries*sizeof(EntryRecord) <= m_length &&
+    h.string_offset + h.string_size <= m_length && h.string_size > 0 &&
+    h.data_offset   + h.data_size   <= m_length;
+  if ( !valid || h.version != FORMAT_VERSION )  {
+    std::uint32_t version = h.version;
+    i_unmap();
+    except("ConditionsMmapPersistency","+++ Invalid snapshot %s: %s.", fname.c_str(),
+           valid ? ("Unsupported format version "+std::to_string(version)).c_str() : "Corrupted header");
+  }
+  m_pools   = reinterpret_cast<const PoolRecord*>(m_base+h.pool_offset);
+  m_entries = reinterpret_cast<const EntryRecord*>(m_base+h.entry_offset);
+  m_strings = m_base+h.string_offset;
+  m_data    = m_base+h.data_offset;
+  if ( m_strings[h.string_size-1] != 0 )  {
+    i_unmap();
+    except("ConditionsMmapPersistency","+++ Invalid snapshot %s: Corrupted string section.", fname.c_str());
+  }
+  for( std::size_t i=0; i<h.num_pools; ++i )  {
+    const PoolRecord& p = m_pools[i];
+    if ( p.first_entry+p.num_entries > h.num_entries || p.iov_name >= h.string_size )  {
+      i_unmap();
+      except("ConditionsMmapPersistency","+++ Invalid snapshot %s: Corrupted pool record %ld.", fname.c_str(), long(i));
+    }
+  }
+  m_objects.assign(h.num_entries, nullptr);
+}
+
+/// Release the mapping
+void ConditionsMmapPersistency::i_unmap()   {
+  if ( m_base )  {
+    ::munmap(const_cast<char*>(m_base), m_length);
+  }
+  m_base    = 0;
+  m_length  = 0;
+  m_header  = 0;
+  m_pools   = 0;
+  m_entries = 0;
+  m_strings = 0;
+  m_data    = 0;
+}
+
+/// Map a snapshot file into memory. No condition is materialized.
+std::unique_ptr<ConditionsMmapPersistency> ConditionsMmapPersistency::load(const std::string& fname)   {
+  TTimeStamp start;
+  std::unique_ptr<ConditionsMmapPersistency> p(new ConditionsMmapPersistency());
+  p->i_map(fname);
+  p->duration = TTimeStamp().AsDouble()-start.AsDouble();
+  printout(DEBUG,"ConditionsMmapPersistency","+++ Mapped snapshot %s: %ld pools, %ld conditions, %ld bytes.",
+           fname.c_str(), long(p->m_header->num_pools), long(p->m_header->num_entries), long(p->m_length));
+  return p;
+}
+
+/// Select the pools of the IOV type, which contain the required IOV
+std::size_t ConditionsMmapPersistency::select(const IOV& required, std::vector<std::size_t>& result)  const   {
+  std::size_t len = result.size();
+  const std::string& iov_name = required.iovType->name;
+  for( std::size_t i=0, n=numPools(); i<n; ++i )  {
+    const PoolRecord& p = m_pools[i];
+    if ( IOV::key_contains_range(IOV::Key(p.lower, p.upper), required.keyData) && iov_name == string(p.iov_name) )
+      result.emplace_back(i);
+  }
+  return result.size()-len;
+}
+
+/// Find the condition of a pool by key. Returns NULL if the key is not present
+const ConditionsMmapPersistency::EntryRecord*
+ConditionsMmapPersistency::find(const PoolRecord& pool, Condition::key_type key)  const   {
+  const EntryRecord* first = m_entries + pool.first_entry;
+  const EntryRecord* last  = first + pool.num_entries;
+  const EntryRecord* ent   = std::lower_bound(first, last, key,
+                                              [](const EntryRecord& e, Condition::key_type k) { return e.key < k; });
+  return (ent != last && ent->key == key) ? ent : 0;
+}
+
+/// Create a new condition object from an entry record
+dd4hep::Condition ConditionsMmapPersistency::i_materialize(const EntryRecord& ent)   {
+  auto i = m_codecs.find(ent.grammar);
+  if ( i == m_codecs.end() )  {
+    const BasicGrammar& gr = BasicGrammar::get(ent.grammar);
+    const Codec* cod = codec(gr.type());
+    if ( !cod )  {
+      except("ConditionsMmapPersistency","+++ Unsupported payload type %s of condition %016llX.",
+             gr.type_name().c_str(), ent.key);
+    }
+    i = m_codecs.emplace(ent.grammar, std::make_pair(&gr, cod)).first;
+  }
+  if ( ent.offset+ent.size > m_header->data_size ||
+       ent.name >= m_header->string_size || ent.type >= m_header->string_size || ent.value >= m_header->string_size )  {
+    except("ConditionsMmapPersistency","+++ Corrupted snapshot record of condition %016llX.", ent.key);
+  }
+  Condition cond(string(ent.name), string(ent.type));
+  Condition::Object* obj = cond.ptr();
+  obj->value = string(ent.value);
+  obj->hash  = ent.key;
+  obj->flags = ent.flags;
+  void* payload = obj->data.bind(i->second.first);
+  i->second.second->read(payload, m_data+ent.offset, ent.size, ent.count);
+  return cond;
+}
+
+/// Access the condition of an entry record. The condition is materialized on first access and owned by the snapshot
+dd4hep::Condition ConditionsMmapPersistency::get(const EntryRecord& ent)   {
+  Condition::Object*& obj = m_objects[&ent - m_entries];
+  if ( !obj )  {
+    obj = i_materialize(ent).ptr();
+  }
+  return obj;
+}
+
+/// Materialize a condition of a snapshot pool and register it to the conditions manager, which takes ownership
+dd4hep::Condition ConditionsMmapPersistency::registerCondition(const PoolRecord& pool,
+                                                               const EntryRecord& ent,
+                                                               ConditionsManager mgr)   {
+  std::pair<bool,const IOVType*> typ = mgr.registerIOVType(pool.iov_type, string(pool.iov_name));
+  if ( !typ.second )  {
+    except("ConditionsMmapPersistency","+++ Cannot register IOV type %s [%d]",
+           string(pool.iov_name), int(pool.iov_type));
+  }
+  ConditionsPool* cond_pool = mgr.registerIOV(*typ.second, IOV::Key(pool.lower, pool.upper));
+  Condition cond = i_materialize(ent);
+  mgr.registerUnlocked(*cond_pool, cond);
+  return cond;
+}
+
+/// Load conditions IOV pools of a given IOV type ("*": all) and populate conditions manager
+std::size_t ConditionsMmapPersistency::importIOVPool(const std::string& iov_type, ConditionsManager mgr)   {
+  TTimeStamp start;
+  std::size_t count = 0;
+  for( std::size_t i=0, n=numPools(); i<n; ++i )  {
+    const PoolRecord& p = m_pools[i];
+    if ( !(iov_type.empty() || iov_type == "*" || iov_type == string(p.iov_name)) )
+      continue;
+    std::pair<bool,const IOVType*> typ = mgr.registerIOVType(p.iov_type, string(p.iov_name));
+    if ( !typ.second )
+      continue;
+    ConditionsPool* cond_pool = mgr.registerIOV(*typ.second, IOV::Key(p.lower, p.upper));
+    for( std::size_t j=0; j<p.num_entries; ++j )  {
+      Condition cond = i_materialize(m_entries[p.first_entry+j]);
+      mgr.registerUnlocked(*cond_pool, cond);
+      ++count;
+    }
+  }
+  duration = TTimeStamp().AsDouble()-start.AsDouble();
+  return count;
+}
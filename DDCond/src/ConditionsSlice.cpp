@@ -184,6 +184,7 @@ void dd4hep::cond::fill_content(ConditionsManager mgr,
                                 const IOVType& typ)
 {
   ConditionsIOVPool* iovPool = mgr.iovPool(typ);
+  std::shared_lock<std::shared_timed_mutex> guard(iovPool->lock);
   ConditionsIOVPool::Elements& pools = iovPool->elements;
   for_each(begin(pools),end(pools),SliceOper(content));
 }
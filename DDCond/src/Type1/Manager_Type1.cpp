@@ -215,23 +215,23 @@ const dd4hep::IOVType* Manager_Type1::iovType (const std::string& iov_name) cons
 /// Register IOV with type and key
 ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   // IOV read and checked. Now register it, but always locked!
-  ConditionsIOVPool* pool = m_rawPool[typ.type];
   dd4hep_lock_t      lock(m_poolLock);
+  ConditionsIOVPool* pool = m_rawPool[typ.type];
   if ( !pool )  {
     m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
   }
-  ConditionsIOVPool::Elements::const_iterator i = pool->elements.find(key);
-  if ( i != pool->elements.end() )   {
-    return (*i).second.get();
+  ConditionsPool* cond_pool = pool->find(key);
+  if ( cond_pool )   {
+    return cond_pool;
   }
   IOV* iov = new IOV(&typ);
   iov->type      = typ.type;
   iov->keyData   = key;
   const void* argv_pool[] = {this, iov, 0};
-  std::shared_ptr<ConditionsPool> cond_pool(createPlugin<ConditionsPool>(m_poolType,m_detDesc,2,argv_pool));
-  pool->elements.emplace(key,cond_pool);
+  std::shared_ptr<ConditionsPool> new_pool(createPlugin<ConditionsPool>(m_poolType,m_detDesc,2,argv_pool));
+  cond_pool = pool->insert(key, new_pool);
   printout(INFO,"ConditionsMgr","Created IOV Pool for:%s",iov->str().c_str());
-  return cond_pool.get();
+  return cond_pool;
 }
 
 /// Access conditions multi IOV pool by iov type
@@ -244,7 +244,13 @@ bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
   if ( cond.isValid() )  {
     cond->iov  = pool.iov;
     cond->setFlag(Condition::ACTIVE);
-    pool.insert(cond);
+    {
+      // Concurrent selections from the IOV pool are not locked out by the caller
+      ConditionsIOVPool* iov_pool = m_rawPool[pool.iov->type];
+      std::unique_lock<std::shared_timed_mutex> guard(iov_pool->lock);
+      pool.insert(cond);
+      ++iov_pool->generation;
+    }
 #if !defined(DD4HEP_MINIMAL_CONDITIONS) && defined(DD4HEP_CONDITIONS_HAVE_NAME)
     printout(DEBUG,"ConditionsMgr","Register condition %016lX %s [%s] IOV:%s",
              cond.key(), cond.name(), cond->address.c_str(), pool.iov->str().c_str());
@@ -270,19 +276,27 @@ bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
 std::size_t Manager_Type1::blockRegister(ConditionsPool& pool, const std::vector<Condition>& cond) const {
   std::size_t result = 0;
   for(auto c : cond)   {
-    if ( c.isValid() )    {
+    if ( !c.isValid() )    {
+      except("ConditionsMgr",
+             "+++ Invalid condition objects may not be registered. [%s]",
+             Errors::invalidArg().c_str());
+    }
+  }
+  {
+    // Concurrent selections from the IOV pool are not locked out by the caller
+    ConditionsIOVPool* iov_pool = m_rawPool[pool.iov->type];
+    std::unique_lock<std::shared_timed_mutex> guard(iov_pool->lock);
+    for(auto c : cond)   {
       c->iov = pool.iov;
       c->setFlag(Condition::ACTIVE);
       pool.insert(c);
-      if ( !m_onRegister.empty() )   {
-        __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
-      }
       ++result;
-      continue;
     }
-    except("ConditionsMgr",
-           "+++ Invalid condition objects may not be registered. [%s]",
-           Errors::invalidArg().c_str());    
+    ++iov_pool->generation;
+  }
+  if ( !m_onRegister.empty() )   {
+    for(auto c : cond)
+      __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
   }
   return result;
 }
@@ -0,0 +1,131 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+//  \author  Markus Frank
+//  \date    2016-02-02
+//  \version 1.0
+//
+//==========================================================================
+#ifndef DD4HEP_CONDITIONS_CONDIITONSSNAPSHOTMMAPLOADER_H
+#define DD4HEP_CONDITIONS_CONDIITONSSNAPSHOTMMAPLOADER_H
+
+// Framework include files
+#include <DDCond/ConditionsDataLoader.h>
+#include <DDCond/ConditionsMmapPersistency.h>
+
+// C/C++ include files
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for implementation details of the AIDA detector description toolkit
+  namespace cond  {
+
+    /// Conditions loader reading memory mapped conditions snapshots
+    /**
+     *  The snapshot files given as data sources are mapped on first use.
+     *  Only the requested conditions are materialized and registered
+     *  to the conditions manager.
+     *
+     *  \author   M.Frank
+     *  \version  1.0
+     *  \ingroup  DD4HEP_CONDITIONS
+     */
+    class ConditionsSnapshotMmapLoader : public ConditionsDataLoader   {
+      /// Mapped snapshot files
+      std::vector<std::unique_ptr<ConditionsMmapPersistency> > m_snapshots;
+      /// Map the pending data sources
+      void load_sources();
+    public:
+      /// Default constructor
+      ConditionsSnapshotMmapLoader(Detector& description, ConditionsManager mgr, const std::string& nam);
+      /// Default destructor
+      virtual ~ConditionsSnapshotMmapLoader();
+      /// Load a number of conditions items from the mapped snapshots according to the required IOV
+      virtual size_t load_many(  const IOV&       req_validity,
+                                 RequiredItems&   work,
+                                 LoadedItems&     loaded,
+                                 IOV&             conditions_validity)  override;
+    };
+  }    /* End namespace cond                             */
+}      /* End namespace dd4hep                            */
+#endif /* DD4HEP_CONDITIONS_CONDIITONSSNAPSHOTMMAPLOADER_H  */
+
+//#include <ConditionsSnapshotMmapLoader.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/PluginCreators.h>
+
+// Forward declartions
+using namespace dd4hep::cond;
+
+namespace {
+  void* create_loader(dd4hep::Detector& description, int argc, char** argv)   {
+    const char* name = argc>0 ? argv[0] : "MmapLoader";
+    ConditionsManagerObject* mgr = (ConditionsManagerObject*)(argc>0 ? argv[1] : 0);
+    return new ConditionsSnapshotMmapLoader(description,ConditionsManager(mgr),name);
+  }
+}
+DECLARE_DD4HEP_CONSTRUCTOR(DD4hep_Conditions_mmap_snapshot_Loader,create_loader)
+
+/// Standard constructor, initializes variables
+ConditionsSnapshotMmapLoader::ConditionsSnapshotMmapLoader(Detector& description, ConditionsManager mgr, const std::string& nam)
+: ConditionsDataLoader(description, mgr, nam)
+{
+}
+
+/// Default Destructor
+ConditionsSnapshotMmapLoader::~ConditionsSnapshotMmapLoader() {
+  m_snapshots.clear();
+}
+
+/// Map the pending data sources
+void ConditionsSnapshotMmapLoader::load_sources()  {
+  for( const auto& src : m_sources )  {
+    m_snapshots.emplace_back(ConditionsMmapPersistency::load(src.first));
+    printout(INFO,"ConditionsLoader","+++ Mapped conditions snapshot %s [%ld pools, %ld conditions]",
+             src.first.c_str(), long(m_snapshots.back()->numPools()),
+             long(m_snapshots.back()->header().num_entries));
+  }
+  m_sources.clear();
+}
+
+/// Load a number of conditions items from the mapped snapshots according to the required IOV
+size_t ConditionsSnapshotMmapLoader::load_many(const IOV&     req_validity,
+                                               RequiredItems& work,
+                                               LoadedItems&   loaded,
+                                               IOV&           conditions_validity)
+{
+  size_t len = loaded.size();
+  std::vector<std::size_t> pools;
+  load_sources();
+  for( auto& snapshot : m_snapshots )  {
+    pools.clear();
+    if ( 0 == snapshot->select(req_validity, pools) )
+      continue;
+    for( const auto& item : work )  {
+      if ( loaded.find(item.first) != loaded.end() )
+        continue;
+      for( std::size_t i : pools )  {
+        const auto& pool  = snapshot->pool(i);
+        const auto* entry = snapshot->find(pool, item.first);
+        if ( entry )  {
+          Condition cond = snapshot->registerCondition(pool, *entry, m_mgr);
+          loaded.emplace(item.first, cond);
+          conditions_validity.iov_intersection(IOV::Key(pool.lower, pool.upper));
+          break;
+        }
+      }
+    }
+  }
+  printout(DEBUG,"ConditionsLoader","+++ Loaded %ld out of %ld conditions from mapped snapshots for IOV %s",
+           long(loaded.size()-len), long(work.size()), req_validity.str().c_str());
+  return loaded.size()-len;
+}
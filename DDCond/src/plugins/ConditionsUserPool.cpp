@@ -16,9 +16,13 @@
 // Framework include files
 #include <DDCond/ConditionsPool.h>
 #include <DD4hep/ConditionsMap.h>
+#include <DD4hep/detail/ConditionsInterna.h>
 
 // C/C++ include files
 #include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
 #include <unordered_map>
 
 /// Namespace for the AIDA detector description toolkit
@@ -29,6 +33,32 @@ namespace dd4hep {
 
     /// Forward declarations
     class ConditionsDataLoader;
+    class ConditionsLoadInfo;
+
+    /// Placeholder of a condition, which is loaded from the conditions data loader on first access
+    /**
+     *  The placeholder carries the key of the missing condition and the flag
+     *  Condition::ONDEMAND. The condition is loaded exactly once, also if
+     *  several threads access the placeholder concurrently.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_CONDITIONS
+     */
+    class ConditionsLazyObject : public Condition::Object  {
+    public:
+      /// Guard to load the condition exactly once
+      std::once_flag      once;
+      /// Load information of the condition from the slice content
+      ConditionsLoadInfo* info   = 0;
+      /// The loaded condition (owned by the conditions manager). NULL if not found by the loader
+      Condition::Object*  loaded = 0;
+    public:
+      /// Initializing constructor
+      ConditionsLazyObject(Condition::key_type key, ConditionsLoadInfo* load_info)
+        : Condition::Object(), info(load_info)
+      {  hash = key; flags = Condition::ONDEMAND;    }
+    };
     
     /// Class implementing the conditions user pool for a given IOV type
     /**
@@ -39,6 +69,26 @@ namespace dd4hep {
      *  Only the ConditionsManager implementation should interact with
      *  this class or any subclass to ensure data integrity.
      *
+     *  Incremental preparation:
+     *  If enabled by the manager property "IncrementalPrepare", the IOV pools
+     *  contributing to a preparation are remembered. At the next IOV change
+     *  only the conditions of pools, which are no longer valid, are removed and
+     *  the conditions of newly valid pools are added. Derived conditions depending
+     *  on changed conditions are recomputed if they are no longer valid.
+     *  Any modification of the IOV pool by other clients not holding the
+     *  update lock results in a full selection.
+     *
+     *  Lazy loading:
+     *  If enabled by the manager property "LazyLoading", the conditions missing
+     *  in the IOV pool are not loaded while preparing the slice. Instead a
+     *  placeholder is inserted, which loads the condition from the data loader
+     *  on first access. Placeholders not accessed are never loaded.
+     *  Loads on access are serialized with the loads of all other user pools
+     *  by the update lock of the IOV pool: data loaders are not thread safe.
+     *  The IOV pool is searched first, so that a condition resolved by several
+     *  slices is loaded and registered only once. The validity of the pool is
+     *  not narrowed by conditions loaded on access.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_CONDITIONS
@@ -51,13 +101,41 @@ namespace dd4hep {
       ConditionsIOVPool*    m_iovPool = 0;
       /// The loader to access non-existing conditions
       ConditionsDataLoader* m_loader = 0;
+      /// Generation of the IOV pool at the last selection
+      long                  m_generation = -1;
+      /// IOV pools contributing to the last preparation (sorted by address). Empty if not reusable
+      std::vector<std::shared_ptr<ConditionsPool> > m_pools;
+      /// Placeholders of conditions loaded on first access (lazy loading)
+      std::vector<std::unique_ptr<ConditionsLazyObject> > m_lazy;
+      /// Required IOV of the last preparation: used to load the placeholders
+      IOV                   m_required;
+      /// Lock serializing the placeholder loads of the parallel computations during the preparation
+      mutable std::mutex    m_resolveLock;
+      /// Flag set while the preparation of this pool holds the update lock of the IOV pool
+      bool                  m_updating = false;
 
       /// Internal helper to find conditions
       Condition::Object* i_findCondition(Condition::key_type key)  const;
 
+      /// Internal helper: load the condition of a placeholder on first access
+      Condition::Object* i_resolve(Condition::Object* o)  const;
+
+      /// Internal helper: access a condition. Placeholders are resolved
+      Condition::Object* i_access(Condition::Object* o)  const
+      {  return (o->flags&Condition::ONDEMAND) ? i_resolve(o) : o;   }
+
+      /// Internal helper: replace the missing conditions by placeholders. Returns the number of placeholders
+      template <typename ITERATOR> size_t i_defer(const IOV& required, ITERATOR first, ITERATOR last);
+
       /// Internal insertion helper
       bool i_insert(Condition::Object* o);
 
+      /// Internal helper: update the selection incrementally. Returns false if a full selection is required
+      bool i_update(const IOV& required, ConditionsSlice& slice, IOV& pool_iov, size_t& reused);
+
+      /// Internal helper: remember the IOV pools contributing to the selection for incremental updates
+      void i_savePools(const IOV& required, long generation);
+
     public:
       /// Default constructor
       ConditionsMappedUserPool(ConditionsManager mgr, ConditionsIOVPool* pool);
@@ -164,11 +242,21 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <mutex>
+#include <iterator>
+#include <algorithm>
 
 using namespace dd4hep::cond;
 
 namespace {
 
+  /// Helper to flag a user pool, whose preparation holds the update lock of the IOV pool
+  class UpdateFlag  {
+    bool& m_flag;
+  public:
+    UpdateFlag(bool& flag) : m_flag(flag)  {  m_flag = true;   }
+    ~UpdateFlag()                          {  m_flag = false;  }
+  };
+
   class SimplePrint : public dd4hep::Condition::Processor {
     /// Conditions callback for object processing
     virtual int process(dd4hep::Condition)  const override    { return 1; }
@@ -206,7 +294,7 @@ namespace {
 /// Default constructor
 template<typename MAPPING>
 ConditionsMappedUserPool<MAPPING>::ConditionsMappedUserPool(ConditionsManager mgr, ConditionsIOVPool* pool) 
-  : UserPool(mgr), m_iovPool(pool)
+  : UserPool(mgr), m_iovPool(pool), m_required(0)
 {
   InstanceCount::increment(this);
   if ( mgr.isValid() )  {
@@ -236,7 +324,55 @@ ConditionsMappedUserPool<MAPPING>::i_findCondition(Condition::key_type key)  con
     print("*"); // This causes CTEST to bail out, due too much output!
   }
 #endif
-  return i != m_conditions.end() ? (*i).second : 0;
+  return i != m_conditions.end() ? i_access((*i).second) : 0;
+}
+
+/// Internal helper: load the condition of a placeholder on first access
+template<typename MAPPING> dd4hep::Condition::Object*
+ConditionsMappedUserPool<MAPPING>::i_resolve(Condition::Object* o)  const {
+  ConditionsLazyObject* lazy = static_cast<ConditionsLazyObject*>(o);
+  std::call_once(lazy->once, [this, lazy]()  {
+      // Serialize with the loads of all user pools. If the placeholder is accessed by
+      // the derived computations of this pool's preparation, the update lock is
+      // already held by the preparing thread.
+      std::unique_lock<std::mutex> update_guard(m_iovPool->update_lock, std::defer_lock);
+      if ( !m_updating ) update_guard.lock();
+      std::lock_guard<std::mutex> guard(m_resolveLock);
+      // The condition may meanwhile have been loaded by another slice
+      RangeConditions found;
+      m_iovPool->select(lazy->hash, m_required, found);
+      if ( !found.empty() )  {
+        lazy->loaded = found.front().ptr();
+        return;
+      }
+      ConditionsDataLoader::RequiredItems work { std::make_pair(lazy->hash, lazy->info) };
+      ConditionsDataLoader::LoadedItems   loaded;
+      IOV load_iov(m_required.iovType);
+      load_iov.reset().invert();
+      m_loader->load_many(m_required, work, loaded, load_iov);
+      auto i = loaded.find(lazy->hash);
+      if ( i != loaded.end() )  {
+        lazy->loaded = (*i).second.ptr();
+        return;
+      }
+      printout(ERROR,"UserPool","+++ Condition %016llX CANNOT be loaded on access. [Not found by loader]",
+               lazy->hash);
+    });
+  return lazy->loaded;
+}
+
+/// Internal helper: replace the missing conditions by placeholders. Returns the number of placeholders
+template<typename MAPPING> template<typename ITERATOR> std::size_t
+ConditionsMappedUserPool<MAPPING>::i_defer(const IOV& required, ITERATOR first, ITERATOR last)  {
+  std::size_t count = 0;
+  m_required = required;
+  for( ; first != last; ++first, ++count )  {
+    m_lazy.emplace_back(new ConditionsLazyObject((*first).first, (*first).second));
+    m_conditions.emplace((*first).first, m_lazy.back().get());
+  }
+  printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
+           "%ld conditions will be loaded on first access.", count);
+  return count;
 }
 
 template<typename MAPPING> inline bool
@@ -253,6 +389,108 @@ ConditionsMappedUserPool<MAPPING>::i_insert(Condition::Object* o)   {
   }
   return ret;
 }
+
+/// Internal helper: update the selection incrementally. Returns false if a full selection is required
+template<typename MAPPING> bool
+ConditionsMappedUserPool<MAPPING>::i_update(const IOV&       required,
+                                            ConditionsSlice& slice,
+                                            IOV&             pool_iov,
+                                            size_t&          reused)
+{
+  typedef std::vector<std::shared_ptr<ConditionsPool> > Pools;
+  auto by_address = [](const Pools::value_type& a, const Pools::value_type& b)  {  return a.get() < b.get();  };
+  std::vector<Condition::key_type> removed, changed, dependents;
+  RangeConditions conditions;
+  Pools pools, dropped, added;
+
+  if ( m_pools.empty() || !m_manager->doIncrementalPrepare() || m_generation != m_iovPool->generation )
+    return false;
+  pool_iov.reset().invert();
+  m_iovPool->select(required, pools, pool_iov);
+  if ( m_generation != m_iovPool->generation )
+    return false;
+
+  std::sort(pools.begin(), pools.end(), by_address);
+  std::set_difference(m_pools.begin(), m_pools.end(), pools.begin(), pools.end(),
+                      std::back_inserter(dropped), by_address);
+  std::set_difference(pools.begin(), pools.end(), m_pools.begin(), m_pools.end(),
+                      std::back_inserter(added), by_address);
+  m_pools.clear();
+  {
+    std::shared_lock<std::shared_timed_mutex> guard(m_iovPool->lock);
+    // Remove the conditions of pools, which are no longer valid
+    for( const auto& p : dropped ) p->select_all(conditions);
+    for( const auto& c : conditions )   {
+      typename MAPPING::iterator i = m_conditions.find(c->hash);
+      if ( i != m_conditions.end() && (*i).second == c.ptr() )   {
+        m_conditions.erase(i);
+        removed.emplace_back(c->hash);
+      }
+    }
+    reused = m_conditions.size();
+    // Add the conditions of the newly valid pools
+    conditions.clear();
+    for( const auto& p : added ) p->select_all(conditions);
+    for( const auto& c : conditions )   {
+      if ( m_conditions.emplace(c->hash, c.ptr()).second )
+        changed.emplace_back(c->hash);
+    }
+    // Overlapping validities: a retained pool may still supply a removed condition
+    for( Condition::key_type key : removed )   {
+      if ( m_conditions.find(key) == m_conditions.end() )   {
+        for( const auto& p : pools )   {
+          Condition c = p->exists(key);
+          if ( c.isValid() )   {
+            m_conditions.emplace(key, c.ptr());
+            changed.emplace_back(key);
+            break;
+          }
+        }
+      }
+    }
+  }
+  std::size_t num_added = changed.size();
+  std::sort(changed.begin(), changed.end());
+  changed.insert(changed.end(), removed.begin(), removed.end());
+  // Derived conditions depending on changed inputs must be recomputed unless still valid
+  if ( !changed.empty() )   {
+    slice.content->dependencyGraph()->dependents(changed, dependents);
+    for( Condition::key_type key : dependents )   {
+      typename MAPPING::iterator i = m_conditions.find(key);
+      if ( i != m_conditions.end() )   {
+        const IOV* iov = (*i).second->iov;
+        if ( !iov || !IOV::key_contains_range(iov->keyData, required.keyData) )   {
+          m_conditions.erase(i);
+          if ( !std::binary_search(changed.begin(), changed.begin()+num_added, key) )
+            --reused;
+        }
+      }
+    }
+  }
+  printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
+           "Incremental update: %ld pools dropped, %ld pools added, %ld conditions changed, "
+           "%ld dependents, %ld conditions reused.",
+           dropped.size(), added.size(), changed.size(), dependents.size(), reused);
+  return true;
+}
+
+/// Internal helper: remember the IOV pools contributing to the selection for incremental updates
+template<typename MAPPING> void
+ConditionsMappedUserPool<MAPPING>::i_savePools(const IOV& required, long generation)   {
+  m_pools.clear();
+  if ( m_manager->doIncrementalPrepare() )   {
+    m_iovPool->select(required, m_pools);
+    // Modifications by other clients since the selection: the next update must be complete
+    if ( generation != m_iovPool->generation )   {
+      m_pools.clear();
+      return;
+    }
+    std::sort(m_pools.begin(), m_pools.end(),
+              [](const std::shared_ptr<ConditionsPool>& a, const std::shared_ptr<ConditionsPool>& b)
+              {  return a.get() < b.get();  });
+    m_generation = generation;
+  }
+}
   
 /// Total entry count
 template<typename MAPPING>
@@ -280,6 +518,8 @@ void ConditionsMappedUserPool<MAPPING>::clear()   {
   }
   m_iov = IOV(0);
   m_conditions.clear();
+  m_lazy.clear();
+  m_pools.clear();
 }
 
 /// Check a condition for existence
@@ -346,6 +586,7 @@ ConditionsMappedUserPool<MAPPING>::registerMany(const IOV& iov,
 /// Register a new condition to this pool
 template<typename MAPPING>
 bool ConditionsMappedUserPool<MAPPING>::insert(Condition cond)   {
+  m_pools.clear();
   bool result = i_insert(cond.ptr());
   if ( result ) return true;
   except("UserPool","++ Attempt to double insert condition: %16llX Name:%s", cond->hash, cond.name());
@@ -385,7 +626,8 @@ ConditionsMappedUserPool<MAPPING>::get(Condition::key_type lower, Condition::key
     typename MAPPING::const_iterator first = m_conditions.lower_bound(lower);
     for(; first != m_conditions.end(); ++first )  {
       if ( (*first).first > upper ) break;
-      result.emplace_back((*first).second);
+      Condition::Object* o = i_access((*first).second);
+      if ( o ) result.emplace_back(o);
     }
   }
   return result;
@@ -394,8 +636,10 @@ ConditionsMappedUserPool<MAPPING>::get(Condition::key_type lower, Condition::key
 /// ConditionsMap overload: Interface to scan data content of the conditions mapping
 template<typename MAPPING>
 void ConditionsMappedUserPool<MAPPING>::scan(const Condition::Processor& processor) const  {
-  for( const auto& i : m_conditions )
-    processor(i.second);
+  for( const auto& i : m_conditions )  {
+    Condition::Object* o = i_access(i.second);
+    if ( o ) processor(o);
+  }
 }
 
 /// ConditionsMap overload: Interface to scan data content of the conditions mapping
@@ -418,8 +662,10 @@ void ConditionsMappedUserPool<MAPPING>::scan(Condition::key_type lower,
                                              const Condition::Processor& processor) const
 {
   typename MAPPING::const_iterator first = m_conditions.lower_bound(lower);
-  for(; first != m_conditions.end() && (*first).first <= upper; ++first )
-    processor((*first).second);
+  for(; first != m_conditions.end() && (*first).first <= upper; ++first )  {
+    Condition::Object* o = i_access((*first).second);
+    if ( o ) processor(o);
+  }
 }
 
 /// Remove condition by key from pool.
@@ -434,6 +680,7 @@ bool ConditionsMappedUserPool<MAPPING>::remove(Condition::key_type hash_key)
   typename MAPPING::iterator i = m_conditions.find(hash_key);
   if ( i != m_conditions.end() ) {
     m_conditions.erase(i);
+    m_pools.clear();
     return true;
   }
   return false;
@@ -515,34 +762,51 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
+  // The selection from the IOV pool runs in parallel to other user pools.
+  // Loading and computing missing conditions however must be serialized:
+  // The missing items may meanwhile have been registered by another thread.
+  // If the IOV pool changed, the selection is repeated while holding the update lock.
+  std::unique_lock<std::mutex> update_guard(m_iovPool->update_lock, std::defer_lock);
+  CondMissing cond_missing;
+  CalcMissing calc_missing;
+  long num_cond_miss = 0, num_calc_miss = 0;
 
-  m_conditions.clear();
   slice_miss_cond.clear();
   slice_miss_calc.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  while ( true )   {
+    // Incremental update if possible, otherwise full selection from the IOV pool
+    if ( !i_update(required, slice, pool_iov, result.reused) )   {
+      result.reused = 0;
+      m_generation = m_iovPool->generation;
+      m_conditions.clear();
+      m_lazy.clear();
+      pool_iov.reset().invert();
+      m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    }
+    m_iov = pool_iov;
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    auto last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                                    begin(m_conditions), end(m_conditions),
+                                    begin(cond_missing), COMP());
+    cond_missing.erase(last_cond, end(cond_missing));
+    auto last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                                    begin(m_conditions), end(m_conditions),
+                                    begin(calc_missing), COMP());
+    calc_missing.erase(last_calc, end(calc_missing));
+    num_cond_miss = cond_missing.size();
+    num_calc_miss = calc_missing.size();
+    if ( !do_load || update_guard.owns_lock() || (num_cond_miss == 0 && num_calc_miss == 0) )
+      break;
+    update_guard.lock();
+    if ( m_generation == m_iovPool->generation )
+      break;
+  }
+  auto last_cond = end(cond_missing);
+  auto last_calc = end(calc_missing);
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "%ld conditions out of %ld conditions are MISSING.",
            num_cond_miss, slice_cond.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "%ld derived conditions out of %ld conditions are MISSING.",
            num_calc_miss, slice_calc.size());
@@ -555,7 +819,12 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   // Now we load the missing conditions from the conditions loader
   //
   if ( num_cond_miss > 0 )  {
-    if ( do_load )  {
+    if ( do_load && m_manager->doLazyLoad() )  {
+      // Deferred loads are accounted as loaded
+      result.loaded  = i_defer(required, begin(cond_missing), last_cond);
+      result.missing -= result.loaded;
+    }
+    else if ( do_load )  {
       ConditionsDataLoader::LoadedItems loaded;
       size_t updates = m_loader->load_many(required, cond_missing, loaded, pool_iov);
       if ( updates > 0 )  {
@@ -599,6 +868,10 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
     if ( do_load )  {
       std::map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
+      UpdateFlag updating(m_updating);
+      if ( m_manager->numThreads() > 1 )  {
+        handler.setDependencyGraph(slice.content->dependencyGraph());
+      }
       /// 1rst pass: Compute/create the missing condiions
       handler.compute();
       /// 2nd pass:  Resolve missing dependencies
@@ -619,6 +892,12 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
       copy(begin(calc_missing), last_calc, inserter(slice_miss_calc, slice_miss_calc.begin()));
     }
   }
+  // Own registrations of derived conditions are made while holding the update lock.
+  // Loaders may register more conditions than requested: the next selection must be complete.
+  if ( do_load && num_cond_miss > 0 )
+    m_pools.clear();
+  else
+    i_savePools(required, update_guard.owns_lock() ? long(m_iovPool->generation) : m_generation);
   slice.status = result;
   slice.used_pools.clear();
   if ( slice.flags&ConditionsSlice::REF_POOLS )   {
@@ -640,23 +919,34 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&                  required,
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
+  // The selection from the IOV pool runs in parallel to other user pools.
+  // Loading missing conditions however must be serialized (see prepare).
+  std::unique_lock<std::mutex> update_guard(m_iovPool->update_lock, std::defer_lock);
+  CondMissing cond_missing;
+  long num_cond_miss = 0;
 
-  m_conditions.clear();
+  m_pools.clear();
   slice_miss_cond.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  while ( true )   {
+    m_generation = m_iovPool->generation;
+    m_conditions.clear();
+    m_lazy.clear();
+    pool_iov.reset().invert();
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    auto last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                                    begin(m_conditions), end(m_conditions),
+                                    begin(cond_missing), COMP());
+    cond_missing.erase(last_cond, end(cond_missing));
+    num_cond_miss = cond_missing.size();
+    if ( !do_load || update_guard.owns_lock() || num_cond_miss == 0 )
+      break;
+    update_guard.lock();
+    if ( m_generation == m_iovPool->generation )
+      break;
+  }
+  auto last_cond = end(cond_missing);
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "Found %ld missing conditions out of %ld conditions.",
            num_cond_miss, slice_cond.size());
@@ -668,7 +958,12 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&                  required,
   // Now we load the missing conditions from the conditions loader
   //
   if ( num_cond_miss > 0 )  {
-    if ( do_load )  {
+    if ( do_load && m_manager->doLazyLoad() )  {
+      // Deferred loads are accounted as loaded
+      result.loaded  = i_defer(required, begin(cond_missing), last_cond);
+      result.missing -= result.loaded;
+    }
+    else if ( do_load )  {
       ConditionsDataLoader::LoadedItems loaded;
       size_t updates = m_loader->load_many(required, cond_missing, loaded, pool_iov);
       if ( updates > 0 )  {
@@ -697,6 +992,10 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&                  required,
       copy(begin(cond_missing), last_cond, inserter(slice_miss_cond, slice_miss_cond.begin()));
     }
   }
+  // Our own registrations do not require a new selection in compute
+  if ( update_guard.owns_lock() )  {
+    m_generation = m_iovPool->generation;
+  }
   slice.status = result;
   return result;
 }
@@ -714,19 +1013,33 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
+  // Computing missing derived conditions must be serialized (see prepare).
+  // If the IOV pool changed since the last selection, the derived conditions
+  // computed meanwhile by other threads are added to the user pool.
+  std::unique_lock<std::mutex> update_guard(m_iovPool->update_lock, std::defer_lock);
+  CalcMissing calc_missing;
+  long num_calc_miss = 0;
 
+  m_pools.clear();
   slice_miss_calc.clear();
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
+  while ( true )   {
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    auto last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                                    begin(m_conditions), end(m_conditions),
+                                    begin(calc_missing), COMP());
+    calc_missing.erase(last_calc, end(calc_missing));
+    num_calc_miss = calc_missing.size();
+    if ( !do_load || update_guard.owns_lock() || num_calc_miss == 0 )
+      break;
+    update_guard.lock();
+    if ( m_generation == m_iovPool->generation )
+      break;
+    m_generation = m_iovPool->generation;
+    pool_iov = m_iov;
+    m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+    m_iov = pool_iov;
+  }
+  auto last_calc = end(calc_missing);
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "Found %ld missing derived conditions out of %ld conditions.",
            num_calc_miss, m_conditions.size());
@@ -742,6 +1055,10 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
     if ( do_load )  {
       std::map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
       ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
+      UpdateFlag updating(m_updating);
+      if ( m_manager->numThreads() > 1 )  {
+        handler.setDependencyGraph(slice.content->dependencyGraph());
+      }
 
       /// 1rst pass: Compute/create the missing condiions
       handler.compute();
@@ -786,9 +1103,12 @@ namespace dd4hep {
     ConditionsMappedUserPool<umap_t>::scan(Condition::key_type lower,
                                            Condition::key_type upper,
                                            const Condition::Processor& processor)   const  {
-      for( const auto& e : m_conditions )
-        if ( e.second->hash >= lower && e.second->hash <= upper )
-          processor(e.second);
+      for( const auto& e : m_conditions )  {
+        if ( e.second->hash >= lower && e.second->hash <= upper )  {
+          Condition::Object* o = i_access(e.second);
+          if ( o ) processor(o);
+        }
+      }
     }
     /// Access all conditions within a given key range
     /** Specialization necessary, since unordered maps have no lower bound.
@@ -797,8 +1117,10 @@ namespace dd4hep {
     ConditionsMappedUserPool<umap_t>::get(Condition::key_type lower, Condition::key_type upper)   const  {
       std::vector<Condition> result;
       for( const auto& e : m_conditions )  {
-        if ( e.second->hash >= lower && e.second->hash <= upper )
-          result.emplace_back(e.second);
+        if ( e.second->hash >= lower && e.second->hash <= upper )  {
+          Condition::Object* o = i_access(e.second);
+          if ( o ) result.emplace_back(o);
+        }
       }
       return result;
     }
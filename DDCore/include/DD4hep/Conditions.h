@@ -75,6 +75,7 @@ namespace dd4hep {
     enum ConditionState {
       INACTIVE            =  0,
       ACTIVE              =  1<<0,
+      ONDEMAND            =  1<<1,
       CHECKED             =  1<<2,
       DERIVED             =  1<<3,
       ONSTACK             =  1<<4,
@@ -91,7 +91,7 @@ namespace dd4hep {
   public:
 
     /// Local method (no interface): Load volume manager.
-    void imp_loadVolumeManager();
+    void imp_loadVolumeManager(int flags = VolumeManager::TREE);
     
     /// Default constructor used by ROOT I/O
     DetectorImp();
@@ -16,6 +16,7 @@
 
 // Framework include files
 #include <DD4hep/Volumes.h>
+#include <DD4hep/Readout.h>
 #include <DD4hep/DetElement.h>
 #include <DD4hep/NamedObject.h>
 #include <DD4hep/IDDescriptor.h>
@@ -24,6 +25,10 @@
 // ROOT include files
 #include <TGeoMatrix.h>
 
+// C/C++ include files
+#include <atomic>
+#include <memory>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -43,6 +48,19 @@ namespace dd4hep {
    *  then the calls are forwarded to an appended invisible structure at the end
    *  of the memory.
    *
+   *  The readout of the sensitive volume and the fused transformation from the
+   *  sensitive volume to the world are resolved once while populating. The fused
+   *  transformation follows the nominal alignment of the detector element and is
+   *  rebuilt by the volume manager if the placement of the subdetector changes.
+   *  Updates fill the idle half of a double buffer, which is allocated by the
+   *  first update, and publish it atomically. Readers hence never see a partially
+   *  updated transformation, provided they do not hold the transformation across
+   *  two consecutive updates. Updates are serialized by the volume manager.
+   *  The cache is only refreshed by the update callback of the volume manager:
+   *  changes of the nominal alignment not signalled by the detector element
+   *  require an explicit call to updateWorldTransformation().
+   *  Both caches are derived data and not ROOT persistent.
+   *
    * \author  M.Frank
    * \version 1.0
    * \ingroup DD4HEP_CORE
@@ -57,6 +75,15 @@ namespace dd4hep {
     VolumeID     mask       = ~0x0ULL;
     /// Flag to indicate optional information
     long         flag       = 0;
+    /// Readout of the sensitive volume
+    Readout      readout;   //! Not ROOT persistent
+    /// Fused nominal transformation volume -> world set while populating (see worldTransformation())
+    double       toWorld[12] { 1e0, 0e0, 0e0,  0e0, 1e0, 0e0,  0e0, 0e0, 1e0,  0e0, 0e0, 0e0 };   //! Not ROOT persistent
+  private:
+    /// Transformation published by the last update. NULL if not updated since populating
+    std::atomic<const double*> m_updatedToWorld { nullptr };   //! Not ROOT persistent
+    /// Double buffer for the transformations published by updates
+    std::unique_ptr<double[]> m_toWorldUpdates;                //! Not ROOT persistent
   public:
     /// Default constructor
     VolumeManagerContext() = default;
@@ -76,6 +103,15 @@ namespace dd4hep {
     PlacedVolume elementPlacement()  const;
     /// Access the transformation to the closest detector element
     const TGeoHMatrix& toElement()  const;
+    /// Access the fused volume -> world transformation: row-major rotation [0..8], translation [9..11]
+    const double* worldTransformation()  const   {
+      const double* trafo = m_updatedToWorld.load(std::memory_order_acquire);
+      return trafo ? trafo : toWorld;
+    }
+    /// Compute the fused volume -> world transformation from the nominal element alignment
+    void computeWorldTransformation(double world[12])  const;
+    /// Rebuild the fused volume -> world transformation and publish it atomically. Callers must serialize
+    void updateWorldTransformation();
     /// Transform local coordinates to the DetElement coordinates
     Position localToElement(const double local[3])  const;
     /// Transform local coordinates to the DetElement coordinates
@@ -122,6 +158,11 @@ namespace dd4hep {
    *  subdetectors must have the same length to ensure the uniqueness of the
    *  placement keys.
    *
+   *  Independent of the working mode, the populated volumes may be frozen
+   *  into a read-only flat hash index (FLAT flag or call to freeze()).
+   *  Lookups then resolve the VolumeID with a single hash probe and do not
+   *  take any locks. Once frozen, no further placements may be adopted.
+   *
    *  By default the volume manager in TREE mode (-> 1)) is attached to the
    *  Detector instance and also managed by this instance.
    *  If you wish to create instances yourself, you must ensure that the
@@ -140,6 +181,8 @@ namespace dd4hep {
       TREE = 1 << 1,   // Build 1 level DetElement hierarchy while populating
       ONE  = 1 << 2,   // Populate all daughter volumes into one big lookup-container
       // This flag may be in parallel with 'TREE'
+      FLAT = 1 << 3,   // Freeze all entries into a read-only flat hash index after populating
+      // This flag may be in parallel with 'TREE' or 'ONE'
       LAST
     };
 
@@ -192,6 +235,11 @@ namespace dd4hep {
     /// Access IDDescription structure
     IDDescriptor idSpec() const;
 
+    /// Freeze the populated volumes into the read-only flat lookup index (top level manager only)
+    std::size_t freeze();
+    /// Check if the lookup index is frozen
+    bool isFrozen()  const;
+
     /// Register physical volume with the manager (normally: section manager)
     bool adoptPlacement(VolumeManagerContext* context);
     /// Register physical volume with the manager and pre-computed volume id
@@ -30,6 +30,10 @@
 // ROOT include files
 #include "TGeoMatrix.h"
 
+// C/C++ include files
+#include <mutex>
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -54,6 +58,78 @@ namespace dd4hep {
       /// Default destructor
       ~VolumeManagerContextExtension() = default;
     };
+
+    /// Frozen, read-only flat hash index of all volume manager contexts
+    /**
+     *  Once the geometry is closed, all contexts of a volume manager tree
+     *  are copied into one open-addressing hash table keyed by the masked
+     *  volume identifier. The table is never modified after construction,
+     *  hence lookups may be executed concurrently without locking.
+     *
+     *  Each section corresponds to one populated volume container
+     *  (the top level manager and/or the subdetector managers) and carries
+     *  the system field and mask to be applied to the volume identifier.
+     *
+     * \author  M.Frank
+     * \version 1.0
+     * \ingroup DD4HEP_CORE
+     */
+    class VolumeManagerFlatIndex  {
+    public:
+      /// Description of one volume container merged into the index
+      struct Section  {
+        /// Bit mask of the system field (0 for the top level manager: matches all)
+        VolumeID sysMask = 0;
+        /// Encoded system identifier within the system field
+        VolumeID sysBits = 0;
+        /// Sub-detector mask to be applied before hashing
+        VolumeID detMask = ~0x0ULL;
+      };
+      /// Hash table slot. 4 slots share one cache line
+      struct Entry  {
+        /// Masked volume identifier
+        VolumeID              key     = 0;
+        /// Context pointer. NULL if the slot is empty
+        VolumeManagerContext* context = 0;
+      };
+      /// Ordered list of sections. Ordering defines the search precedence
+      std::vector<Section> sections;
+      /// Open addressing hash table with linear probing. Size is a power of 2
+      std::vector<Entry>   entries;
+      /// Bit mask to map hash values to slot indices
+      std::size_t          slotMask = 0;
+      /// Number of occupied slots
+      std::size_t          count    = 0;
+
+    public:
+      /// Default constructor
+      VolumeManagerFlatIndex() = default;
+      /// Default destructor
+      ~VolumeManagerFlatIndex() = default;
+      /// Hash function to spread the volume identifier bits over the slots
+      static inline std::size_t hash(VolumeID key)  {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return std::size_t(key);
+      }
+      /// Allocate the hash table for a given number of entries (load factor <= 0.5)
+      void reserve(std::size_t num_entries);
+      /// Insert a new entry. Returns the already present context on key clashes
+      VolumeManagerContext* insert(VolumeID key, VolumeManagerContext* context);
+      /// Lookup a context by its masked key
+      inline VolumeManagerContext* find(VolumeID key)  const  {
+        for( std::size_t slot = hash(key) & slotMask; ; slot = (slot + 1) & slotMask )  {
+          const Entry& e = entries[slot];
+          if ( !e.context ) return 0;
+          if ( e.key == key ) return e.context;
+        }
+      }
+      /// Search the index for the context matching a volume identifier
+      VolumeManagerContext* search(VolumeID volume_id)  const;
+    };
   
     /// This structure describes the internal data of the volume manager object
     /**
@@ -84,6 +160,10 @@ namespace dd4hep {
       VolumeID               detMask = ~0x0ULL;
       /// Population flags
       int                    flags   = VolumeManager::NONE;
+      /// Frozen flat lookup index (top level manager only)
+      VolumeManagerFlatIndex* flat   = 0;  //! Not ROOT persistent
+      /// Lock serializing the updates of the fused transformations (top level manager only)
+      std::mutex             updateLock;     //! Not ROOT persistent
     public:
       /// Default constructor
       VolumeManagerObject() = default;
@@ -21,8 +21,12 @@
 #include <DD4hep/DetectorProcessor.h>
 #include <DD4hep/AlignmentsProcessor.h>
 #include <DD4hep/AlignmentsCalculator.h>
+#include <DD4hep/detail/DetectorInterna.h>
 #include <DD4hep/detail/AlignmentsInterna.h>
 
+// C/C++ include files
+#include <set>
+
 using namespace dd4hep;
 using namespace dd4hep::align;
 using Result = AlignmentsCalculator::Result;
@@ -211,6 +215,25 @@ Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
     obj.resolve(context,i.first);
   for( auto& i : context.entries )
     result += obj.compute(context, i);
+
+  /// If the nominal alignments were recomputed (e.g. using the AlignmentsNominalMap),
+  /// all caches derived from them are invalid: notify the affected subdetectors.
+  std::set<DetElement::Object*> subdetectors;
+  for( const auto& e : context.entries )   {
+    if ( e.cond && e.det && e.cond == e.det->nominal.ptr() )   {
+      DetElement det(e.det);
+      if ( !det.parent().isValid() )  {
+        for( const auto& c : det.children() )
+          subdetectors.insert(c.second.ptr());
+        continue;
+      }
+      while( det.parent().parent().isValid() )
+        det = det.parent();
+      subdetectors.insert(det.ptr());
+    }
+  }
+  for( auto* det : subdetectors )
+    det->update(DetElement::PLACEMENT_CHANGED|DetElement::PLACEMENT_DETECTOR, det);
   return result;
 }
 
@@ -142,8 +142,19 @@ int DD4hepRootPersistency::load(Detector& description, const char* fname, const
         if ( persist->volumeManager().isValid() )   {
           const auto& sdets = persist->volumeManager()->subdetectors;
           size_t num[3] = {0,0,0};
+          /// The readout and the world transformation of the contexts are not persistent: rebuild them
+          auto fix_contexts = [](VolumeManager::Object* obj)  {
+            for( auto& v : obj->volumes )   {
+              VolumeManagerContext* ctx = v.second;
+              SensitiveDetector sd = ctx->volumePlacement().volume().sensitiveDetector();
+              ctx->readout = sd.isValid() ? sd.readout() : Readout();
+              ctx->computeWorldTransformation(ctx->toWorld);
+            }
+          };
+          fix_contexts(persist->volumeManager().ptr());
           for( const auto& vm : sdets )  {
             VolumeManager::Object* obj = vm.second.ptr();
+            fix_contexts(obj);
             obj->system = obj->id.field("system");
             if ( 0 != obj->system )   {
               printout(ALWAYS,"DD4hepRootPersistency",
@@ -23,6 +23,9 @@
 // C/C++ includes
 #include <set>
 #include <cmath>
+#include <mutex>
+#include <memory>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -253,6 +256,7 @@ namespace dd4hep {
             context->identifier = code.first;
             context->mask       = code.second;
             context->element    = e;
+            context->readout    = ro;
             context->flag       = nodes.empty() ? 0 : 1;
             if ( context->flag )  {
               detail::VolumeManagerContextExtension* ext = (detail::VolumeManagerContextExtension*)context;
@@ -262,6 +266,7 @@ namespace dd4hep {
                 ext->toElement.MultiplyLeft(m);
               }
             }
+            context->computeWorldTransformation(context->toWorld);
             if ( !section.adoptPlacement(context) || m_debug )  {
               print_node(sd, parent, e, n, code, nodes);
             }
@@ -326,6 +331,30 @@ const TGeoHMatrix& VolumeManagerContext::toElement()  const   {
   return ext->toElement;
 }
 
+/// Compute the fused volume -> world transformation from the nominal element alignment
+void VolumeManagerContext::computeWorldTransformation(double world[12])  const   {
+  TGeoHMatrix trafo(element.nominal().worldTransformation());
+  if ( 0 != flag )  {
+    trafo.Multiply(&toElement());
+  }
+  const Double_t* rot = trafo.GetRotationMatrix();
+  const Double_t* tra = trafo.GetTranslation();
+  std::copy(rot, rot+9, world);
+  std::copy(tra, tra+3, world+9);
+}
+
+/// Rebuild the fused volume -> world transformation and publish it atomically
+void VolumeManagerContext::updateWorldTransformation()   {
+  if ( !m_toWorldUpdates )  {
+    m_toWorldUpdates.reset(new double[24]);
+  }
+  // Readers may still use the published transformation: fill the other buffer
+  double* trafo = m_toWorldUpdates.get();
+  if ( m_updatedToWorld.load(std::memory_order_relaxed) == trafo ) trafo += 12;
+  computeWorldTransformation(trafo);
+  m_updatedToWorld.store(trafo, std::memory_order_release);
+}
+
 /// Transform local coordinates to the DetElement coordinates
 Position VolumeManagerContext::localToElement(const double local[3])  const   {
   double elt[3];
@@ -342,9 +371,10 @@ Position VolumeManagerContext::localToElement(const Position& local)  const   {
 
 /// Transform local coordinates to the world coordinates
 Position VolumeManagerContext::localToWorld(const double local[3])  const   {
-  double elt[3];
-  toElement().LocalToMaster(local, elt);
-  return element.nominal().localToWorld(elt);
+  const double* m = worldTransformation();
+  return { m[0]*local[0] + m[1]*local[1] + m[2]*local[2] + m[9],
+           m[3]*local[0] + m[4]*local[1] + m[5]*local[2] + m[10],
+           m[6]*local[0] + m[7]*local[1] + m[8]*local[2] + m[11] };
 }
 
 /// Transform local coordinates to the world coordinates
@@ -407,6 +437,10 @@ VolumeManager::VolumeManager(const Detector& description, const std::string& nam
     node_count = p.numNodes();
   }
   printout(INFO, "VolumeManager", " - populating volume ids - done. %ld nodes.",node_count);
+  if ( (flags & FLAT) == FLAT )  {
+    std::size_t num_flat = freeze();
+    printout(INFO, "VolumeManager", " - flat lookup index frozen with %ld entries.",num_flat);
+  }
 }
 
 /// Initializing constructor to create a new object
@@ -506,6 +540,63 @@ IDDescriptor VolumeManager::idSpec() const {
   return _data().id;
 }
 
+/// Freeze the populated volumes into the read-only flat lookup index
+std::size_t VolumeManager::freeze()   {
+  if ( !isValid() )  {
+    except("VolumeManager","freeze: Failed to build flat lookup index [Invalid Manager Handle]");
+  }
+  Object& o = _data();
+  if ( o.top != ptr() )  {
+    except("VolumeManager","freeze: Only the top level volume manager %s may be frozen.",
+           o.detector.name());
+  }
+  if ( o.flat )  {
+    return o.flat->count;
+  }
+  /// Collect the populated containers in the same order as the tree lookup searches them
+  std::vector<const Object*> containers;
+  std::size_t num_entries = o.volumes.size();
+  containers.emplace_back(&o);
+  for (const auto& j : o.subdetectors )  {
+    const Object& mo = j.second._data();
+    containers.emplace_back(&mo);
+    num_entries += mo.volumes.size();
+  }
+  std::unique_ptr<VolumeManagerFlatIndex> index(new VolumeManagerFlatIndex());
+  index->reserve(num_entries);
+  for ( const Object* obj : containers )  {
+    if ( obj->volumes.empty() ) continue;
+    VolumeManagerFlatIndex::Section sec;
+    if ( obj != &o && obj->system )  {
+      sec.sysMask = obj->system->mask();
+      sec.sysBits = (obj->sysID << obj->system->offset()) & sec.sysMask;
+    }
+    sec.detMask = obj->detMask;
+    index->sections.emplace_back(sec);
+    for ( const auto& v : obj->volumes )  {
+      VolumeManagerContext* ctxt = index->insert(v.first & sec.detMask, v.second);
+      if ( ctxt != v.second )  {
+        /// Keys of different sections clash: the flat index cannot reproduce the tree lookup
+        printout(WARNING, "VolumeManager", "freeze: Volume id %016llX of %s clashes with %s. "
+                 "Keep tree lookup.", v.first, v.second->element.path().c_str(),
+                 ctxt->element.path().c_str());
+        return 0;
+      }
+    }
+  }
+  o.flat = index.release();
+  return o.flat->count;
+}
+
+/// Check if the lookup index is frozen
+bool VolumeManager::isFrozen()  const   {
+  if ( isValid() )  {
+    const Object& o = _data();
+    return o.top && o.top->flat != 0;
+  }
+  return false;
+}
+
 /// Register physical volume with the manager (normally: section manager)
 bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* context) {
   std::stringstream err;
@@ -569,6 +660,10 @@ bool VolumeManager::adoptPlacement(VolumeManagerContext* context) {
   std::stringstream err;
   if ( isValid() ) {
     Object& o = _data();
+    if ( o.top && o.top->flat )  {
+      except("VolumeManager","dd4hep: Failed to add new physical volume to detector: %s "
+             "[Lookup index is frozen]", o.detector.name());
+    }
     if ( context )   {
       if ( (o.flags & ONE) == ONE ) {
         VolumeManager top(o.top);
@@ -606,6 +701,12 @@ VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
   if (isValid()) {
     VolumeManagerContext* c = 0;
     const Object& o = _data();
+    /// Frozen index: single hash probe, no further searches necessary
+    if ( o.flat )  {
+      if ( (c = o.flat->search(volume_id)) != 0 )
+        return c;
+      except("VolumeManager","lookupContext: Failed to search Volume context %016llX [Unknown identifier]", (void*)volume_id);
+    }
     bool is_top = o.top == ptr();
     bool one_tree = (o.flags & ONE) == ONE;
     if ( !is_top && one_tree ) {
@@ -715,6 +816,8 @@ std::ostream& dd4hep::operator<<(std::ostream& os, const VolumeManager& mgr) {
 
 /// Default destructor
 VolumeManagerObject::~VolumeManagerObject() {
+  /// Cleanup flat lookup index
+  detail::deletePtr(flat);
   /// Cleanup volume tree
   destroyObjects(volumes);
   /// Cleanup dependent managers
@@ -730,8 +833,19 @@ void VolumeManagerObject::update(unsigned long tags, DetElement& det, void* para
   if ( DetElement::PLACEMENT_CHANGED == (tags&DetElement::PLACEMENT_CHANGED) )
     printout(DEBUG,"VolumeManager","+++ Alignment update %s param:%p",det.path().c_str(),param);
   
-  for(const auto& i : volumes )
-    printout(DEBUG,"VolumeManager","+++ Alignment update %s",i.second->elementPlacement().name());
+  /// The fused transformations follow the nominal alignment: rebuild them.
+  /// If all placements are held by the top level manager, only update the affected ones.
+  const auto& vols = (this != top && volumes.empty() && top) ? top->volumes : volumes;
+  std::string prefix = det.path() + "/";
+  /// Contexts may be shared with the top level manager: serialize the updates there
+  std::lock_guard<std::mutex> lock((top ? top : this)->updateLock);
+  for(const auto& i : vols )   {
+    VolumeManagerContext* c = i.second;
+    if ( &vols == &volumes || c->element == det || 0 == c->element.path().find(prefix) )  {
+      printout(DEBUG,"VolumeManager","+++ Alignment update %s",c->elementPlacement().name());
+      c->updateWorldTransformation();
+    }
+  }
 }
 
 /// Search the locally cached volumes for a matching ID
@@ -740,3 +854,42 @@ VolumeManagerContext* VolumeManagerObject::search(const VolumeID& vol_id) const
   return (i == volumes.end()) ? 0 : (*i).second;
 }
 
+
+/// Allocate the hash table for a given number of entries (load factor <= 0.5)
+void VolumeManagerFlatIndex::reserve(std::size_t num_entries)   {
+  std::size_t num_slots = 16;
+  while ( num_slots < 2*num_entries ) num_slots <<= 1;
+  entries.assign(num_slots, Entry());
+  slotMask = num_slots - 1;
+  count    = 0;
+}
+
+/// Insert a new entry. Returns the already present context on key clashes
+VolumeManagerContext* VolumeManagerFlatIndex::insert(VolumeID key, VolumeManagerContext* context)   {
+  for( std::size_t slot = hash(key) & slotMask; ; slot = (slot + 1) & slotMask )  {
+    Entry& e = entries[slot];
+    if ( !e.context )  {
+      e.key     = key;
+      e.context = context;
+      ++count;
+      return context;
+    }
+    if ( e.key == key )  {
+      return e.context;
+    }
+  }
+}
+
+/// Search the index for the context matching a volume identifier
+VolumeManagerContext* VolumeManagerFlatIndex::search(VolumeID volume_id)  const   {
+  if ( 0 == count )  {
+    return 0;
+  }
+  for( const auto& sec : sections )  {
+    if ( (volume_id & sec.sysMask) == sec.sysBits )  {
+      if ( VolumeManagerContext* c = find(volume_id & sec.detMask) )
+        return c;
+    }
+  }
+  return 0;
+}
@@ -798,16 +798,24 @@ DECLARE_APPLY(DD4hep_XMLProcessor,process_xml_doc)
 /**
  *  Factory: DD4hep_VolumeManager
  *
+ *  Optional arguments:
+ *  -flat   Freeze the populated volumes into the read-only flat lookup index
+ *
  *  \author  M.Frank
  *  \version 1.0
  *  \date    01/04/2014
  */
-static long load_volmgr(Detector& description, int, char**) {
+static long load_volmgr(Detector& description, int argc, char** argv) {
+  int flags = VolumeManager::TREE;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp(argv[i],"-flat",5) )
+      flags |= VolumeManager::FLAT;
+  }
   printout(INFO,"DD4hepVolumeManager","**** running plugin DD4hepVolumeManager ! " );
   try {
     DetectorImp* imp = dynamic_cast<DetectorImp*>(&description);
     if ( imp )  {
-      imp->imp_loadVolumeManager();
+      imp->imp_loadVolumeManager(flags);
       printout(INFO,"VolumeManager","+++ Volume manager populated and loaded.");
       return 1;
     }
@@ -0,0 +1,105 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/VolumeManager.h>
+#include <DD4hep/detail/VolumeManagerInterna.h>
+
+// C/C++ include files
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <algorithm>
+
+using namespace dd4hep;
+
+namespace  {
+
+  /// Time the lookup of all volume identifiers. Returns nanoseconds per lookup
+  double time_lookups(VolumeManager mgr, const std::vector<VolumeID>& ids,
+                      std::vector<VolumeManagerContext*>& found, int num_iter)
+  {
+    auto start = std::chrono::high_resolution_clock::now();
+    for( int iter = 0; iter < num_iter; ++iter )  {
+      for( std::size_t i = 0; i < ids.size(); ++i )
+        found[i] = mgr.lookupContext(ids[i]);
+    }
+    std::chrono::duration<double, std::nano> ns = std::chrono::high_resolution_clock::now() - start;
+    return ns.count() / double(num_iter * ids.size());
+  }
+
+  /// Compare the lookup speed of the volume manager in tree mode and frozen flat mode
+  /**
+   *  Factory: DD4hep_VolumeManagerBenchmark
+   *
+   *  Note: The plugin freezes the volume manager of the detector description.
+   *        Further placements cannot be adopted after the execution.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   */
+  long run_volmgr_benchmark(Detector& description, int argc, char** argv)   {
+    int num_iter = 10;
+    for(int i = 0; i < argc && argv[i]; ++i)  {
+      if ( 0 == ::strncmp(argv[i],"-iterations",4) && (i+1) < argc )
+        num_iter = std::max(1, ::atoi(argv[++i]));
+      else  {
+        std::cout <<
+          "Usage: -plugin DD4hep_VolumeManagerBenchmark -arg [-arg]                   \n"
+          "     -iterations <number>   Number of passes over all volume identifiers. \n"
+          "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+        ::exit(EINVAL);
+      }
+    }
+    VolumeManager mgr = VolumeManager::getVolumeManager(description);
+    if ( mgr.isFrozen() )  {
+      except("VolumeMgrBenchmark","The volume manager is already frozen. Load it in TREE mode.");
+    }
+    /// Collect all registered volume identifiers and access them in random order
+    std::vector<VolumeID> ids;
+    const detail::VolumeManagerObject& top = *mgr.data<detail::VolumeManagerObject>();
+    for( const auto& v : top.volumes ) ids.emplace_back(v.first);
+    for( const auto& s : top.subdetectors )  {
+      for( const auto& v : s.second.data<detail::VolumeManagerObject>()->volumes ) ids.emplace_back(v.first);
+    }
+    if ( ids.empty() )  {
+      except("VolumeMgrBenchmark","The volume manager contains no placements.");
+    }
+    std::shuffle(ids.begin(), ids.end(), std::mt19937_64(12345));
+
+    std::vector<VolumeManagerContext*> tree_ctxt(ids.size()), flat_ctxt(ids.size());
+    double tree_ns = time_lookups(mgr, ids, tree_ctxt, num_iter);
+    std::size_t num_flat = mgr.freeze();
+    if ( 0 == num_flat )  {
+      except("VolumeMgrBenchmark","Failed to freeze the volume manager lookup index.");
+    }
+    double flat_ns = time_lookups(mgr, ids, flat_ctxt, num_iter);
+    std::size_t num_errors = 0;
+    for( std::size_t i = 0; i < ids.size(); ++i )  {
+      if ( tree_ctxt[i] != flat_ctxt[i] ) ++num_errors;
+    }
+    printout(num_errors > 0 ? ERROR : ALWAYS, "VolumeMgrBenchmark",
+             "+++ %ld volume ids x %d iterations. TREE: %7.1f ns/lookup FLAT: %7.1f ns/lookup "
+             "Speed-up: %5.1f Mismatches: %ld",
+             ids.size(), num_iter, tree_ns, flat_ns, tree_ns/flat_ns, num_errors);
+    return num_errors == 0 ? 1 : 0;
+  }
+}
+DECLARE_APPLY(DD4hep_VolumeManagerBenchmark,run_volmgr_benchmark)
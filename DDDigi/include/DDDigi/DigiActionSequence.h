@@ -69,6 +69,12 @@ namespace dd4hep {
       void end(Q* p, void (T::*f)(context_t* context))  {
         m_end.add(p, f);
       }
+      /// Check if external listener callbacks are registered
+      bool has_callbacks()  const   {
+        return !m_begin.empty() || !m_end.empty();
+      }
+      /// Data flow of the sequence. Unknown if external callbacks are registered
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Begin-of-event callback
       virtual void execute(context_t& context)  const override;
     };
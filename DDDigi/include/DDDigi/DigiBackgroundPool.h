@@ -0,0 +1,107 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIBACKGROUNDPOOL_H
+#define DDDIGI_DIGIBACKGROUNDPOOL_H
+
+/// Framework include files
+#include <DDDigi/DigiInputAction.h>
+#include <DDDigi/DigiData.h>
+
+/// C/C++ include files
+#include <atomic>
+#include <memory>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Pile-up input action drawing events from a shared in-memory pool
+    /**
+     *  At initialization 'pool_size' minimum bias events are read from the
+     *  input sources using an input action of type 'reader_type'.
+     *  The deposit containers are sorted by cell identifier and stored as
+     *  immutable, shared objects. The history of the deposits is dropped.
+     *
+     *  For every signal event and every bunch crossing a number of events
+     *  (poisson distributed with mean 'mu' or fixed) is drawn with
+     *  replacement from the pool. For each container a DepositOverlay view
+     *  referencing the shared deposits is added to the input segment.
+     *  The deposits are not copied: the time offset of the bunch crossing
+     *  and the mask are applied when the containers are combined
+     *  (see DigiContainerCombine).
+     *
+     *  The pool is read-only after initialization. Hence the action
+     *  may be executed concurrently for several events.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiBackgroundPool : public DigiInputAction {
+    public:
+      /// One pool event: the shared deposit containers
+      using pool_event_t = std::vector<std::pair<Key, DepositOverlay::source_t> >;
+
+    protected:
+      /// Property: Type of the input action reading the pool events
+      std::string               m_reader_type;
+      /// Property: Number of events in the pool
+      int                       m_pool_size;
+      /// Property: Mean number of pile-up events per bunch crossing
+      double                    m_mu;
+      /// Property: Flag to draw a poisson distributed number of events per bunch crossing
+      bool                      m_poisson;
+      /// Property: Time offsets of the bunch crossings
+      std::vector<double>       m_crossings;
+      /// Property: Masks of the bunch crossings (default: mask + index of the crossing)
+      std::vector<int>          m_crossing_masks;
+
+      /// Input action to read the pool events
+      DigiInputAction*          m_reader  { nullptr };
+      /// Pool of decoded events
+      std::vector<pool_event_t> m_pool;
+      /// Identifier of the random stream of this action
+      std::uint64_t             m_stream_key  { 0 };
+      /// Monitoring: number of events drawn from the pool
+      mutable std::atomic<std::size_t> m_num_drawn  { 0 };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiBackgroundPool);
+
+      /// Convert the deposit containers of one event to a pool event
+      pool_event_t load_event(DataSegment& segment)  const;
+
+    public:
+      /// Standard constructor
+      DigiBackgroundPool(const kernel_t& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiBackgroundPool();
+      /// Initialization callback: read the pool events
+      virtual void initialize();
+      /// Finalization callback: print usage statistics
+      virtual void finalize();
+      /// Access to the number of events in the pool
+      std::size_t pool_size()  const   {
+	return m_pool.size();
+      }
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
+      /// Callback to overlay pile-up events to the input segment
+      virtual void execute(context_t& context)  const override;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIBACKGROUNDPOOL_H
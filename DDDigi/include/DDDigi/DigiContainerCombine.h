@@ -32,6 +32,13 @@ namespace dd4hep {
      *  This is a utility class supporting properties, output and access to
      *  event and run objects through the context.
      *
+     *  If the property merge_cells is set, the deposits of identical cells
+     *  are accumulated. The deposit containers are merged using a k-way merge:
+     *  first chunks of each container are sorted by cell identifier, then the
+     *  sorted runs are merged per cell range. Both steps are executed in
+     *  parallel if the action is parallel. The result is independent of the
+     *  number of chunks and ranges.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_DIGITIZATION
@@ -39,9 +46,12 @@ namespace dd4hep {
     class DigiContainerCombine : public DigiEventAction   {
     public:
       class work_definition_t;
+      class merge_definition_t;
       using self_t  = DigiContainerCombine;
       using Worker  = DigiParallelWorker<self_t,work_definition_t>;
       using Workers = DigiParallelWorkers<Worker>;
+      using MergeWorker  = DigiParallelWorker<self_t,merge_definition_t>;
+      using MergeWorkers = DigiParallelWorkers<MergeWorker>;
 
     protected:
       /// Property: Container names to be loaded
@@ -66,16 +76,22 @@ namespace dd4hep {
       bool                           m_merge_history;
       /// Property: Flag to indicate to merge 
       bool                           m_merge_particles;
+      /// Property: Flag to accumulate deposits of identical cells using the k-way merge
+      bool                           m_merge_cells;
+      /// Property: Number of cell ranges merged in parallel per output container (0: hardware concurrency)
+      int                            m_merge_ranges;
+      /// Property: Maximal number of deposits sorted by one worker
+      int                            m_merge_chunk;
 
       /// Fully qualified keys of all containers to be manipulated
       std::set<Key::key_type>        m_keys  { };
       /// Container keys of all containers to be manipulated
       std::set<Key::key_type>        m_cont_keys  { };
 
-      /// Lock to properly accumulate keys which were already used
-      mutable std::mutex             m_used_keys_lock;
       /// Worker objects to be submitted to TBB each performing part of the job
       Workers m_workers;
+      /// Worker objects to be submitted to TBB for the k-way merge of deposits
+      MergeWorkers m_merge_workers;
 
     protected:
       /// Define standard assignments and constructors
@@ -90,6 +106,12 @@ namespace dd4hep {
       /// Check if we have sufficient workers
       void have_workers(size_t len)  const;
 
+      /// Check if we have sufficient workers for the k-way merge
+      void have_merge_workers(size_t len)  const;
+
+      /// Merge deposits of identical cells of all selected deposit containers
+      void merge_cells(context_t& context, merge_definition_t& def)  const;
+
       /// Combine selected containers to one single deposit container
       std::size_t combine_containers(context_t& context,
 				     DigiEvent& event,
@@ -103,6 +125,8 @@ namespace dd4hep {
       /// Standard constructor
       DigiContainerCombine(const kernel_t& kernel, const std::string& name);
 
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Main functional callback
       virtual void execute(context_t& context)  const;
     };
@@ -71,6 +71,8 @@ namespace dd4hep {
       /// Standard constructor
       DigiContainerDrop(const kernel_t& kernel, const std::string& name);
 
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Main functional callback
       virtual void execute(context_t& context)  const;
     };
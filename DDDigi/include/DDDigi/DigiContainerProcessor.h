@@ -85,6 +85,10 @@ namespace dd4hep {
         predicate_t& operator = (const predicate_t& copy) = default;
         /// Check if a deposit should be processed
         bool operator()(const deposit_t& deposit)   const;
+        /// Evaluate the predicate for all deposits of an array container. Returns the number of selected entries
+        std::size_t select(const DepositArrays& deposits, std::vector<uint8_t>& selected)   const;
+        /// Evaluate the predicate for all deposits of a deposit view. Returns the number of selected entries
+        std::size_t select(const DepositView& deposits, std::vector<uint8_t>& selected)   const;
         static bool always_true(const deposit_t&)        { return true; }
         static bool not_killed (const deposit_t& depo)   { return 0 == (depo.second.flag&EnergyDeposit::KILLED); }
       };
@@ -159,6 +163,8 @@ namespace dd4hep {
     protected:
       std::function<void(context_t& context, DepositVector& cont,  work_t& work, const predicate_t& predicate)>	m_handleVector;
       std::function<void(context_t& context, DepositMapping& cont, work_t& work, const predicate_t& predicate)>	m_handleMapping;
+      std::function<void(context_t& context, DepositArrays& cont,  work_t& work, const predicate_t& predicate)>	m_handleArrays;
+      std::function<void(context_t& context, DepositView& cont,    work_t& work, const predicate_t& predicate)>	m_handleView;
 
     public:
       /// Standard constructor
@@ -180,6 +186,20 @@ namespace dd4hep {
                                        std::placeholders::_3,           \
                                        std::placeholders::_4)
 
+#define DEPOSIT_PROCESSOR_BIND_ARRAY_HANDLER(X)                         \
+    this->m_handleArrays  = std::bind( &X,  this,                       \
+                                       std::placeholders::_1,           \
+                                       std::placeholders::_2,           \
+                                       std::placeholders::_3,           \
+                                       std::placeholders::_4)
+
+#define DEPOSIT_PROCESSOR_BIND_VIEW_HANDLER(X)                          \
+    this->m_handleView    = std::bind( &X,  this,                       \
+                                       std::placeholders::_1,           \
+                                       std::placeholders::_2,           \
+                                       std::placeholders::_3,           \
+                                       std::placeholders::_4)
+
     /// Worker class act on containers in an event identified by input masks and container name
     /**
      *  The sequencer calls all registered processors for the contaiers registered.
@@ -245,8 +265,8 @@ namespace dd4hep {
 
     /// Worker base class to analyse containers from the input segment in parallel
     /**
-     *  Depending on the adopted processors, the full input record is scanned and
-     *  the registered processors are called.
+     *  Depending on the adopted processors, the input containers are looked up
+     *  by their data slots and the registered processors are called.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -269,6 +289,7 @@ namespace dd4hep {
       using predicate_t      = processor_t::predicate_t;
       using reg_workers_t    = std::map<Key::key_type, worker_t*>;
       using reg_processors_t = std::map<Key::key_type, processor_t*>;
+      using slot_workers_t   = std::vector<std::pair<DataSlot, worker_t*> >;
       friend class DigiParallelWorker<processor_t, work_t, std::size_t, self_t&>;
 
       /// Property: Input data segment name
@@ -286,6 +307,8 @@ namespace dd4hep {
       reg_processors_t         m_registered_processors { };
       /// Registered worker map
       reg_workers_t            m_registered_workers    { };
+      /// Data slots of the input containers with the corresponding workers
+      slot_workers_t           m_slot_workers          { };
       /// Default Deposit predicate
       predicate_t              m_worker_predicate      { processor_t::accept_all() };
 
@@ -317,6 +340,8 @@ namespace dd4hep {
       virtual void adopt_processor(DigiContainerProcessor* action, const std::string& container);
       /// Adopt new parallel worker acting on multiple containers
       virtual void adopt_processor(DigiContainerProcessor* action, const std::vector<std::string>& containers);
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Main functional callback if specific work is known
       virtual void execute(context_t& context)  const override;
     };
@@ -392,6 +417,8 @@ namespace dd4hep {
       virtual void set_predicate(const predicate_t& predicate);
       /// Adopt new parallel worker
       virtual void adopt_processor(DigiContainerProcessor* action, const std::vector<std::string>& containers);
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Main functional callback
       virtual void execute(context_t& context)  const;
     };
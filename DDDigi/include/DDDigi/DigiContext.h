@@ -17,6 +17,7 @@
 #include <DD4hep/Primitives.h>
 #include <DDDigi/DigiData.h>
 #include <DDDigi/DigiRandomGenerator.h>
+#include <DDDigi/DigiRandomStream.h>
 
 /// C/C++ include files
 #include <memory>
@@ -124,6 +125,8 @@ namespace dd4hep {
 
       /// Access to the random engine for this event
       DigiRandomGenerator& randomGenerator()  const  { return *m_random; }
+      /// Counter based random stream of this event identified by a key (e.g. cell or container key)
+      DigiRandomStream randomStream(std::uint64_t key)  const;
       /// Access to the user framework. Specialized function to be implemented by the client
       template <typename T> T& framework()  const;
       /// Generic framework access
@@ -20,9 +20,12 @@
 #include <cstdint>
 #include <memory>
 #include <limits>
+#include <atomic>
 #include <mutex>
 #include <map>
 #include <any>
+#include <deque>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -40,6 +43,8 @@ namespace dd4hep {
     class EnergyDeposit;
     class ParticleMapping;
     class DepositMapping;
+    class DepositOverlay;
+    class DepositView;
     class DigiEvent;
     class DataSegment;
 
@@ -612,12 +617,22 @@ namespace dd4hep {
       std::size_t merge(DepositMapping&& updates);
       /// Merge new deposit map onto existing map (destroys inputs. not thread safe!)
       std::size_t merge(const DepositMapping& updates);
+      /// Merge shared pile-up deposits onto existing vector (shared inputs are kept. not thread safe!)
+      std::size_t merge(DepositOverlay&& updates);
+      /// Merge deposit view onto existing vector (the deposits are materialized. not thread safe!)
+      std::size_t merge(DepositView&& updates);
       /// Merge new deposit map onto existing vector (keep inputs. not thread safe!)
       std::size_t insert(const DepositVector& updates);
       /// Merge new deposit map onto existing map (keep inputs. not thread safe!)
       std::size_t insert(const DepositMapping& updates);
+      /// Merge shared pile-up deposits onto existing vector (keep inputs. not thread safe!)
+      std::size_t insert(const DepositOverlay& updates);
+      /// Merge deposit view onto existing vector (keep inputs. not thread safe!)
+      std::size_t insert(const DepositView& updates);
       /// Emplace entry
       void emplace(CellID cell, EnergyDeposit&& deposit);
+      /// Reserve space for a given number of entries
+      void reserve(std::size_t len)       { this->data.reserve(len);         }
 
       /// Access container size
       std::size_t size()  const           { return this->data.size();        }
@@ -724,6 +739,274 @@ namespace dd4hep {
     {
     }
 
+    /// Energy deposit arrays (structure of arrays) for digitization
+    /**
+     *  Each deposit attribute is held in a separate contiguous array.
+     *  Processing kernels touching only few attributes (energy, time, flags)
+     *  stream through dense arrays, which the compiler may vectorize.
+     *  The deposit history is held out-of-line.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DepositArrays : public SegmentEntry  {
+    public:
+      /// Cell identifiers
+      std::vector<CellID>          cell          { };
+      /// Total energy deposits
+      std::vector<double>          deposit       { };
+      /// Errors of the energy deposits
+      std::vector<double>          depositError  { };
+      /// Proper creation times of the deposits with respect to beam crossing
+      std::vector<double>          time          { };
+      /// Lengths of the track segments contributing to the deposits
+      std::vector<double>          length        { };
+      /// Deposit positions
+      std::vector<Position>        position      { };
+      /// Deposit directions
+      std::vector<Direction>       momentum      { };
+      /// Flags for user masks
+      std::vector<uint64_t>        flag          { };
+      /// Source masks of the deposits
+      std::vector<Key::mask_type>  mask          { };
+      /// Deposit histories
+      std::vector<History>         history       { };
+
+    public: 
+      /// Initializing constructor
+      DepositArrays(const std::string& name, Key::mask_type mask, data_type_t typ);
+      /// Default constructor
+      DepositArrays() = default;
+      /// Disable move constructor
+      DepositArrays(DepositArrays&& copy) = default;
+      /// Disable copy constructor
+      DepositArrays(const DepositArrays& copy) = default;      
+      /// Default destructor
+      virtual ~DepositArrays() = default;
+      /// Disable move assignment
+      DepositArrays& operator=(DepositArrays&& copy) = default;
+      /// Disable copy assignment
+      DepositArrays& operator=(const DepositArrays& copy) = default;      
+
+      /// Append deposit vector (keep inputs. not thread safe!)
+      std::size_t insert(const DepositVector& updates);
+      /// Append deposit mapping (keep inputs. not thread safe!)
+      std::size_t insert(const DepositMapping& updates);
+      /// Append all deposits to a deposit vector (not thread safe!)
+      std::size_t fill(DepositVector& output)  const;
+      /// Emplace entry
+      void emplace(CellID cell, EnergyDeposit&& deposit);
+      /// Emplace entry
+      void emplace(CellID cell, const EnergyDeposit& deposit);
+      /// Reserve space for a given number of entries
+      void reserve(std::size_t len);
+      /// Remove all entries
+      void clear();
+
+      /// Access container size
+      std::size_t size()  const           { return this->cell.size();        }
+      /// Check container if empty
+      bool        empty() const           { return this->cell.empty();       }
+      /// Access energy deposit by index (Copies all attributes)
+      EnergyDeposit at(std::size_t entry)   const;
+    };
+
+    /// Initializing constructor
+    inline DepositArrays::DepositArrays(const std::string& nam, Key::mask_type msk, data_type_t typ)
+      : SegmentEntry(nam, msk, typ)
+    {
+    }
+
+    /// Read-only view of shared energy deposits of pile-up events
+    /**
+     *  The deposits are owned by a background pool and shared by all events,
+     *  which drew the same pile-up event: the view only holds references.
+     *  The time offset and the mask of the view are applied when the deposits
+     *  are copied to a deposit container e.g. when containers are combined.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DepositOverlay : public SegmentEntry  {
+    public:
+      using source_t = std::shared_ptr<const DepositVector>;
+
+      /// Shared deposit sources (sorted by cell identifier)
+      std::vector<source_t>  sources      { };
+      /// Time offset added to the deposit times
+      double                 time_offset  { 0e0 };
+
+    public: 
+      /// Initializing constructor
+      DepositOverlay(const std::string& name, Key::mask_type mask, data_type_t typ, double time_offset);
+      /// Default constructor
+      DepositOverlay() = default;
+      /// Disable move constructor
+      DepositOverlay(DepositOverlay&& copy) = default;
+      /// Disable copy constructor
+      DepositOverlay(const DepositOverlay& copy) = default;      
+      /// Default destructor
+      virtual ~DepositOverlay() = default;
+      /// Disable move assignment
+      DepositOverlay& operator=(DepositOverlay&& copy) = default;
+      /// Disable copy assignment
+      DepositOverlay& operator=(const DepositOverlay& copy) = default;      
+
+      /// Add shared deposit source
+      void add(const source_t& source)    { this->sources.emplace_back(source); }
+      /// Apply time offset and mask to the copy of a shared deposit
+      void apply(EnergyDeposit& deposit)  const;
+      /// Access number of deposits of all sources
+      std::size_t size()  const;
+      /// Check if the view contains deposits
+      bool        empty() const           { return this->size() == 0;        }
+    };
+
+    /// Initializing constructor
+    inline DepositOverlay::DepositOverlay(const std::string& nam, Key::mask_type msk, data_type_t typ, double offset)
+      : SegmentEntry(nam, msk, typ), time_offset(offset)
+    {
+    }
+
+    /// Apply time offset and mask to the copy of a shared deposit
+    inline void DepositOverlay::apply(EnergyDeposit& deposit)  const   {
+      deposit.time += this->time_offset;
+      deposit.mask  = this->key.mask();
+    }
+
+    /// Deposit view of hits kept in the memory of their input source
+    /**
+     *  The view does not copy the input hits: the attributes are read
+     *  in place through the source interface implemented by the input reader.
+     *  A real EnergyDeposit including its history is only created
+     *  when a processor requests write access to an entry.
+     *  Reading attributes of such an entry returns the modified values.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DepositView : public SegmentEntry  {
+    public:
+      using value_type = std::pair<const CellID, EnergyDeposit>;
+
+      /// Read access to the deposits of the input source
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_DIGITIZATION
+       */
+      class source_t  {
+      public:
+        /// Default destructor
+        virtual ~source_t() = default;
+        /// Number of deposits in the source
+        virtual std::size_t size()  const = 0;
+        /// Cell identifier of an entry
+        virtual CellID   cell(std::size_t entry)  const = 0;
+        /// Energy deposit of an entry
+        virtual double   deposit(std::size_t entry)  const = 0;
+        /// Creation time of an entry
+        virtual double   time(std::size_t entry)  const = 0;
+        /// Position of an entry
+        virtual Position position(std::size_t entry)  const = 0;
+        /// User flags of an entry
+        virtual uint64_t flag(std::size_t entry)  const = 0;
+        /// Create the full energy deposit of an entry including the history
+        virtual EnergyDeposit materialize(std::size_t entry)  const = 0;
+      };
+
+      /// Input hits (shared, read-only)
+      std::shared_ptr<const source_t>  source        { };
+      /// Deposits materialized for modification (addresses are stable)
+      std::deque<value_type>           materialized  { };
+      /// Index of the materialized deposit of each entry + 1 (0: not materialized)
+      std::vector<uint32_t>            modified      { };
+
+    public: 
+      /// Initializing constructor
+      DepositView(const std::string& name, Key::mask_type mask, data_type_t typ, std::shared_ptr<const source_t> source);
+      /// Default constructor
+      DepositView() = default;
+      /// Disable move constructor
+      DepositView(DepositView&& copy) = default;
+      /// Disable copy constructor
+      DepositView(const DepositView& copy) = default;      
+      /// Default destructor
+      virtual ~DepositView() = default;
+      /// Disable move assignment
+      DepositView& operator=(DepositView&& copy) = default;
+      /// Disable copy assignment
+      DepositView& operator=(const DepositView& copy) = default;      
+
+      /// Access container size
+      std::size_t size()  const           { return this->source ? this->source->size() : 0UL; }
+      /// Check container if empty
+      bool        empty() const           { return this->size() == 0;        }
+      /// Number of materialized deposits
+      std::size_t num_materialized() const { return this->materialized.size(); }
+
+      /// Access materialized deposit of an entry. NULL if the entry was not modified
+      const EnergyDeposit* modified_deposit(std::size_t entry)  const;
+      /// Write access to an entry: the deposit is materialized on first access
+      EnergyDeposit& mutate(std::size_t entry);
+      /// Copy of the deposit of an entry (materialized if not modified)
+      EnergyDeposit get(std::size_t entry)  const;
+
+      /// Cell identifier of an entry
+      CellID   cell(std::size_t entry)  const    {  return this->source->cell(entry); }
+      /// Energy deposit of an entry
+      double   deposit(std::size_t entry)  const;
+      /// Creation time of an entry
+      double   time(std::size_t entry)  const;
+      /// Position of an entry
+      Position position(std::size_t entry)  const;
+      /// User flags of an entry
+      uint64_t flag(std::size_t entry)  const;
+
+      /// Append all deposits to a deposit vector (not thread safe!)
+      std::size_t fill(DepositVector& output)  const;
+    };
+
+    /// Initializing constructor
+    inline DepositView::DepositView(const std::string& nam, Key::mask_type msk, data_type_t typ, std::shared_ptr<const source_t> src)
+      : SegmentEntry(nam, msk, typ), source(std::move(src))
+    {
+    }
+
+    /// Access materialized deposit of an entry. NULL if the entry was not modified
+    inline const EnergyDeposit* DepositView::modified_deposit(std::size_t entry)  const   {
+      if ( entry < this->modified.size() && this->modified[entry] > 0 )
+        return &this->materialized[this->modified[entry]-1].second;
+      return nullptr;
+    }
+
+    /// Energy deposit of an entry
+    inline double DepositView::deposit(std::size_t entry)  const   {
+      const EnergyDeposit* depo = this->modified_deposit(entry);
+      return depo ? depo->deposit : this->source->deposit(entry);
+    }
+
+    /// Creation time of an entry
+    inline double DepositView::time(std::size_t entry)  const   {
+      const EnergyDeposit* depo = this->modified_deposit(entry);
+      return depo ? depo->time : this->source->time(entry);
+    }
+
+    /// Position of an entry
+    inline Position DepositView::position(std::size_t entry)  const   {
+      const EnergyDeposit* depo = this->modified_deposit(entry);
+      return depo ? depo->position : this->source->position(entry);
+    }
+
+    /// User flags of an entry
+    inline uint64_t DepositView::flag(std::size_t entry)  const   {
+      const EnergyDeposit* depo = this->modified_deposit(entry);
+      return depo ? depo->flag : this->source->flag(entry);
+    }
+
     class ADCValue   {
     public:
       using value_t = uint32_t;
@@ -952,8 +1235,65 @@ namespace dd4hep {
     }
 
 
+    ///  Dense slot index of a data key
+    /**
+     *  Data keys accessed frequently should be resolved to slots once
+     *  (e.g. when the accessing action is initialized).
+     *  The slot index is identical for all data segments. The segment
+     *  identifier of the key is ignored.
+     *  Segments created after the slot registration give lock-free
+     *  access to the item published to the slot.
+     *  Each registration publishes a new immutable snapshot of the registry.
+     *  Segments keep the snapshot valid at their creation and resolve keys
+     *  to slots without taking any lock.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DataSlot   {
+    public:
+      using index_t = std::uint32_t;
+      /// Immutable snapshot of the registry: (key, slot index) sorted by key
+      using table_t = std::vector<std::pair<Key::key_type, index_t> >;
+      /// Slot index of unregistered keys
+      static constexpr index_t INVALID = ~0x0U;
+
+    private:
+      /// Data key of the slot
+      Key     m_key;
+      /// Dense slot index
+      index_t m_index  { INVALID };
+
+    public:
+      /// Default constructor
+      DataSlot() = default;
+      /// Initializing constructor: register the key (if not yet registered)
+      explicit DataSlot(Key key);
+      /// Copy constructor
+      DataSlot(const DataSlot& copy) = default;
+      /// Assignment operator
+      DataSlot& operator=(const DataSlot& copy) = default;
+      /// Access the data key
+      Key     key()    const     {  return this->m_key;     }
+      /// Access the slot index
+      index_t index()  const     {  return this->m_index;   }
+
+      /// Access the slot index of a registered key. Returns INVALID if the key is not registered
+      static index_t find(Key key);
+      /// Access the slot index of a key in a registry snapshot (lock-free). Returns INVALID if not registered
+      static index_t find(const table_t& table, Key key);
+      /// Number of registered slots
+      static std::size_t count();
+      /// Access the current snapshot of the registry
+      static std::shared_ptr<const table_t> table();
+    };
+
     ///  Data segment definition (locked map)
     /**
+     *  Insertions and removals are locked. Items of keys registered
+     *  as DataSlot are published to the slot table of the segment and
+     *  may be accessed by slot without lock and without map lookup.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -965,8 +1305,27 @@ namespace dd4hep {
       using container_map_t = std::map<Key, std::any>;
       using iterator        = container_map_t::iterator;
       using const_iterator  = container_map_t::const_iterator;
+      using value_type      = container_map_t::value_type;
 
     private:
+      /// Slot table entry. Map nodes are stable: the entry points to the map item
+      struct slot_t   {
+        /// Reference to the map item
+        value_type*           item   { nullptr };
+        /// Typed address of the data (NULL if inserted as std::any)
+        void*                 object { nullptr };
+        /// Type of the data
+        const std::type_info* type   { nullptr };
+        /// Flag set after the entry was filled
+        std::atomic<bool>     valid  { false };
+      };
+      /// Slot table of all slots registered when the segment was created
+      std::unique_ptr<slot_t[]> m_slots;
+      /// Size of the slot table
+      std::size_t               m_num_slots  { 0 };
+      /// Snapshot of the slot registry when the segment was created
+      std::shared_ptr<const DataSlot::table_t> m_slot_keys;
+
       /// Call on failed any-casts
       std::string invalid_cast(Key key, const std::type_info& type)  const;
       /// Call on failed data requests during data requests
@@ -977,6 +1336,19 @@ namespace dd4hep {
       /// Access data item by key  (CONST)
       const std::any* get_item(Key key, bool exc)  const;
 
+      /// Access published slot entry. NULL if not published or if the slot is unknown to the segment
+      const slot_t* get_slot(const DataSlot& slot)  const;
+      /// Slot index of a key known to the segment (lock-free). INVALID if the key has no slot
+      DataSlot::index_t slot_index(Key key)  const;
+      /// Emplace data item and publish it to the slot table (locked)
+      bool emplace_item(Key key, std::any&& data, void* (*address)(std::any*));
+      /// Replace the data of an existing item and republish it to the slot table (locked)
+      bool replace_item(Key key, std::any&& data, void* (*address)(std::any*));
+      /// Typed address of a std::any object
+      template <typename T> static void* any_address(std::any* item)  {
+        return std::any_cast<T>(item);
+      }
+
     public:
       container_map_t   data;
       std::mutex&       lock;
@@ -1008,6 +1380,8 @@ namespace dd4hep {
       }
       /// Move data items other than std::any to the data segment
       template <typename DATA> bool put(Key key, DATA&& data);
+      /// Replace the data of an existing item in place. References to the item stay valid
+      template <typename DATA> bool replace(Key key, DATA&& data);
       /// Remove data item from segment (locked)
       bool erase(Key key);
       /// Remove data items from segment (locked)
@@ -1031,6 +1405,24 @@ namespace dd4hep {
       /// Access data as pointers by key. If not existing, nullptr is returned
       template<typename T> const T* pointer(Key key)  const;
 
+      /** Unlocked slot access (lock-free)   */
+      /// Access data by slot. If not existing, nullptr is returned
+      std::any* entry(const DataSlot& slot);
+      /// Access data by slot. If not existing, nullptr is returned
+      const std::any* entry(const DataSlot& slot)  const;
+      /// Access data item (key and data) by slot. If not existing, nullptr is returned
+      value_type* item(const DataSlot& slot);
+
+      /// Access data as reference by slot. If not existing, an exception is thrown
+      template<typename T> T& get(const DataSlot& slot);
+      /// Access data as reference by slot. If not existing, an exception is thrown
+      template<typename T> const T& get(const DataSlot& slot)  const;
+
+      /// Access data as pointers by slot. If not existing, nullptr is returned
+      template<typename T> T* pointer(const DataSlot& slot);
+      /// Access data as pointers by slot. If not existing, nullptr is returned
+      template<typename T> const T* pointer(const DataSlot& slot)  const;
+
       /// Access container size
       std::size_t size()  const           { return this->data.size();        }
       /// Check container if empty
@@ -1075,12 +1467,58 @@ namespace dd4hep {
       return nullptr;
     }
 
+    /// Access data as pointers by slot. If not existing, nullptr is returned
+    template<typename DATA> inline DATA* DataSegment::pointer(const DataSlot& slot)     {
+      if ( slot.index() < this->m_num_slots )   {
+        const slot_t* s = this->get_slot(slot);
+        if ( s && s->object && (s->type == &typeid(DATA) || *s->type == typeid(DATA)) )
+          return static_cast<DATA*>(s->object);
+        return s ? std::any_cast<DATA>(&s->item->second) : nullptr;
+      }
+      return this->pointer<DATA>(slot.key());
+    }
+    /// Access data as pointers by slot. If not existing, nullptr is returned
+    template<typename DATA> inline const DATA* DataSegment::pointer(const DataSlot& slot)  const   {
+      if ( slot.index() < this->m_num_slots )   {
+        const slot_t* s = this->get_slot(slot);
+        if ( s && s->object && (s->type == &typeid(DATA) || *s->type == typeid(DATA)) )
+          return static_cast<const DATA*>(s->object);
+        return s ? std::any_cast<DATA>(&s->item->second) : nullptr;
+      }
+      return this->pointer<DATA>(slot.key());
+    }
+
+    /// Access data as reference by slot. If not existing, an exception is thrown
+    template<typename DATA> inline DATA& DataSegment::get(const DataSlot& slot)     {
+      if ( DATA* ptr = this->pointer<DATA>(slot) )
+        return *ptr;
+      else if ( this->entry(slot) )
+        throw std::runtime_error(this->invalid_cast(slot.key(), typeid(DATA)));
+      throw std::runtime_error(this->invalid_request(slot.key()));
+    }
+    /// Access data as reference by slot. If not existing, an exception is thrown
+    template<typename DATA> inline const DATA& DataSegment::get(const DataSlot& slot)  const   {
+      if ( const DATA* ptr = this->pointer<DATA>(slot) )
+        return *ptr;
+      else if ( this->entry(slot) )
+        throw std::runtime_error(this->invalid_cast(slot.key(), typeid(DATA)));
+      throw std::runtime_error(this->invalid_request(slot.key()));
+    }
+
     /// Move data items other than std::any to the data segment
     template <typename DATA> inline bool DataSegment::put(Key key, DATA&& value)   {
       key.set_segment(this->id);
       value.key.set_segment(this->id);
       std::any item = std::make_any<DATA>(std::move(value));
-      return this->emplace_any(key, std::move(item));
+      return this->emplace_item(key, std::move(item), any_address<DATA>);
+    }
+
+    /// Replace the data of an existing item in place. References to the item stay valid
+    template <typename DATA> inline bool DataSegment::replace(Key key, DATA&& value)   {
+      key.set_segment(this->id);
+      value.key.set_segment(this->id);
+      std::any item = std::make_any<DATA>(std::move(value));
+      return this->replace_item(key, std::move(item), any_address<DATA>);
     }
 
     /// Helper to place data to data segment
@@ -16,6 +16,10 @@
 // Framework include files
 #include <DDDigi/DigiAction.h>
 
+/// C/C++ include files
+#include <string>
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -37,6 +41,17 @@ namespace dd4hep {
     class DigiEventAction : public DigiAction   {
       friend class DigiKernel;
 
+    public:
+      /// Data item of the event read or written by an action: segment name and mask
+      struct data_item_t  {
+        /// Name of the data segment
+        std::string segment;
+        /// Item mask. ANY_MASK matches all masks of the segment
+        int         mask;
+      };
+      using data_items_t = std::vector<data_item_t>;
+      enum { ANY_MASK = -1 };
+
     protected:
       /// Property: Support parallel execution
       bool               m_parallel    = false;
@@ -57,6 +72,11 @@ namespace dd4hep {
       }      
       /// Set the parallization flag; returns previous value
       bool setExecuteParallel(bool new_value);
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      /** Returns false if the data flow is unknown. Such actions are scheduled as barriers:
+       *  they are executed after all preceeding and before all following actions.
+       */
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const;
       /// Main functional callback
       virtual void execute(DigiContext& context)   const = 0;
     };
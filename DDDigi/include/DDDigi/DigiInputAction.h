@@ -118,6 +118,8 @@ namespace dd4hep {
       /// Check if a event object should be loaded: Default YES unless inhibited by selection or veto
       bool object_loading_is_enabled(const std::string& nam)  const;
 
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Callback to read event input
       virtual void execute(context_t& context)  const override;
     };
@@ -32,6 +32,7 @@ namespace dd4hep {
 
     /// Forward declarations
     class DigiAction;
+    class DigiProfiler;
     class DigiActionSequence;
     
     /// Class, which allows all DigiAction derivatives to access the DDG4 kernel structures.
@@ -63,6 +64,10 @@ namespace dd4hep {
       
       /// Execute one single event
       virtual void executeEvent(std::unique_ptr<DigiContext>&& context);
+      /// Execute the output actions of one single event and release the event
+      void finishEvent(std::unique_ptr<DigiContext>&& context);
+      /// Write events in the order of the event numbers using a reorder buffer
+      void writeOrdered(int event_number, std::unique_ptr<DigiContext>&& context);
       /// Notify kernel that the execution of one single event finished
       void notify(std::unique_ptr<DigiContext>&& context);
       /// Notify kernel that the execution of one single event finished
@@ -93,6 +98,12 @@ namespace dd4hep {
         m_userFramework = UserFramework(object,&typeid(T));
       }
 
+      /// Access the seed of the counter based random streams
+      std::uint64_t random_seed()  const;
+
+      /// Access the timing instrumentation. Returns null if disabled
+      DigiProfiler* profiler()  const;
+
       /// Have a shared initializer lock
       std::mutex& initializer_lock()  const;
 
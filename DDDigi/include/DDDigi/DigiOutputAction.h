@@ -91,6 +91,8 @@ namespace dd4hep {
       virtual void adopt_processor(DigiContainerProcessor* action,
                                    const std::vector<std::string>& containers)  override;
 
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Callback to read event output
       virtual void execute(context_t& context)  const override;
     };
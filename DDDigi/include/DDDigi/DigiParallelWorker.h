@@ -23,6 +23,7 @@ namespace dd4hep {
   namespace digi {
 
     /// Forward declarations
+    class DigiAction;
     class WorkerPredicate;
 
     /// Wrapper class to submit bulk actions
@@ -41,6 +42,8 @@ namespace dd4hep {
       ParallelWorker& operator=(ParallelWorker&& copy) = default;
       ParallelWorker& operator=(const ParallelWorker& copy) = default;
       virtual ~ParallelWorker() = default;
+      /// Access to the action executing the work (used for monitoring)
+      virtual const DigiAction* worker_action()  const  {  return nullptr;  }
       virtual void execute(void* args) const = 0;
     };
 
@@ -80,6 +83,8 @@ namespace dd4hep {
     virtual ~DigiParallelWorker();
     /// Access to processor name
     const char* name()  const {  return action->name().c_str();   }
+    /// Access to the action executing the work (used for monitoring)
+    virtual const DigiAction* worker_action()  const override  {  return action;  }
     /// Callback on data
     virtual void execute(void* data) const override;
     };
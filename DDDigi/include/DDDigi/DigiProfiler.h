@@ -0,0 +1,195 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIPROFILER_H
+#define DDDIGI_DIGIPROFILER_H
+
+/// Framework include files
+#include <DDDigi/DigiAction.h>
+
+/// C/C++ include files
+#include <any>
+#include <map>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <chrono>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Timing and throughput instrumentation of the digitization actions
+    /**
+     *  Probes are placed around the execution of actions and parallel
+     *  workers (see DigiKernel::submit). Each probe measures the wall and
+     *  the CPU time of the call. The exclusive time excludes nested probes
+     *  on the same thread and the time spent waiting for submitted workers.
+     *  Calls of the workers of an action are accounted separately.
+     *
+     *  The counters are kept per thread and are only accessed by the owning
+     *  thread. No locks are taken while processing events: the counters
+     *  are aggregated when the statistics are saved at termination.
+     *
+     *  At termination a summary table is printed, one histogram per
+     *  quantity (bins labelled by action) is handed to the monitor handler
+     *  (see property MonitorOutput of the kernel) and if requested the
+     *  calls are written as Chrome trace events (chrome://tracing, perfetto)
+     *  to a JSON file.
+     *
+     *  The profiler is disabled by default. It is steered by the kernel
+     *  properties "Profile" and "ProfileTrace".
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiProfiler : public DigiAction {
+    public:
+      using clock_t = std::chrono::steady_clock;
+
+      /// Accumulated counters of one action
+      class counters_t  {
+      public:
+        /// Action name
+        std::string name            { };
+        /// Number of calls
+        std::size_t calls           { 0 };
+        /// Inclusive wall time in seconds
+        double      wall_inclusive  { 0e0 };
+        /// Exclusive wall time in seconds
+        double      wall_exclusive  { 0e0 };
+        /// Inclusive CPU time in seconds
+        double      cpu_inclusive   { 0e0 };
+        /// Exclusive CPU time in seconds
+        double      cpu_exclusive   { 0e0 };
+        /// Number of processed deposits
+        std::size_t items           { 0 };
+        /// Number of bytes moved
+        std::size_t bytes           { 0 };
+        /// Add the counters of another thread
+        void add(const counters_t& other);
+      };
+
+      /// Chrome trace event of one call
+      class trace_t  {
+      public:
+        /// Key of the counters
+        std::pair<const DigiAction*, bool> key;
+        /// Event number
+        int         event;
+        /// Start time in micro seconds since the profiler was created
+        double      start;
+        /// Duration in micro seconds
+        double      duration;
+      };
+
+      /// Counters and trace events of one thread
+      class thread_data_t  {
+      public:
+        /// Thread index for the trace output
+        int id  { 0 };
+        /// Counters by action and the flag if the call was a worker call
+        std::map<std::pair<const DigiAction*, bool>, counters_t> counters { };
+        /// Trace events
+        std::vector<trace_t> trace { };
+      };
+
+      /// Measurement of one call. Probes of the same thread nest.
+      /**
+       *  Probes are used as automatic objects. If the profiler is not given,
+       *  the probe does nothing. Probes without action are not recorded:
+       *  they only exclude the enclosed time from the enclosing probe.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_DIGITIZATION
+       */
+      class probe_t  {
+        friend class DigiProfiler;
+        DigiProfiler*      profiler    { nullptr };
+        thread_data_t*     data        { nullptr };
+        probe_t*           parent      { nullptr };
+        const DigiAction*  action      { nullptr };
+        bool               worker      { false };
+        int                event       { 0 };
+        clock_t::time_point start      { };
+        double             cpu_start   { 0e0 };
+        double             child_wall  { 0e0 };
+        double             child_cpu   { 0e0 };
+        std::size_t        items       { 0 };
+        std::size_t        bytes       { 0 };
+
+      public:
+        /// Initializing constructor: start the measurement
+        probe_t(DigiProfiler* profiler, const DigiAction* action, bool worker, int event);
+        /// Inhibit move constructor
+        probe_t(probe_t&& copy) = delete;
+        /// Inhibit copy constructor
+        probe_t(const probe_t& copy) = delete;
+        /// Inhibit move assignment
+        probe_t& operator=(probe_t&& copy) = delete;
+        /// Inhibit copy assignment
+        probe_t& operator=(const probe_t& copy) = delete;
+        /// Default destructor: stop the measurement and record the call
+        ~probe_t();
+      };
+
+    protected:
+      /// Property: Enable the instrumentation
+      bool                       m_enable       { false };
+      /// Property: Name of the Chrome trace output file (empty: no trace)
+      std::string                m_trace_file   { };
+
+      /// Start time of the profiler: reference of the trace events
+      clock_t::time_point        m_start        { clock_t::now() };
+      /// Unique identifier of this instance to validate the thread local caches
+      std::size_t                m_instance     { 0 };
+      /// Lock to protect the registration of new threads
+      std::mutex                 m_lock         { };
+      /// Data of all threads, which executed probes
+      std::vector<std::unique_ptr<thread_data_t> > m_threads { };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiProfiler);
+
+      /// Access the data of the current thread
+      thread_data_t* thread_data();
+      /// Aggregate the counters of all threads
+      std::map<std::pair<const DigiAction*, bool>, counters_t> aggregate()  const;
+      /// Write the Chrome trace file
+      void write_trace()  const;
+
+    public:
+      /// Standard constructor
+      DigiProfiler(const kernel_t& kernel, const std::string& nam);
+      /// Default destructor
+      virtual ~DigiProfiler();
+      /// Check if the instrumentation is enabled
+      bool enabled()  const   {
+        return m_enable;
+      }
+      /// Access the action of the innermost probe of the current thread
+      static const DigiAction* current_action();
+      /// Add processed deposits and moved bytes to the innermost probe of the current thread
+      static void count(std::size_t items, std::size_t bytes);
+      /// Add the deposits of a container to the innermost probe of the current thread
+      static void count(const std::any& container);
+      /// Print the summary, register the monitor histograms and write the trace file
+      void save();
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIPROFILER_H
@@ -34,6 +34,11 @@ namespace dd4hep {
 
     /// Base class for input actions to the digitization using ROOT
     /**
+     *  If the property 'prefetch' is set to a positive value K, a dedicated
+     *  I/O thread reads, decompresses and converts the next K events ahead
+     *  of time into a bounded queue. The event tasks then only move the
+     *  ready data items to the input segment of the event.
+     *  Otherwise the branches are read synchronously inside the event task.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -60,6 +65,8 @@ namespace dd4hep {
 
 
     protected:
+      /// Property: Number of events to be prefetched by the I/O thread (0: no prefetching)
+      int m_prefetch_depth { 0 };
       /// Connection parameters to the "current" input source
       mutable std::unique_ptr<internals_t> imp;
 
@@ -72,6 +79,8 @@ namespace dd4hep {
       DigiROOTInput(const DigiKernel& kernel, const std::string& nam);
       /// Default destructor
       virtual ~DigiROOTInput();
+      /// Finalization callback: stop the I/O thread and print the prefetch statistics
+      virtual void finalize();
 
       /// Callback to read event input
       virtual void execute(DigiContext& context)  const override;
@@ -0,0 +1,119 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIRANDOMSTREAM_H
+#define DDDIGI_DIGIRANDOMSTREAM_H
+
+/// Framework include files
+
+/// C/C++ include files
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Counter based random number stream with bulk generation of variates
+    /**
+     *  The stream uses the Philox-4x32-10 bijection (Salmon et al., SC'11):
+     *  the n-th block of 4 random words is a pure function of the key
+     *  (the seed) and the counter (block number and stream identifier).
+     *  Hence a stream is defined by the seed and the stream identifier alone
+     *  and does not depend on the order or the thread other streams are
+     *  processed. Typically the seed is derived from the event and the stream
+     *  identifier from the cell or container key.
+     *
+     *  The bulk functions fill buffers of N variates. Blocks are generated
+     *  in loops without dependencies between iterations, which the compiler
+     *  may vectorize. Gaussian variates are generated using the Box-Muller
+     *  transformation.
+     *
+     *  Uniform variates are in the interval ] 0, 1 ] with 53 bits resolution.
+     *  The bulk and the scalar functions consume the same sequence of
+     *  uniforms: generating N values at once or in pieces gives the same
+     *  result (for gaussians if the pieces have an even length).
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiRandomStream  {
+    public:
+      using block_t = std::array<std::uint32_t, 4>;
+      using key_t   = std::array<std::uint32_t, 2>;
+
+    protected:
+      /// Philox key (seed)
+      key_t         m_key     { };
+      /// Stream identifier (upper half of the counter)
+      std::uint64_t m_stream  { 0 };
+      /// Number of the next block to be generated (lower half of the counter)
+      std::uint64_t m_block   { 0 };
+      /// Cached second uniform of the last block
+      double        m_cache   { 0e0 };
+      /// Flag if the cached uniform is valid
+      bool          m_cached  { false };
+
+      /// Generate 2*num_blocks uniforms starting at the current block
+      void i_fill_blocks(double* values, std::size_t num_blocks);
+
+    public:
+      /// Initializing constructor
+      DigiRandomStream(std::uint64_t seed, std::uint64_t stream);
+      /// Default constructor
+      DigiRandomStream() = default;
+      /// Default move constructor
+      DigiRandomStream(DigiRandomStream&& copy) = default;
+      /// Default copy constructor
+      DigiRandomStream(const DigiRandomStream& copy) = default;
+      /// Default destructor
+      virtual ~DigiRandomStream() = default;
+      /// Default move assignment
+      DigiRandomStream& operator=(DigiRandomStream&& copy) = default;
+      /// Default copy assignment
+      DigiRandomStream& operator=(const DigiRandomStream& copy) = default;
+
+      /// Philox-4x32-10 bijection of one counter block
+      static block_t philox(block_t counter, key_t key);
+      /// Combine two keys (e.g. run seed and event number) to a new seed
+      static std::uint64_t combine(std::uint64_t first, std::uint64_t second);
+
+      /// Access the stream identifier
+      std::uint64_t stream()  const      {  return m_stream;   }
+      /// Position the stream at a given block number. Each block provides 2 uniforms
+      void seek(std::uint64_t block);
+
+      /// Single uniform variate in ] 0, 1 ]
+      double uniform();
+      /// Single gaussian variate
+      double gaussian(double mean = 0.0, double sigma = 1.0);
+
+      /// Fill buffer with uniform variates in ] 0, 1 ]
+      void uniform(double* values, std::size_t num);
+      /// Fill buffer with uniform variates in ] x1, x2 ]
+      void uniform(double* values, std::size_t num, double x1, double x2);
+      /// Fill buffer with exponential variates
+      void exponential(double* values, std::size_t num, double tau);
+      /// Fill buffer with gaussian variates (Box-Muller)
+      void gaussian(double* values, std::size_t num, double mean = 0.0, double sigma = 1.0);
+      /// Fill buffer with landau variates
+      void landau(double* values, std::size_t num, double mean = 0.0, double sigma = 1.0);
+      /// Fill buffer with poisson variates
+      void poisson(double* values, std::size_t num, double mean);
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIRANDOMSTREAM_H
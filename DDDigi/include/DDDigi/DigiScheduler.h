@@ -0,0 +1,142 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGISCHEDULER_H
+#define DDDIGI_DIGISCHEDULER_H
+
+/// Framework include files
+#include <DDDigi/DigiEventAction.h>
+
+/// C/C++ include files
+#include <mutex>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Forward declarations
+    class DigiKernel;
+    class DigiContext;
+    class DigiActionSequence;
+
+    /// Data flow scheduler of the event actions
+    /**
+     *  The actions of the kernel's sequences are the nodes of a directed
+     *  acyclic graph. An action depends on a preceeding action if one of
+     *  them writes a data item the other reads or writes
+     *  (see DigiEventAction::data_flow). Actions with unknown data flow
+     *  are barriers.
+     *
+     *  Per event every action is executed as a task as soon as all
+     *  actions it depends on finished. Independent actions run concurrently.
+     *  Since the tasks of all events in flight share the same thread pool,
+     *  the actions of different events interleave.
+     *
+     *  The scheduler accumulates the wall time of each action and the
+     *  critical path of the graph (the longest chain of dependent actions)
+     *  for each event. The ratio of the summed execution time to the
+     *  critical path bounds the achievable speedup per event.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiScheduler  {
+    public:
+      /// Node of the data flow graph
+      class node_t  {
+      public:
+        /// Reference to the action
+        DigiEventAction*              action       { nullptr };
+        /// Data items read by the action
+        DigiEventAction::data_items_t inputs       { };
+        /// Data items written by the action
+        DigiEventAction::data_items_t outputs      { };
+        /// Nodes this node depends on
+        std::vector<std::size_t>      predecessors { };
+        /// Nodes depending on this node
+        std::vector<std::size_t>      successors   { };
+        /// Flag if the data flow of the action is known
+        bool                          declared     { false };
+      };
+
+      /// Execution statistics of one node
+      class node_stat_t  {
+      public:
+        /// Accumulated wall time in seconds
+        double      time   { 0e0 };
+        /// Maximal wall time in seconds
+        double      max    { 0e0 };
+        /// Number of calls
+        std::size_t calls  { 0 };
+      };
+
+    protected:
+      class event_t;
+
+      /// Reference to the kernel
+      const DigiKernel&         m_kernel;
+      /// Nodes of the graph in the order of the sequences (topological order)
+      std::vector<node_t>       m_nodes         { };
+      /// Lock to protect the statistics
+      mutable std::mutex        m_stat_lock     { };
+      /// Monitoring: statistics per node
+      mutable std::vector<node_stat_t> m_stat   { };
+      /// Monitoring: number of scheduled events
+      mutable std::size_t       m_num_events    { 0 };
+      /// Monitoring: accumulated wall time of the scheduled events
+      mutable double            m_wall_time     { 0e0 };
+      /// Monitoring: accumulated execution time of all actions
+      mutable double            m_serial_time   { 0e0 };
+      /// Monitoring: accumulated critical path length
+      mutable double            m_critical_path { 0e0 };
+      /// Monitoring: maximal critical path length
+      mutable double            m_max_critical_path { 0e0 };
+
+      /// Check if the second node must be executed after the first node
+      static bool depends(const node_t& first, const node_t& second);
+      /// Execute one node and submit the successors which are ready
+      void execute_node(event_t& event, std::size_t node)  const;
+
+    public:
+      /// Initializing constructor
+      DigiScheduler(const DigiKernel& kernel);
+      /// Inhibit move constructor
+      DigiScheduler(DigiScheduler&& copy) = delete;
+      /// Inhibit copy constructor
+      DigiScheduler(const DigiScheduler& copy) = delete;
+      /// Inhibit move assignment
+      DigiScheduler& operator=(DigiScheduler&& copy) = delete;
+      /// Inhibit copy assignment
+      DigiScheduler& operator=(const DigiScheduler& copy) = delete;
+      /// Default destructor
+      virtual ~DigiScheduler();
+
+      /// Number of nodes in the graph
+      std::size_t size()  const   {
+        return m_nodes.size();
+      }
+      /// Add the actions of a sequence to the graph
+      void add(const DigiActionSequence& sequence);
+      /// Build the dependencies of the graph
+      void build();
+      /// Execute all actions of one event according to their dependencies
+      void execute(DigiContext& context)  const;
+      /// Print the execution statistics
+      void print_statistics()  const;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGISCHEDULER_H
@@ -77,6 +77,8 @@ namespace dd4hep {
     public:
       /// Standard constructor
       DigiStoreDump(const DigiKernel& kernel, const std::string& nam);
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Main functional callback
       virtual void execute(context_t& context)  const;
     };
@@ -54,6 +54,10 @@ namespace dd4hep {
       virtual ~DigiSynchronize();
       /// Adopt a new action as part of the sequence. Sequence takes ownership.
       virtual void adopt(DigiEventAction* action);
+      /// Access the adopted actions in the order of adoption
+      std::vector<DigiEventAction*> actors()  const;
+      /// Data flow of the sequence: union of the data items of all adopted actions
+      virtual bool data_flow(data_items_t& inputs, data_items_t& outputs)  const override;
       /// Begin-of-event callback
       virtual void execute(context_t& context)  const override;
     };
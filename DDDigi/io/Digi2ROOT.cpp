@@ -29,6 +29,18 @@ namespace dd4hep {
      *  - MCParticles aka "MCParticles"
      *  - EnergyDeposits
      *
+     *  By default all events are filled into one single TTree under the
+     *  global I/O lock. If the property "parallel_output" is set, each
+     *  event is filled into the TTree of a free output slot without
+     *  taking the lock. The slots are in-memory files of a ROOT TBufferMerger.
+     *  Once a slot collected "cluster_size" events, the compressed cluster
+     *  is handed to the merger, which appends it to the output file.
+     *  In this mode the events are not written in the order of processing
+     *  and the output is not split into sequence streams.
+     *
+     *  The compression of the output file is steered by the properties
+     *  "compression_algorithm" (ZLIB, LZMA, LZ4, ZSTD) and "compression_level".
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_DIGITIZATION
@@ -52,6 +64,8 @@ namespace dd4hep {
       Digi2ROOTWriter(const kernel_t& kernel, const std::string& nam);
       /// Initialization callback
       virtual void initialize()  override;
+      /// Callback to write the event data
+      virtual void execute(context_t& context)  const override;
       /// Check for valid output stream
       virtual bool have_output()  const  override final;
       /// Open new output stream
@@ -121,8 +135,14 @@ namespace dd4hep {
 #include <TROOT.h>
 #include <TClass.h>
 #include <TBranch.h>
+#include <RVersion.h>
+#include <ROOT/TBufferMerger.hxx>
 
+/// C/C++ include files
+#include <mutex>
+#include <atomic>
 #include <vector>
+#include <algorithm>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -132,6 +152,13 @@ namespace dd4hep {
 
     using persistent_particles_t = std::vector<std::pair<Key::key_type, Particle*> >;
     using persistent_deposits_t  = std::vector<std::pair<CellID, EnergyDeposit*> >;
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+    using merger_t      = ROOT::TBufferMerger;
+    using merger_file_t = ROOT::TBufferMergerFile;
+#else
+    using merger_t      = ROOT::Experimental::TBufferMerger;
+    using merger_file_t = ROOT::Experimental::TBufferMergerFile;
+#endif
 
     /// Helper class to create output in edm4hep format
     /** Helper class to create output in edm4hep format
@@ -159,6 +186,18 @@ namespace dd4hep {
       };
       typedef std::map<std::string, BranchWrapper> Collections;
 
+      /// Output slot of the parallel mode: in-memory file with its own event tree
+      struct Slot   {
+        /// Buffered in-memory file of the merger
+        std::shared_ptr<merger_file_t> file;
+        /// Event tree of the slot
+        TTree*                   tree         { nullptr };
+        /// Collections in the event tree of the slot
+        Collections              collections  { };
+        /// Number of events in the current cluster
+        long                     entries      { 0 };
+      };
+
       /// Reference to the parent
       Digi2ROOTWriter*         m_parent       { nullptr };
       /// Collections in the event tree
@@ -175,10 +214,37 @@ namespace dd4hep {
       Int_t                    m_basket_size  { 32000 };
       /// Default split level
       Int_t                    m_split_level  {    99 };
+      /// Property: compression algorithm of the output file (empty: ROOT default)
+      std::string              m_compression_algorithm { };
+      /// Property: compression level of the output file (negative: ROOT default)
+      int                      m_compression_level     { -1 };
+      /// Property: flag to fill the events in parallel into the slots of a buffer merger
+      bool                     m_parallel_output       { false };
+      /// Property: number of events per slot before the cluster is handed to the merger
+      long                     m_cluster_size          { 100 };
+
+      /// Buffer merger writing the output file in parallel mode
+      std::unique_ptr<merger_t> m_merger  { };
+      /// Name of the output file written by the merger
+      std::string              m_merger_output { };
+      /// Lock to protect the slots of the parallel mode
+      std::mutex               m_slot_lock    { };
+      /// All slots of the parallel mode
+      std::vector<std::unique_ptr<Slot> > m_slots { };
+      /// Slots currently not used by any event
+      std::vector<Slot*>       m_free_slots   { };
+      /// Number of clusters handed to the merger
+      std::atomic<long>        m_num_clusters { 0 };
 
     private:
       /// Helper to register single collection
-      template <typename T> T* register_collection(const std::string& name, T* collection);
+      template <typename T> T* register_collection(Collections& collections, const std::string& name, T* collection);
+      /// Create the branches of all collections in the event tree
+      void create_branches(TTree* tree, Collections& collections);
+      /// Release the branches and the collections of an event tree
+      void release_collections(Collections& collections);
+      /// Compression setting of the output file
+      int compression()  const;
 
     public:
       /// Default constructor
@@ -194,13 +260,25 @@ namespace dd4hep {
       void commit();
 
       /// Create all collections according to the parent setup (locked)
-      void create_collections();
+      void create_collections(Collections& collections);
       /// Clear collection content: Store is still owner!
-      void clearCollections();
+      void clearCollections(Collections& collections);
       /// Access named collection: throws exception ifd the collection is not present (unlocked!)
       template <typename T> BranchWrapper& get_collection(const T&);
+
+      /// Parallel mode: attach a free slot to the calling thread
+      Slot* acquire_slot();
+      /// Parallel mode: fill the event into the slot and detach it from the calling thread
+      void release_slot(Slot* slot, bool commit);
+      /// Parallel mode: hand the cluster of the slot to the merger
+      void flush_slot(Slot& slot);
     };
 
+    namespace {
+      /// Output slot attached to the calling thread in parallel mode
+      thread_local Digi2ROOTWriter::internals_t::Slot* s_current_slot { nullptr };
+    }
+
     template <typename T> void Digi2ROOTWriter::internals_t::BranchWrapper::set(T* ptr)   {
       clazz     = gROOT->GetClass(typeid(*ptr), kTRUE);
       branch    = nullptr;
@@ -217,7 +295,7 @@ namespace dd4hep {
     /// Default destructor
     Digi2ROOTWriter::internals_t::~internals_t()    {
       m_parent->info("Releasing allocated resources.");
-      if ( m_file ) close();
+      if ( m_file || m_merger ) close();
       for( auto& coll : m_collections )   {
 	coll.second.clear();
 	coll.second.del();
@@ -225,25 +303,25 @@ namespace dd4hep {
       m_collections.clear();
     }
 
-    template <typename T> T* Digi2ROOTWriter::internals_t::register_collection(const std::string& nam, T* coll)   {
+    template <typename T> T* Digi2ROOTWriter::internals_t::register_collection(Collections& colls, const std::string& nam, T* coll)   {
       BranchWrapper bw;
       bw.set(coll);
-      m_collections.emplace(nam, bw);
+      colls.emplace(nam, bw);
       m_parent->debug("+++ created collection %s <%s>", nam.c_str(), typeName(typeid(T)).c_str());
       return coll;
     }
 
     /// Create all collections according to the parent setup
-    void Digi2ROOTWriter::internals_t::create_collections()    {
-      if ( m_collections.empty() )   {
+    void Digi2ROOTWriter::internals_t::create_collections(Collections& colls)    {
+      if ( colls.empty() )   {
         for( auto& cont : m_parent->m_containers )   {
           const std::string& nam = cont.first;
           const std::string& typ = cont.second;
           if ( typ == "MCParticles" )   {
-            register_collection(nam, new persistent_particles_t());
+            register_collection(colls, nam, new persistent_particles_t());
 	  }
           else   {
-            register_collection(nam, new persistent_deposits_t());
+            register_collection(colls, nam, new persistent_deposits_t());
 	  }
         }
       }
@@ -252,17 +330,61 @@ namespace dd4hep {
     /// Access named collection: throws exception ifd the collection is not present
     template <typename T> 
     Digi2ROOTWriter::internals_t::BranchWrapper& Digi2ROOTWriter::internals_t::get_collection(const T& cont)  {
-      auto iter = m_collections.find(cont.name);
-      if ( iter == m_collections.end() )    {
+      Collections& colls = s_current_slot ? s_current_slot->collections : m_collections;
+      auto iter = colls.find(cont.name);
+      if ( iter == colls.end() )    {
         m_parent->except("Error");
       }
       return iter->second;
     }
 
     /// Clear collection content: Store is still owner!
-    void Digi2ROOTWriter::internals_t::clearCollections()   {
-      for( auto& coll : m_collections )
+    void Digi2ROOTWriter::internals_t::clearCollections(Collections& colls)   {
+      for( auto& coll : colls )
+	coll.second.clear();
+    }
+
+    /// Create the branches of all collections in the event tree
+    void Digi2ROOTWriter::internals_t::create_branches(TTree* tree, Collections& colls)   {
+      for( auto& coll : colls )    {
+	auto& dsc = coll.second;
+	dsc.branch = tree->Branch(coll.first.c_str(),
+				  dsc.clazz->GetName(),
+				  &dsc.address,
+				  m_basket_size,
+				  m_split_level);
+	dsc.branch->SetAutoDelete(kFALSE);
+      }
+    }
+
+    /// Release the branches and the collections of an event tree
+    void Digi2ROOTWriter::internals_t::release_collections(Collections& colls)   {
+      for( auto& coll : colls )   {
+	if ( coll.second.branch ) coll.second.branch->ResetAddress();
+	coll.second.branch = nullptr;
 	coll.second.clear();
+	coll.second.del();
+      }
+      colls.clear();
+    }
+
+    /// Compression setting of the output file
+    int Digi2ROOTWriter::internals_t::compression()  const   {
+      /// Algorithm codes of ROOT::RCompressionSetting::EAlgorithm
+      static const std::map<std::string, int> algorithms = {
+	{ "",     0 }, { "GLOBAL", 0 }, { "ZLIB", 1 }, { "LZMA", 2 }, { "LZ4", 4 }, { "ZSTD", 5 }
+      };
+      if ( m_compression_level < 0 && m_compression_algorithm.empty() )   {
+	return -1;
+      }
+      auto iter = algorithms.find(m_compression_algorithm);
+      if ( iter == algorithms.end() )   {
+	m_parent->except("+++ Unknown compression algorithm: %s [ZLIB, LZMA, LZ4, ZSTD]",
+			 m_compression_algorithm.c_str());
+      }
+      /// ROOT compression setting: 100 * algorithm + level
+      int level = m_compression_level < 0 ? 4 : std::min(m_compression_level, 9);
+      return 100 * iter->second + level;
     }
 
     /// Open output file
@@ -270,25 +392,57 @@ namespace dd4hep {
       if ( m_file )   {
 	close();
       }
+      if ( m_merger )   {
+	close();
+      }
+      int compress = compression();
       std::string fname = m_parent->next_stream_name();
-      m_file.reset(TFile::Open(fname.c_str(), "RECREATE", "DDDigi data"));
+      if ( m_parallel_output )   {
+	if ( m_cluster_size <= 0 )   {
+	  m_parent->except("+++ Invalid cluster size: %ld", m_cluster_size);
+	}
+	ROOT::EnableThreadSafety();
+	if ( compress < 0 )
+	  m_merger = std::make_unique<merger_t>(fname.c_str(), "RECREATE");
+	else
+	  m_merger = std::make_unique<merger_t>(fname.c_str(), "RECREATE", compress);
+	m_merger_output = fname;
+	m_num_clusters = 0;
+	m_parent->info("+++ Opened ROOT output file %s [parallel, %ld events per cluster]",
+		       fname.c_str(), m_cluster_size);
+	return;
+      }
+      if ( compress < 0 )
+	m_file.reset(TFile::Open(fname.c_str(), "RECREATE", "DDDigi data"));
+      else
+	m_file.reset(TFile::Open(fname.c_str(), "RECREATE", "DDDigi data", compress));
       m_tree = new TTree(m_section.c_str(), "DDDigi data", m_split_level, m_file.get());
       m_parent->info("+++ Opened ROOT output file %s", m_file->GetName());
-      for( auto& coll : m_collections )    {
-	auto& dsc = coll.second;
-	dsc.branch = m_tree->Branch(coll.first.c_str(),
-				    dsc.clazz->GetName(),
-				    &dsc.address,
-				    m_basket_size,
-				    m_split_level);
-	dsc.branch->SetAutoDelete(kFALSE);
-      }
+      create_branches(m_tree, m_collections);
       m_parent->info("+++ Will save %ld events to %s",
 		     m_parent->num_events, m_parent->m_output.c_str());
     }
 
     /// Commit data to disk and close output stream
     void Digi2ROOTWriter::internals_t::close()   {
+      if ( m_merger )   {
+	std::lock_guard<std::mutex> lock(m_slot_lock);
+	if ( m_free_slots.size() != m_slots.size() )   {
+	  m_parent->except("+++ Cannot close the output file: %ld slots are in use.",
+			   m_slots.size() - m_free_slots.size());
+	}
+	for( auto& slot : m_slots )   {
+	  flush_slot(*slot);
+	  release_collections(slot->collections);
+	  slot->file.reset();
+	}
+	m_slots.clear();
+	m_free_slots.clear();
+	/// The merger writes the remaining clusters when it is destroyed
+	m_merger.reset();
+	m_parent->info("+++ Closing ROOT output file %s after %ld events in %ld clusters",
+		       m_merger_output.c_str(), m_parent->event_count, m_num_clusters.load());
+      }
       if ( m_file )    {
 	TDirectory::TContext ctxt(m_file.get());
 	m_parent->info("+++ Closing ROOT output file %s after %ld events and %ld bytes",
@@ -308,7 +462,7 @@ namespace dd4hep {
     void Digi2ROOTWriter::internals_t::commit()   {
       if ( m_tree )   {
 	m_tree->Fill();
-        clearCollections();
+        clearCollections(m_collections);
 	++m_parent->event_count;
 	if ( m_parent->m_sequence_streams )  {
 	  if ( 0 == (m_parent->event_count%m_parent->num_events) )  {
@@ -320,6 +474,56 @@ namespace dd4hep {
       m_parent->except("+++ Failed to write output file. [Stream is not open]");
     }
 
+    /// Parallel mode: attach a free slot to the calling thread
+    Digi2ROOTWriter::internals_t::Slot* Digi2ROOTWriter::internals_t::acquire_slot()   {
+      std::lock_guard<std::mutex> lock(m_slot_lock);
+      if ( !m_merger )   {
+	m_parent->except("+++ Failed to write output file. [Stream is not open]");
+      }
+      Slot* slot = nullptr;
+      if ( m_free_slots.empty() )   {
+	auto new_slot = std::make_unique<Slot>();
+	new_slot->file = m_merger->GetFile();
+	new_slot->tree = new TTree(m_section.c_str(), "DDDigi data", m_split_level, new_slot->file.get());
+	create_collections(new_slot->collections);
+	create_branches(new_slot->tree, new_slot->collections);
+	slot = new_slot.get();
+	m_slots.emplace_back(std::move(new_slot));
+	m_parent->debug("+++ Created output slot %ld", m_slots.size());
+      }
+      else   {
+	slot = m_free_slots.back();
+	m_free_slots.pop_back();
+      }
+      s_current_slot = slot;
+      return slot;
+    }
+
+    /// Parallel mode: fill the event into the slot and detach it from the calling thread
+    void Digi2ROOTWriter::internals_t::release_slot(Slot* slot, bool commit)   {
+      s_current_slot = nullptr;
+      /// Filling and compressing the cluster happens outside the lock
+      if ( commit )   {
+	slot->tree->Fill();
+	if ( ++slot->entries >= m_cluster_size )   {
+	  flush_slot(*slot);
+	}
+      }
+      clearCollections(slot->collections);
+      std::lock_guard<std::mutex> lock(m_slot_lock);
+      if ( commit ) ++m_parent->event_count;
+      m_free_slots.emplace_back(slot);
+    }
+
+    /// Parallel mode: hand the cluster of the slot to the merger
+    void Digi2ROOTWriter::internals_t::flush_slot(Slot& slot)   {
+      if ( slot.entries > 0 )   {
+	slot.file->Write();
+	slot.entries = 0;
+	++m_num_clusters;
+      }
+    }
+
     /// Standard constructor
     Digi2ROOTWriter::Digi2ROOTWriter(const DigiKernel& krnl, const std::string& nam)
       : DigiOutputAction(krnl, nam)
@@ -328,6 +532,10 @@ namespace dd4hep {
       m_processor_type = "Digi2ROOTProcessor";
       declareProperty("basket_size",    internals->m_basket_size);
       declareProperty("split_level",    internals->m_split_level);
+      declareProperty("compression_algorithm", internals->m_compression_algorithm);
+      declareProperty("compression_level",     internals->m_compression_level);
+      declareProperty("parallel_output",       internals->m_parallel_output);
+      declareProperty("cluster_size",          internals->m_cluster_size);
       InstanceCount::increment(this);
     }
 
@@ -349,12 +557,36 @@ namespace dd4hep {
 	except("Error: Invalid processor type for ROOT output: %s", c.second->c_name());
       }
       m_parallel = false;
-      internals->create_collections();
+      internals->create_collections(internals->m_collections);
+    }
+
+    /// Callback to write the event data
+    void Digi2ROOTWriter::execute(DigiContext& context)  const   {
+      if ( !internals->m_parallel_output )   {
+	this->DigiOutputAction::execute(context);
+	return;
+      }
+      {
+	std::lock_guard<std::mutex> lock(context.global_io_lock());
+	if ( !have_output() )   {
+	  open_output();
+	}
+      }
+      /// The processors fill the collections of the slot attached to this thread
+      auto* slot = internals->acquire_slot();
+      try   {
+	this->DigiContainerSequenceAction::execute(context);
+      }
+      catch(...)   {
+	internals->release_slot(slot, false);
+	throw;
+      }
+      internals->release_slot(slot, true);
     }
 
     /// Check for valid output stream
     bool Digi2ROOTWriter::have_output()  const  {
-      return internals->m_file.get() != nullptr;
+      return internals->m_file.get() != nullptr || internals->m_merger.get() != nullptr;
     }
 
     /// Open new output stream
@@ -30,6 +30,11 @@ namespace dd4hep {
 
     /// DDDigi input reader for DDG4 native ROOT output
     /**
+     *  If the property "deposit_view" is set, the hit collections are not
+     *  converted to deposit vectors. The hits are kept in the input segment
+     *  and are accessed through a DepositView. An EnergyDeposit is only
+     *  created when a processor modifies a deposit or when the containers
+     *  are combined.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -41,6 +46,8 @@ namespace dd4hep {
       TClass* m_trackerHitClass { nullptr };
       TClass* m_caloHitClass    { nullptr };
       TClass* m_particlesClass  { nullptr };
+      /// Property: keep the DDG4 hits and access them through a deposit view
+      bool    m_deposit_view    { false };
 
     public:
       /// Initializing constructor
@@ -51,6 +58,33 @@ namespace dd4hep {
 	assert(m_particlesClass != 0);
 	assert(m_trackerHitClass != 0);
 	assert(m_caloHitClass != 0);
+	declareProperty("deposit_view", m_deposit_view);
+      }
+
+      /// Keep DDG4 hit collection and access it through a deposit view
+      template <typename T>
+      void view_dd4g4(DigiContext& context,
+		      DataSegment& segment,
+		      const std::string& tag,
+		      Key::mask_type mask,
+		      const char* nam,
+		      void* ptr)   const
+      {
+	using hits_t = std::vector<std::unique_ptr<T> >;
+	auto hits = std::make_shared<hits_t>();
+	std::size_t len = 0;
+	if ( ptr )   {
+	  input_data<T> data(ptr);
+	  const DepositPredicate<EnergyCut> predicate ({ this->epsilon });
+	  len = data.size();
+	  data_io<ddg4_input>::_to_digi_if(data.get(), *hits, predicate);
+	  data.clear();
+	}
+	DepositView out(nam, mask, SegmentEntry::UNKNOWN, nullptr);
+	data_io<ddg4_input>::_to_digi(Key(nam, segment.id, mask), std::shared_ptr<const hits_t>(hits), out);
+	info("%s+++ %-24s Kept      %6ld DDG4 %-14s hits as %6ld cell deposits",
+	     context.event->id(), nam, len, tag.c_str(), out.size());
+	put_data(segment, Key(out.name, mask), out);
       }
 
       /// Convert DDG4 hit collections collection
@@ -106,7 +140,11 @@ namespace dd4hep {
 	auto&   seg = work.segment;
 	const char* nam = br.GetName();
 
-	if ( cls == m_caloHitClass )
+	if ( m_deposit_view && cls == m_caloHitClass )
+	  view_dd4g4<sim::Geant4Calorimeter::Hit>(context, seg, "calorimeter", msk, nam, *add);
+	else if ( m_deposit_view && cls == m_trackerHitClass )
+	  view_dd4g4<sim::Geant4Tracker::Hit>(context, seg, "tracker", msk, nam, *add);
+	else if ( cls == m_caloHitClass )
 	  from_dd4g4<sim::Geant4Calorimeter::Hit>(context, seg, "calorimeter", msk, nam, *add);
 	else if ( cls == m_trackerHitClass )
 	  from_dd4g4<sim::Geant4Tracker::Hit>(context, seg, "tracker", msk, nam, *add);
@@ -18,6 +18,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <algorithm>
 
 // =========================================================================
 //  EDM4HEP specific stuff
@@ -491,26 +492,89 @@ namespace dd4hep {
       }
     }
 
-    template <typename T>
-    static void ddg4_cnv_to_digi(Key key,
-                            const std::pair<const CellID, std::shared_ptr<T> >& depo,
-                            DepositVector& out)     {
-      Key history_key;
-      EnergyDeposit dep { };
-      const auto* h = depo.second.get();
+    template <typename T> static Position ddg4_position(const T* h)   {
       Position pos = h->position;
       pos *= 1./dd4hep::mm;
+      return pos;
+    }
 
+    template <typename T> static EnergyDeposit ddg4_deposit(Key key, std::size_t item, const T* h)   {
+      Key history_key;
+      EnergyDeposit dep { };
       dep.flag = h->flag;
       dep.deposit = h->energyDeposit;
-      dep.position = pos;
+      dep.position = ddg4_position(h);
 
       history_key.set_mask(key.mask());
-      history_key.set_item(out.size());
+      history_key.set_item(item);
       history_key.set_segment(key.segment());
       dep.history.hits.emplace_back(history_key, dep.deposit);
       add_particle_history(h, history_key, dep.history);
-      out.emplace(depo.first, std::move(dep));
+      return dep;
+    }
+
+    template <typename T>
+    static void ddg4_cnv_to_digi(Key key,
+                            const std::pair<const CellID, std::shared_ptr<T> >& depo,
+                            DepositVector& out)     {
+      out.emplace(depo.first, ddg4_deposit(key, out.size(), depo.second.get()));
+    }
+
+    /// Deposit view source reading DDG4 hits in place
+    /**
+     *  The source owns the hits passing the energy cut, sorted by cell identifier.
+     *  The attributes are identical to the deposits created by the conversion.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    template <typename T> class ddg4_deposit_source : public DepositView::source_t   {
+    public:
+      using hits_t = std::vector<std::unique_ptr<T> >;
+      /// Key of the input container (mask and segment of the history records)
+      Key                           key;
+      /// Hits owned by the source
+      std::shared_ptr<const hits_t> hits;
+
+    public:
+      /// Initializing constructor
+      ddg4_deposit_source(Key k, std::shared_ptr<const hits_t> h) : key(k), hits(std::move(h))  {}
+      /// Number of deposits in the source
+      virtual std::size_t size()  const  override               {  return hits->size();                    }
+      /// Cell identifier of an entry
+      virtual CellID   cell(std::size_t entry)  const  override    {  return (*hits)[entry]->cellID;          }
+      /// Energy deposit of an entry
+      virtual double   deposit(std::size_t entry)  const  override {  return (*hits)[entry]->energyDeposit;   }
+      /// Creation time of an entry: not set by the conversion of DDG4 hits
+      virtual double   time(std::size_t /* entry */)  const  override {  return 0e0;                         }
+      /// Position of an entry
+      virtual Position position(std::size_t entry)  const  override {  return ddg4_position((*hits)[entry].get()); }
+      /// User flags of an entry
+      virtual uint64_t flag(std::size_t entry)  const  override    {  return (*hits)[entry]->flag;            }
+      /// Create the full energy deposit of an entry including the history
+      virtual EnergyDeposit materialize(std::size_t entry)  const  override  {
+        return ddg4_deposit(key, entry, (*hits)[entry].get());
+      }
+    };
+
+    /// Take ownership of the DDG4 hits passing the cut. Hits are sorted by cell; the first hit of a cell is kept
+    template <typename T>
+    static void ddg4_select_hits(const std::vector<T*>& data,
+                                 std::vector<std::unique_ptr<T> >& hits,
+                                 const DepositPredicate<EnergyCut>& predicate)   {
+      hits.reserve(data.size());
+      for( auto* p : data )   {
+        std::unique_ptr<T> ptr(p);
+        if ( predicate(p) )   {
+          hits.emplace_back(std::move(ptr));
+        }
+      }
+      std::stable_sort(hits.begin(), hits.end(),
+                       [](const std::unique_ptr<T>& a, const std::unique_ptr<T>& b)  { return a->cellID < b->cellID; });
+      hits.erase(std::unique(hits.begin(), hits.end(),
+                             [](const std::unique_ptr<T>& a, const std::unique_ptr<T>& b)  { return a->cellID == b->cellID; }),
+                 hits.end());
     }
 
     template <> template <>
@@ -530,6 +594,36 @@ namespace dd4hep {
       for( const auto& p : hits )
         ddg4_cnv_to_digi(key, p, out);
     }
+
+    template <> template <>
+    void data_io<ddg4_input>::_to_digi_if(const std::vector<sim::Geant4Calorimeter::Hit*>& data,
+                                          std::vector<std::unique_ptr<sim::Geant4Calorimeter::Hit> >& hits,
+                                          const DepositPredicate<EnergyCut>& predicate)   {
+      ddg4_select_hits(data, hits, predicate);
+    }
+
+    template <> template <>
+    void data_io<ddg4_input>::_to_digi_if(const std::vector<sim::Geant4Tracker::Hit*>& data,
+                                          std::vector<std::unique_ptr<sim::Geant4Tracker::Hit> >& hits,
+                                          const DepositPredicate<EnergyCut>& predicate)   {
+      ddg4_select_hits(data, hits, predicate);
+    }
+
+    template <> template <>
+    void data_io<ddg4_input>::_to_digi(Key key,
+                                       const std::shared_ptr<const std::vector<std::unique_ptr<sim::Geant4Calorimeter::Hit> > >& hits,
+                                       DepositView& out)  {
+      out.data_type = SegmentEntry::CALORIMETER_HITS;
+      out.source = std::make_shared<ddg4_deposit_source<sim::Geant4Calorimeter::Hit> >(key, hits);
+    }
+
+    template <> template <>
+    void data_io<ddg4_input>::_to_digi(Key key,
+                                       const std::shared_ptr<const std::vector<std::unique_ptr<sim::Geant4Tracker::Hit> > >& hits,
+                                       DepositView& out)  {
+      out.data_type = SegmentEntry::TRACKER_HITS;
+      out.source = std::make_shared<ddg4_deposit_source<sim::Geant4Tracker::Hit> >(key, hits);
+    }
   }     // End namespace digi
 }       // End namespace dd4hep
 #endif  // DD4HEP_USE_DDG4
@@ -51,6 +51,9 @@ DECLARE_DIGIACTION_NS(dd4hep::digi,DigiAttenuatorSequence)
 #include <DDDigi/DigiContainerCombine.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiContainerCombine)
 
+#include <DDDigi/DigiBackgroundPool.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiBackgroundPool)
+
 #include <DDDigi/DigiContainerDrop.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiContainerDrop)
 
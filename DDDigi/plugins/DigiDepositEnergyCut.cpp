@@ -16,6 +16,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -58,12 +59,50 @@ namespace dd4hep {
              context.event->id(), cont.name.c_str(), dropped, cont.size(), cont.key.mask());
       }
 
+      /// Create deposit mapping with updates on same cellIDs (structure of arrays)
+      void cut_energy_arrays(context_t& context, DepositArrays& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        std::vector<uint8_t> selected;
+        predicate.select(cont, selected);
+        const std::size_t len = cont.size();
+        const uint8_t*    sel = selected.data();
+        const double*     dep = cont.deposit.data();
+        uint64_t*         flg = cont.flag.data();
+        const double      cut = m_cutoff;
+        std::size_t   dropped = 0UL;
+        for( std::size_t i = 0; i < len; ++i )   {
+          uint64_t kill = uint64_t(sel[i] & (dep[i] < cut));
+          flg[i] |= kill * EnergyDeposit::KILLED;
+          dropped += kill;
+        }
+        if ( m_monitor ) m_monitor->count_shift(cont.size(), dropped);
+        info("%s+++ %-32s dropped %6ld out of %6ld entries from mask: %04X",
+             context.event->id(), cont.name.c_str(), dropped, cont.size(), cont.key.mask());
+      }
+
+      /// Create deposit mapping with updates on same cellIDs (deposit view: only killed entries are materialized)
+      void cut_energy_view(context_t& context, DepositView& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        std::vector<uint8_t> selected;
+        predicate.select(cont, selected);
+        std::size_t dropped = 0UL;
+        for( std::size_t i = 0, len = cont.size(); i < len; ++i )   {
+          if ( selected[i] && cont.deposit(i) < m_cutoff )   {
+            cont.mutate(i).flag |= EnergyDeposit::KILLED;
+            ++dropped;
+          }
+        }
+        if ( m_monitor ) m_monitor->count_shift(cont.size(), dropped);
+        info("%s+++ %-32s dropped %6ld out of %6ld entries from mask: %04X",
+             context.event->id(), cont.name.c_str(), dropped, cont.size(), cont.key.mask());
+      }
+
       /// Standard constructor
       DigiDepositEnergyCut(const DigiKernel& krnl, const std::string& nam)
         : DigiDepositsProcessor(krnl, nam)
       {
         declareProperty("deposit_cutoff", m_cutoff);
         DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiDepositEnergyCut::cut_energy);
+        DEPOSIT_PROCESSOR_BIND_ARRAY_HANDLER(DigiDepositEnergyCut::cut_energy_arrays);
+        DEPOSIT_PROCESSOR_BIND_VIEW_HANDLER(DigiDepositEnergyCut::cut_energy_view);
       }
     };
   }    // End namespace digi
@@ -17,6 +17,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -96,6 +97,7 @@ namespace dd4hep {
         declareProperty("ionization_fluctuation",     m_ionization_fluctuation = false);
         declareProperty("modify_energy",              m_modify_energy = true);
         DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiDepositSmearEnergy::smear);
+        DEPOSIT_PROCESSOR_BIND_ARRAY_HANDLER(DigiDepositSmearEnergy::smear_arrays);
       }
 
       /// Create deposit mapping with updates on same cellIDs
@@ -151,6 +153,77 @@ namespace dd4hep {
         info("%s+++ %-32s Smear energy: updated %6ld out of %6ld entries from mask: %04X",
              context.event->id(), cont.name.c_str(), updated, cont.size(), cont.key.mask());
       }
+
+      /// Create deposit mapping with updates on same cellIDs (structure of arrays)
+      void smear_arrays(DigiContext& context, DepositArrays& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        constexpr static double eps = std::numeric_limits<double>::epsilon();
+        auto& random = context.randomGenerator();
+        std::vector<uint8_t> selected;
+        std::size_t updated = predicate.select(cont, selected);
+        const std::size_t len = cont.size();
+        const uint8_t*    sel = selected.data();
+        const double*     dep = cont.deposit.data();
+        std::vector<double> buffer(3*len, 0e0);
+        double* sigma_sys   = buffer.data();
+        double* sigma_intr  = sigma_sys + len;
+        double* delta       = sigma_intr + len;
+        const double sigma_instr = m_instrumentation_resolution / dd4hep::GeV;
+        const double pair_energy = m_pair_ionization_energy / dd4hep::GeV;
+
+        /// Resolution terms depending on the deposited energy only
+        for( std::size_t i = 0; i < len; ++i )   {
+          double energy = dep[i] / dd4hep::GeV; // E in units of GeV
+          sigma_sys[i]  = m_systematic_resolution * energy;
+          sigma_intr[i] = m_intrinsic_fluctuation * std::sqrt(energy);
+        }
+        /// Random numbers are drawn in the same order as for the other containers
+        for( std::size_t i = 0; i < len; ++i )   {
+          if ( sel[i] )   {
+            double energy  = dep[i] / dd4hep::GeV;
+            double delta_E = 0e0, delta_ion = 0e0, num_pairs = 0e0;
+            if ( sigma_sys[i] > eps )   {
+              delta_E += sigma_sys[i] * random.gaussian(0e0, 1e0);
+            }
+            if ( sigma_intr[i] > eps )   {
+              delta_E += sigma_intr[i] * random.gaussian(0e0, 1e0);
+            }
+            if ( sigma_instr > eps )   {
+              delta_E += sigma_instr * random.gaussian(0e0, 1e0);
+            }
+            if ( m_ionization_fluctuation )   {
+              num_pairs = energy / pair_energy;
+              delta_ion = energy * (random.poisson(num_pairs)/num_pairs);
+              delta_E += delta_ion;
+            }
+            if ( dd4hep::isActivePrintLevel(outputLevel()) )   {
+              print("%s+++ %016lX [GeV] E:%9.2e [%9.2e %9.2e] intrin_fluct:%9.2e systematic:%9.2e instrument:%9.2e ioni:%9.2e/%.0f",
+                    context.event->id(), cont.cell[i], energy, dep[i]/dd4hep::GeV, delta_E,
+                    sigma_intr[i], sigma_sys[i], sigma_instr, delta_ion, num_pairs);
+            }
+            /// delta_E is in GeV
+            delta[i] = delta_E * dd4hep::GeV;
+            if ( m_monitor )  {
+              EnergyDeposit depo = cont.at(i);
+              depo.depositError = delta[i];
+              m_monitor->energy_shift({cont.cell[i], depo}, delta[i]);
+            }
+          }
+        }
+        /// Apply the changes to the selected entries
+        double*   err = cont.depositError.data();
+        for( std::size_t i = 0; i < len; ++i )
+          err[i] = sel[i] ? delta[i] : err[i];
+        if ( m_modify_energy )  {
+          double*   out = cont.deposit.data();
+          uint64_t* flg = cont.flag.data();
+          for( std::size_t i = 0; i < len; ++i )   {
+            out[i] += delta[i];
+            flg[i] |= uint64_t(sel[i]) * EnergyDeposit::ENERGY_SMEARED;
+          }
+        }
+        info("%s+++ %-32s Smear energy: updated %6ld out of %6ld entries from mask: %04X",
+             context.event->id(), cont.name.c_str(), updated, cont.size(), cont.key.mask());
+      }
     };
 
     /// Actor to only set energy error (as above, but with preset option
@@ -17,6 +17,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -66,6 +67,38 @@ namespace dd4hep {
              context.event->id(), cont.name.c_str(), cont.size(), updated, killed, cont.key.mask());
       }
 
+      /// Create deposit mapping with updates on same cellIDs (structure of arrays)
+      void smear_arrays(DigiContext& context, DepositArrays& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        auto& random = context.randomGenerator();
+        std::vector<uint8_t> selected;
+        std::size_t updated = predicate.select(cont, selected);
+        const std::size_t len = cont.size();
+        const uint8_t*    sel = selected.data();
+        std::vector<double> shift(len, 0e0);
+        double* delta = shift.data();
+
+        /// Random numbers are drawn in the same order as for the other containers
+        for( std::size_t i = 0; i < len; ++i )   {
+          if ( sel[i] )   {
+            delta[i] = m_resolution_time * random.gaussian();
+            if ( m_monitor ) m_monitor->time_shift({cont.cell[i], cont.at(i)}, delta[i]);
+          }
+        }
+        const double lower = m_window_time.first, upper = m_window_time.second;
+        double*      tim   = cont.time.data();
+        uint64_t*    flg   = cont.flag.data();
+        std::size_t killed = 0UL;
+        for( std::size_t i = 0; i < len; ++i )   {
+          uint64_t kill = uint64_t(sel[i] & ((delta[i] < lower) | (delta[i] > upper)));
+          tim[i] += delta[i];
+          flg[i] |= uint64_t(sel[i]) * EnergyDeposit::TIME_SMEARED | kill * EnergyDeposit::KILLED;
+          killed += kill;
+        }
+        if ( m_monitor ) m_monitor->count_shift(cont.size(), -killed);
+        info("%s+++ %-32s Smeared time resolution: %6ld entries, updated %6ld killed %6ld entries from mask: %04X",
+             context.event->id(), cont.name.c_str(), cont.size(), updated, killed, cont.key.mask());
+      }
+
       /// Standard constructor
       DigiDepositSmearTime(const DigiKernel& krnl, const std::string& nam)
         : DigiDepositsProcessor(krnl, nam)
@@ -73,6 +106,7 @@ namespace dd4hep {
         declareProperty("resolution_time", m_resolution_time);
         declareProperty("window_time",     m_window_time);
         DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiDepositSmearTime::smear);
+        DEPOSIT_PROCESSOR_BIND_ARRAY_HANDLER(DigiDepositSmearTime::smear_arrays);
       }
     };
   }    // End namespace digi
@@ -17,6 +17,7 @@
 
 /// C/C++ include files
 #include <limits>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -57,12 +58,32 @@ namespace dd4hep {
         info("%s+++ %-32s Zero suppression: entries: %6ld handled: %6ld killed %6ld entries from mask: %04X",
              context.event->id(), cont.name.c_str(), cont.size(), handled, killed, cont.key.mask());
       }
+      /// Create deposit mapping with updates on same cellIDs (structure of arrays)
+      void handle_deposit_arrays(DigiContext& context, DepositArrays& cont, work_t& /* work */, const predicate_t& predicate)  const  {
+        std::vector<uint8_t> selected;
+        std::size_t handled = predicate.select(cont, selected);
+        const std::size_t len = cont.size();
+        const uint8_t*    sel = selected.data();
+        const double*     dep = cont.deposit.data();
+        uint64_t*         flg = cont.flag.data();
+        const double      threshold = m_energy_threshold;
+        std::size_t        killed = 0UL;
+        for( std::size_t i = 0; i < len; ++i )   {
+          uint64_t kill = uint64_t(dep[i] * dd4hep::GeV < threshold);
+          flg[i] |= uint64_t(sel[i]) * (EnergyDeposit::ZERO_SUPPRESSED | kill * EnergyDeposit::KILLED);
+          killed += sel[i] & kill;
+        }
+        info("%s+++ %-32s Zero suppression: entries: %6ld handled: %6ld killed %6ld entries from mask: %04X",
+             context.event->id(), cont.name.c_str(), cont.size(), handled, killed, cont.key.mask());
+      }
+
       /// Standard constructor
       DigiDepositZeroSuppress(const DigiKernel& krnl, const std::string& nam)
         : DigiDepositsProcessor(krnl, nam)
       {
         declareProperty("threshold", m_energy_threshold);
         DEPOSIT_PROCESSOR_BIND_HANDLERS(DigiDepositZeroSuppress::handle_deposits);
+        DEPOSIT_PROCESSOR_BIND_ARRAY_HANDLER(DigiDepositZeroSuppress::handle_deposit_arrays);
       }
     };
   }    // End namespace digi
@@ -81,6 +81,13 @@ namespace dd4hep {
         return std::make_pair(num_drop_hit,num_drop_particle);
       }
 
+      /// Declare the data items read and written by the action (used by the data flow scheduler)
+      virtual bool data_flow(data_items_t& /* inputs */, data_items_t& outputs)  const  override  {
+        for( int mask : m_masks )
+          outputs.emplace_back(data_item_t{ m_input, mask });
+        return true;
+      }
+
       /// Main functional callback
       virtual void execute(DigiContext& context)  const  final  {
         auto& inputs = context.event->get_segment(m_input);
@@ -39,6 +39,13 @@ void DigiActionSequence::adopt(DigiEventAction* action)    {
   this->DigiSynchronize::adopt(action);
 }
 
+/// Data flow of the sequence. Unknown if external callbacks are registered
+bool DigiActionSequence::data_flow(data_items_t& inputs, data_items_t& outputs)  const   {
+  if ( has_callbacks() )
+    return false;
+  return this->DigiSynchronize::data_flow(inputs, outputs);
+}
+
 /// Pre-track action callback
 void DigiActionSequence::execute(DigiContext& context)  const   {
   m_begin(&context);
@@ -0,0 +1,181 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiPlugins.h>
+#include <DDDigi/DigiBackgroundPool.h>
+
+/// C/C++ include files
+#include <map>
+#include <algorithm>
+
+using namespace dd4hep::digi;
+
+namespace {
+
+  /// Copy deposits to a new vector sorted by cell identifier. Identical cells keep their order
+  template <typename CONTAINER>
+  std::shared_ptr<const DepositVector> sorted_deposits(CONTAINER& cont, Key::mask_type mask)   {
+    using entry_t = std::pair<CellID, EnergyDeposit*>;
+    std::vector<entry_t> entries;
+    entries.reserve(cont.size());
+    for( auto& dep : cont )
+      entries.emplace_back(dep.first, &dep.second);
+    std::stable_sort(entries.begin(), entries.end(),
+		     [](const entry_t& a, const entry_t& b)  { return a.first < b.first; });
+    auto sorted = std::make_shared<DepositVector>(cont.name, mask, cont.data_type);
+    sorted->reserve(entries.size());
+    for( auto& e : entries )   {
+      /// The history refers to the particles of the pool event, which is not kept
+      e.second->history.drop();
+      sorted->emplace(e.first, std::move(*e.second));
+    }
+    return sorted;
+  }
+}
+
+/// Standard constructor
+DigiBackgroundPool::DigiBackgroundPool(const DigiKernel& krnl, const std::string& nam)
+  : DigiInputAction(krnl, nam)
+{
+  declareProperty("reader_type",    m_reader_type = "DigiDDG4ROOT");
+  declareProperty("pool_size",      m_pool_size   = 100);
+  declareProperty("mu",             m_mu          = 1e0);
+  declareProperty("poisson",        m_poisson     = true);
+  declareProperty("crossings",      m_crossings);
+  declareProperty("crossing_masks", m_crossing_masks);
+  m_crossings.emplace_back(0e0);
+  m_stream_key = dd4hep::detail::hash64(nam);
+  m_kernel.register_initialize(std::bind(&DigiBackgroundPool::initialize,this));
+  m_kernel.register_terminate(std::bind(&DigiBackgroundPool::finalize,this));
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiBackgroundPool::~DigiBackgroundPool()   {
+  m_pool.clear();
+  if ( m_reader )   {
+    m_reader->release();
+    m_reader = nullptr;
+  }
+  InstanceCount::decrement(this);
+}
+
+/// Convert the deposit containers of one event to a pool event
+DigiBackgroundPool::pool_event_t DigiBackgroundPool::load_event(DataSegment& segment)  const   {
+  pool_event_t event;
+  for( auto& i : segment )   {
+    Key key(i.first);
+    if ( DepositMapping* m = std::any_cast<DepositMapping>(&i.second) )
+      event.emplace_back(key, sorted_deposits(*m, key.mask()));
+    else if ( DepositVector* v = std::any_cast<DepositVector>(&i.second) )
+      event.emplace_back(key, sorted_deposits(*v, key.mask()));
+  }
+  return event;
+}
+
+/// Initialization callback: read the pool events
+void DigiBackgroundPool::initialize()   {
+  if ( !m_pool.empty() )   {
+    return;
+  }
+  if ( m_pool_size <= 0 )   {
+    except("+++ Invalid background pool size: %d", m_pool_size);
+  }
+  std::string nam = name() + ".Reader";
+  m_reader = createAction<DigiInputAction>(m_reader_type, m_kernel, nam);
+  if ( !m_reader )   {
+    except("+++ Failed to create background reader: %s of type: %s",
+	   nam.c_str(), m_reader_type.c_str());
+  }
+  m_reader->property("input").set(m_input_sources);
+  m_reader->property("mask").set(m_input_mask);
+  m_reader->property("input_section").set(m_input_section);
+  m_reader->property("objects_enabled").set(m_objects_enabled);
+  m_reader->property("objects_disabled").set(m_objects_disabled);
+  m_reader->property("events_per_file").set(m_events_per_file);
+  m_reader->property("rescan").set(m_input_rescan);
+  m_reader->property("keep_raw").set(false);
+  m_reader->property("OutputLevel").set(int(outputLevel()));
+
+  std::size_t num_deposits = 0;
+  m_pool.reserve(m_pool_size);
+  for( int i = 0; i < m_pool_size; ++i )   {
+    DigiContext context(m_kernel, std::make_unique<DigiEvent>(i));
+    m_reader->execute(context);
+    m_pool.emplace_back(load_event(context.event->get_segment(m_reader->input_segment())));
+    for( const auto& cont : m_pool.back() )
+      num_deposits += cont.second->size();
+  }
+  info("+++ Background pool filled with %ld events and %ld deposits", m_pool.size(), num_deposits);
+}
+
+/// Finalization callback: print usage statistics
+void DigiBackgroundPool::finalize()   {
+  std::size_t num_drawn = m_num_drawn.load();
+  info("+++ Drew %ld events from the background pool of %ld events. Reuse factor: %.1f",
+       num_drawn, m_pool.size(), m_pool.empty() ? 0e0 : double(num_drawn)/double(m_pool.size()));
+}
+
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiBackgroundPool::data_flow(data_items_t& /* inputs */, data_items_t& outputs)  const   {
+  for( std::size_t c = 0; c < m_crossings.size(); ++c )   {
+    int mask = c < m_crossing_masks.size() ? m_crossing_masks[c] : m_input_mask + int(c);
+    outputs.emplace_back(data_item_t{ m_input_segment, mask });
+  }
+  return true;
+}
+
+/// Callback to overlay pile-up events to the input segment
+void DigiBackgroundPool::execute(DigiContext& context)  const   {
+  if ( m_pool.empty() )   {
+    except("+++ The background pool is empty. Was the action initialized?");
+  }
+  auto& segment = context.event->get_segment(m_input_segment);
+  auto  random  = context.randomStream(m_stream_key);
+  std::size_t num_events = 0, num_deposits = 0;
+
+  for( std::size_t c = 0; c < m_crossings.size(); ++c )   {
+    double t0   = m_crossings[c];
+    int    mask = c < m_crossing_masks.size() ? m_crossing_masks[c] : m_input_mask + int(c);
+    double num  = m_mu;
+    if ( m_poisson )   {
+      random.poisson(&num, 1, m_mu);
+    }
+    /// One view per container and bunch crossing: it references the deposits of all drawn events
+    std::map<Key::itemkey_type, DepositOverlay> overlays;
+    for( std::size_t i = 0, n = std::size_t(num); i < n; ++i )   {
+      std::size_t idx = std::min(std::size_t(random.uniform() * double(m_pool.size())), m_pool.size()-1);
+      for( const auto& cont : m_pool[idx] )   {
+	auto iter = overlays.find(cont.first.item());
+	if ( iter == overlays.end() )   {
+	  DepositOverlay overlay(cont.second->name, mask, cont.second->data_type, t0);
+	  iter = overlays.emplace(cont.first.item(), std::move(overlay)).first;
+	}
+	iter->second.add(cont.second);
+      }
+      ++num_events;
+    }
+    for( auto& o : overlays )   {
+      Key key = o.second.key;
+      num_deposits += o.second.size();
+      segment.put(key, std::move(o.second));
+    }
+  }
+  m_num_drawn += num_events;
+  info("%s+++ Overlaid %ld pile-up events with %ld deposits in %ld bunch crossings",
+       context.event->id(), num_events, num_deposits, m_crossings.size());
+}
@@ -16,10 +16,13 @@
 #include <DDDigi/DigiData.h>
 #include <DDDigi/DigiKernel.h>
 #include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiProfiler.h>
 #include <DDDigi/DigiContainerCombine.h>
 
 /// C/C++ include files
 #include <set>
+#include <thread>
+#include <algorithm>
 
 using namespace dd4hep::digi;
 
@@ -37,28 +40,36 @@ public:
   const DigiContainerCombine* combine;
   /// Printout format string
   char        format[128];
-  /// Local counters
-  std::size_t cnt_conts    = 0;
-  std::size_t cnt_depos    = 0;
-  std::size_t cnt_parts    = 0;
-  std::size_t cnt_hist     = 0;
-  std::size_t cnt_response = 0;
+  /// Counters
+  struct counters_t  {
+    std::size_t cnt_conts    = 0;
+    std::size_t cnt_depos    = 0;
+    std::size_t cnt_parts    = 0;
+    std::size_t cnt_hist     = 0;
+    std::size_t cnt_response = 0;
+  };
+  /// Work done by one worker. Aligned to avoid false sharing between threads
+  struct alignas(64) thread_data_t : public counters_t  {
+    std::vector<Key>          used_keys;
+  };
   /// Work definition
   std::vector<Key>            keys;
   std::vector<std::any*>      work;
   std::set<Key::itemkey_type> items;
-  /// Work done
+  /// Work done by each worker (indexed by the worker number)
+  std::vector<thread_data_t>  threads;
+  /// Work done (reduced)
+  counters_t                  counts;
   std::vector<Key>            used_keys;
 
   /// Input arguments
   DigiEvent&                  event;
   DataSegment&                inputs;
   DataSegment&                outputs;
-  std::mutex&                 used_keys_lock;
 
   /// Initializing constructor
-  work_definition_t(const DigiContainerCombine* c, DigiEvent& ev, DataSegment& in, DataSegment& out, std::mutex& used_lock)
-    : combine(c), event(ev), inputs(in), outputs(out), used_keys_lock(used_lock)
+  work_definition_t(const DigiContainerCombine* c, DigiEvent& ev, DataSegment& in, DataSegment& out)
+    : combine(c), event(ev), inputs(in), outputs(out)
   {
     keys.reserve(inputs.size());
     work.reserve(inputs.size());
@@ -70,15 +81,28 @@ public:
 	items.insert(key.item());
       }
     }
+    threads.resize(std::max(items.size(), std::size_t(1)));
     ::snprintf(format, sizeof(format),
 	       "%s Thread:%%2d+++ %%-32s Out-Mask: $%04X In-Mask: $%%04X Merged %%6ld %%s",
 	       event.id(), combine->m_deposit_mask);
     format[sizeof(format)-1] = 0;
   }
 
-  void used_keys_insert(Key key)   {
-    std::lock_guard<std::mutex> lock(used_keys_lock);
-    used_keys.emplace_back(key);
+  /// Register used key in the bookkeeping of the worker (no locking required)
+  void used_keys_insert(Key key, int thr)   {
+    threads[thr].used_keys.emplace_back(key);
+  }
+
+  /// Reduce the bookkeeping of all workers after the work is done
+  void reduce()   {
+    for( auto& t : threads )   {
+      counts.cnt_conts    += t.cnt_conts;
+      counts.cnt_depos    += t.cnt_depos;
+      counts.cnt_parts    += t.cnt_parts;
+      counts.cnt_hist     += t.cnt_hist;
+      counts.cnt_response += t.cnt_response;
+      used_keys.insert(used_keys.end(), t.used_keys.begin(), t.used_keys.end());
+    }
   }
 
   /// Specialized deposit merger: implicitly assume identical item types are mapped sequentially
@@ -97,8 +121,8 @@ public:
       cnt = output.insert(input);
     }
     combine->info(this->format, thr, nam.c_str(), mask, cnt, "deposits"); 
-    this->cnt_depos += cnt;
-    this->cnt_conts++;
+    this->threads[thr].cnt_depos += cnt;
+    this->threads[thr].cnt_conts++;
   }
 
   /// Generic deposit merger: implicitly assume identical item types are mapped sequentially
@@ -111,9 +135,13 @@ public:
 	  merge_depos(out, *m, thr);
 	else if ( DepositVector* v = std::any_cast<DepositVector>(work[j]) )
 	  merge_depos(out, *v, thr);
+	else if ( DepositOverlay* o = std::any_cast<DepositOverlay>(work[j]) )
+	  merge_depos(out, *o, thr);
+	else if ( DepositView* w = std::any_cast<DepositView>(work[j]) )
+	  merge_depos(out, *w, thr);
 	else
 	  break;
-	used_keys_insert(keys[j]);
+	used_keys_insert(keys[j], thr);
       }
     }
     key.set_mask(combine->m_deposit_mask);
@@ -132,9 +160,9 @@ public:
 	  std::string next_name = next->name;
 	  cnt = (combine->m_erase_combined) ? out.merge(std::move(*next)) : out.insert(*next);
 	  combine->info(format, thr, next_name.c_str(), keys[j].mask(), cnt, "histories");
-	  used_keys_insert(keys[j]);
-	  cnt_hist += cnt;
-	  cnt_conts++;
+	  used_keys_insert(keys[j], thr);
+	  threads[thr].cnt_hist += cnt;
+	  threads[thr].cnt_conts++;
 	}
       }
     }
@@ -154,9 +182,9 @@ public:
 	  std::string next_name = next->name;
 	  cnt = (combine->m_erase_combined) ? out.merge(std::move(*next)) : out.insert(*next);
 	  combine->info(format, thr, next_name.c_str(), keys[j].mask(), cnt, "responses"); 
-	  used_keys_insert(keys[j]);
-	  cnt_response += cnt;
-	  cnt_conts++;
+	  used_keys_insert(keys[j], thr);
+	  threads[thr].cnt_response += cnt;
+	  threads[thr].cnt_conts++;
 	}
       }
     }
@@ -175,9 +203,9 @@ public:
 	std::string next_name = next->name;
 	cnt = (combine->m_erase_combined) ? out.merge(std::move(*next)) : out.insert(*next);
 	combine->info(format, thr, next_name.c_str(), keys[j].mask(), cnt, "particles"); 
-	used_keys_insert(keys[j]);
-	cnt_parts += cnt;
-	cnt_conts++;
+	used_keys_insert(keys[j], thr);
+	threads[thr].cnt_parts += cnt;
+	threads[thr].cnt_conts++;
       }
     }
     key.set_mask(combine->m_deposit_mask);
@@ -187,16 +215,25 @@ public:
   /// Merge single item type
   void merge_one(Key::itemkey_type itm, int thr)   {
     const std::string& opt = combine->m_output_name_flag;
+    const bool merge_depos = combine->m_merge_deposits && !combine->m_merge_cells;
     for( std::size_t i=0; i < keys.size(); ++i )   {
       if ( keys[i].item() != itm )
 	continue;
       /// Merge deposit mapping
       if ( DepositMapping* depom = std::any_cast<DepositMapping>(work[i]) )   {
-	if ( combine->m_merge_deposits  ) merge(depom->name+opt, i, thr);
+	if ( merge_depos ) merge(depom->name+opt, i, thr);
       }
       /// Merge deposit vector
       else if ( DepositVector* depov = std::any_cast<DepositVector>(work[i]) )   {
-	if ( combine->m_merge_deposits  ) merge(depov->name+opt, i, thr);
+	if ( merge_depos ) merge(depov->name+opt, i, thr);
+      }
+      /// Merge shared pile-up deposits
+      else if ( DepositOverlay* depoo = std::any_cast<DepositOverlay>(work[i]) )   {
+	if ( merge_depos ) merge(depoo->name+opt, i, thr);
+      }
+      /// Merge deposit view of input hits
+      else if ( DepositView* depow = std::any_cast<DepositView>(work[i]) )   {
+	if ( merge_depos ) merge(depow->name+opt, i, thr);
       }
       /// Merge detector response
       else if ( DetectorResponse* resp = std::any_cast<DetectorResponse>(work[i]) )   {
@@ -234,6 +271,332 @@ template <> void DigiParallelWorker<DigiContainerCombine,
   }
 }
 
+/// Work definition of the k-way merge of deposit containers
+/**
+ *  The merge is executed in 3 steps. Each step consists of independent tasks,
+ *  which may be executed in parallel:
+ *  - SORT:  Chunks of the input containers are sorted by cell identifier.
+ *           Shared pile-up deposits (DepositOverlay) are never modified:
+ *           time offset and mask are applied to the merged copies.
+ *           Deposit views are materialized chunk by chunk.
+ *  - MERGE: The sorted chunks (runs) of one output container are merged for
+ *           a range of cell identifiers. Deposits of identical cells are
+ *           accumulated in the order of the input containers.
+ *  - FILL:  The merged ranges are moved to the pre-sized output container.
+ *
+ *  All tasks only write to data owned by the task. No locks are required.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiContainerCombine::merge_definition_t  {
+public:
+  enum phase_t  { SORT, MERGE, FILL };
+  /// Reference to a deposit of a sorted run
+  using entry_t = std::pair<CellID, const EnergyDeposit*>;
+  /// Merged deposits of one cell range
+  using range_t = std::vector<std::pair<CellID, EnergyDeposit> >;
+
+  /// Sorted chunk of one input container
+  struct run_t  {
+    /// Index of the input container
+    std::size_t               input  { 0 };
+    /// Chunk boundaries in the input container
+    std::size_t               first  { 0 }, last { 0 };
+    /// Shared pile-up deposits: view and index of the source
+    const DepositOverlay*     overlay { nullptr };
+    std::size_t               source  { 0 };
+    /// Deposit view: deposits of the chunk materialized by the run
+    const DepositView*        view    { nullptr };
+    std::vector<EnergyDeposit> deposits { };
+    /// Sorted deposit references
+    std::vector<entry_t>      entries;
+  };
+  /// Output container definition
+  struct output_t  {
+    Key                       key;
+    std::string               name;
+    SegmentEntry::data_type_t data_type  { SegmentEntry::UNKNOWN };
+    std::size_t               num_conts  { 0 };
+    std::size_t               num_depos  { 0 };
+    std::size_t               num_cells  { 0 };
+    /// Runs [first_run, last_run[ belong to this output
+    std::size_t               first_run  { 0 }, last_run { 0 };
+    /// Lower cell boundaries of the ranges 1...N-1
+    std::vector<CellID>       bounds;
+    /// Merged cell ranges
+    std::vector<range_t>      ranges;
+  };
+  /// Merge task: one cell range of one output
+  struct task_t  {
+    std::size_t output, range;
+  };
+
+  /// Reference to parent
+  const DigiContainerCombine* combine;
+  /// Input arguments
+  DigiEvent&                  event;
+  DataSegment&                segment;
+  /// Flag to move the input deposits (inputs are erased after the merge)
+  bool                        move_inputs;
+  /// Current processing step
+  phase_t                     phase     { SORT };
+  /// Input containers
+  std::vector<std::any*>      work;
+  /// Work definitions
+  std::vector<run_t>          runs;
+  std::vector<output_t>       outputs;
+  std::vector<task_t>         tasks;
+  /// Work done
+  std::vector<Key>            used_keys;
+  std::size_t                 cnt_conts = 0;
+  std::size_t                 cnt_depos = 0;
+
+  /// Initializing constructor: define the runs from the selected deposit containers
+  merge_definition_t(const DigiContainerCombine* c, const work_definition_t& def, std::size_t chunk)
+    : combine(c), event(def.event), segment(def.outputs), move_inputs(c->m_erase_combined)
+  {
+    const std::string& opt = combine->m_output_name_flag;
+    chunk = std::max(chunk, std::size_t(1));
+    for( auto itm : def.items )   {
+      output_t out;
+      out.first_run = runs.size();
+      for( std::size_t j = 0; j < def.keys.size(); ++j )   {
+	if ( def.keys[j].item() != itm )
+	  continue;
+	const SegmentEntry*   entry   = nullptr;
+	const DepositOverlay* overlay = nullptr;
+	const DepositView*    view    = nullptr;
+	std::size_t len = 0;
+	bool sorted = false;
+	if ( const DepositMapping* m = std::any_cast<DepositMapping>(def.work[j]) )   {
+	  entry  = m;
+	  len    = m->size();
+	  sorted = true;
+	}
+	else if ( const DepositVector* v = std::any_cast<DepositVector>(def.work[j]) )   {
+	  entry  = v;
+	  len    = v->size();
+	}
+	else if ( const DepositOverlay* o = std::any_cast<DepositOverlay>(def.work[j]) )   {
+	  entry   = overlay = o;
+	  len     = o->size();
+	}
+	else if ( const DepositView* w = std::any_cast<DepositView>(def.work[j]) )   {
+	  entry  = view = w;
+	  len    = w->size();
+	}
+	else   {
+	  continue;
+	}
+	if ( out.num_conts == 0 )   {
+	  out.key  = def.keys[j];
+	  out.name = entry->name + opt;
+	  out.data_type = entry->data_type;
+	  out.key.set_mask(combine->m_deposit_mask);
+	}
+	else if ( out.data_type != entry->data_type )   {
+	  combine->except("+++ Digitization does not allow to mix data of different type!");
+	}
+	/// Shared pile-up deposits: one run per source
+	for( std::size_t k = 0; overlay && k < overlay->sources.size(); ++k )   {
+	  run_t run;
+	  run.input   = work.size();
+	  run.last    = overlay->sources[k]->size();
+	  run.overlay = overlay;
+	  run.source  = k;
+	  if ( run.last > 0 ) runs.emplace_back(std::move(run));
+	}
+	/// Maps are already sorted: one single run. Vectors are sorted in chunks
+	std::size_t step = sorted ? std::max(len, std::size_t(1)) : chunk;
+	for( std::size_t first = 0; !overlay && first < len; first += step )   {
+	  run_t run;
+	  run.input = work.size();
+	  run.first = first;
+	  run.last  = std::min(first + step, len);
+	  run.view  = view;
+	  runs.emplace_back(std::move(run));
+	}
+	work.emplace_back(def.work[j]);
+	used_keys.emplace_back(def.keys[j]);
+	out.num_depos += len;
+	out.num_conts++;
+      }
+      out.last_run = runs.size();
+      if ( out.num_conts > 0 )   {
+	cnt_conts += out.num_conts;
+	cnt_depos += out.num_depos;
+	outputs.emplace_back(std::move(out));
+      }
+    }
+  }
+
+  /// Number of tasks of the current processing step
+  std::size_t num_tasks()  const   {
+    switch( phase )   {
+    case SORT:  return runs.size();
+    case MERGE: return tasks.size();
+    case FILL:  return outputs.size();
+    }
+    return 0;
+  }
+
+  /// SORT: Collect and sort the deposits of one chunk
+  void sort_run(run_t& run)   {
+    auto less_entry = [](const entry_t& a, const entry_t& b)  { return a.first < b.first; };
+    run.entries.reserve(run.last - run.first);
+    if ( run.overlay )   {
+      for( const auto& dep : *run.overlay->sources[run.source] )
+	run.entries.emplace_back(dep.first, &dep.second);
+    }
+    else if ( run.view )   {
+      /// Reserved: the entries point to the materialized deposits
+      run.deposits.reserve(run.last - run.first);
+      for( std::size_t i = run.first; i < run.last; ++i )   {
+	run.deposits.emplace_back(run.view->get(i));
+	run.entries.emplace_back(run.view->cell(i), &run.deposits.back());
+      }
+    }
+    else if ( const DepositMapping* m = std::any_cast<DepositMapping>(work[run.input]) )   {
+      for( const auto& dep : *m )
+	run.entries.emplace_back(dep.first, &dep.second);
+      return;   /// Multimap: sorted and insertion ordered for identical cells
+    }
+    else   {
+      const DepositVector* v = std::any_cast<DepositVector>(work[run.input]);
+      for( auto i = v->begin() + run.first, e = v->begin() + run.last; i != e; ++i )
+	run.entries.emplace_back(i->first, &i->second);
+    }
+    /// Pool deposits are typically sorted once when loaded
+    if ( !std::is_sorted(run.entries.begin(), run.entries.end(), less_entry) )
+      std::stable_sort(run.entries.begin(), run.entries.end(), less_entry);
+  }
+
+  /// Define the cell ranges of all outputs from samples of the sorted runs
+  void define_ranges(std::size_t num_ranges)   {
+    constexpr std::size_t min_range_size = 1024;
+    constexpr std::size_t samples_per_range = 16;
+    for( std::size_t o = 0; o < outputs.size(); ++o )   {
+      auto& out = outputs[o];
+      std::size_t nr = std::min(num_ranges, 1 + out.num_depos / min_range_size);
+      if ( nr > 1 )   {
+	std::vector<CellID> samples;
+	for( std::size_t r = out.first_run; r < out.last_run; ++r )   {
+	  const auto& e = runs[r].entries;
+	  std::size_t ns = std::min(e.size(), nr * samples_per_range);
+	  for( std::size_t i = 0; i < ns; ++i )
+	    samples.emplace_back(e[(i * e.size()) / ns].first);
+	}
+	std::sort(samples.begin(), samples.end());
+	for( std::size_t k = 1; k < nr; ++k )
+	  out.bounds.emplace_back(samples[(k * samples.size()) / nr]);
+	out.bounds.erase(std::unique(out.bounds.begin(), out.bounds.end()), out.bounds.end());
+      }
+      out.ranges.resize(out.bounds.size() + 1);
+      for( std::size_t k = 0; k < out.ranges.size(); ++k )
+	tasks.emplace_back(task_t{ o, k });
+    }
+  }
+
+  /// Add deposit to a merged range: deposits of identical cells are accumulated
+  template <typename DEPOSIT> static void accumulate(range_t& result, CellID cell, DEPOSIT&& depo)   {
+    if ( !result.empty() && result.back().first == cell )
+      result.back().second.update_deposit_weighted(std::forward<DEPOSIT>(depo));
+    else
+      result.emplace_back(cell, std::forward<DEPOSIT>(depo));
+  }
+
+  /// MERGE: k-way merge of all runs of one output within one cell range
+  void merge_range(const task_t& task)   {
+    struct cursor_t  {  const entry_t *current, *end;  const run_t* run;  };
+    auto less_cell = [](const entry_t& e, CellID c)  { return e.first < c; };
+    auto& out = outputs[task.output];
+    std::vector<cursor_t>    cursors;
+    std::vector<std::size_t> heap;
+    std::size_t total = 0;
+
+    for( std::size_t r = out.first_run; r < out.last_run; ++r )   {
+      const entry_t* b = runs[r].entries.data();
+      const entry_t* e = b + runs[r].entries.size();
+      if ( task.range > 0 )
+	b = std::lower_bound(b, e, out.bounds[task.range-1], less_cell);
+      if ( task.range < out.bounds.size() )
+	e = std::lower_bound(b, e, out.bounds[task.range], less_cell);
+      if ( b != e )   {
+	heap.emplace_back(cursors.size());
+	cursors.emplace_back(cursor_t{ b, e, &runs[r] });
+	total += e - b;
+      }
+    }
+    /// Min-heap on (cell, run): identical cells are merged in the order of the inputs
+    auto greater = [&cursors](std::size_t a, std::size_t b)   {
+      CellID ca = cursors[a].current->first, cb = cursors[b].current->first;
+      return ca > cb || (ca == cb && a > b);
+    };
+    range_t& result = out.ranges[task.range];
+    result.reserve(total);
+    std::make_heap(heap.begin(), heap.end(), greater);
+    while( !heap.empty() )   {
+      std::pop_heap(heap.begin(), heap.end(), greater);
+      cursor_t& cur = cursors[heap.back()];
+      CellID cell = cur.current->first;
+      const EnergyDeposit& depo = *cur.current->second;
+      if ( cur.run->overlay )   {
+	EnergyDeposit copy(depo);
+	cur.run->overlay->apply(copy);
+	accumulate(result, cell, std::move(copy));
+      }
+      else if ( move_inputs || cur.run->view )   {
+	/// Not shared: the input container is erased after the merge or the run owns the deposit
+	accumulate(result, cell, std::move(const_cast<EnergyDeposit&>(depo)));
+      }
+      else   {
+	accumulate(result, cell, depo);
+      }
+      if ( ++cur.current == cur.end )
+	heap.pop_back();
+      else
+	std::push_heap(heap.begin(), heap.end(), greater);
+    }
+  }
+
+  /// FILL: Move the merged ranges to the pre-sized output container
+  void fill_output(output_t& out)   {
+    std::size_t num_cells = 0;
+    for( const auto& r : out.ranges )
+      num_cells += r.size();
+    DepositVector result(out.name, combine->m_deposit_mask, out.data_type);
+    result.reserve(num_cells);
+    for( auto& r : out.ranges )   {
+      for( auto& dep : r )
+	result.emplace(dep.first, std::move(dep.second));
+      range_t().swap(r);
+    }
+    out.num_cells = num_cells;
+    combine->info("%s+++ %-32s Out-Mask: $%04X Merged %6ld deposits of %ld containers to %ld cells",
+		  event.id(), out.name.c_str(), combine->m_deposit_mask,
+		  out.num_depos, out.num_conts, num_cells);
+    segment.emplace(out.key, std::move(result));
+  }
+
+  /// Execute one task of the current processing step
+  void execute(std::size_t which)   {
+    switch( phase )   {
+    case SORT:  sort_run(runs[which]);       break;
+    case MERGE: merge_range(tasks[which]);   break;
+    case FILL:  fill_output(outputs[which]); break;
+    }
+  }
+};
+
+template <> void DigiParallelWorker<DigiContainerCombine,
+				    DigiContainerCombine::merge_definition_t,
+				    std::size_t>::execute(void* data) const  {
+  calldata_t* args = reinterpret_cast<calldata_t*>(data);
+  args->execute(this->options);
+}
+
 /// Standard constructor
 DigiContainerCombine::DigiContainerCombine(const DigiKernel& krnl, const std::string& nam)
   : DigiEventAction(krnl, nam)
@@ -249,6 +612,9 @@ DigiContainerCombine::DigiContainerCombine(const DigiKernel& krnl, const std::st
   declareProperty("merge_response",   m_merge_response  = true);
   declareProperty("merge_history",    m_merge_history   = true);
   declareProperty("merge_particles",  m_merge_particles = false);
+  declareProperty("merge_cells",      m_merge_cells     = false);
+  declareProperty("merge_ranges",     m_merge_ranges    = 0);
+  declareProperty("merge_chunk",      m_merge_chunk     = 65536);
   m_kernel.register_initialize(std::bind(&DigiContainerCombine::initialize,this));
   InstanceCount::increment(this);
 }
@@ -285,6 +651,15 @@ void DigiContainerCombine::have_workers(size_t count)  const   {
   }
 }
 
+/// Check if we have sufficient workers for the k-way merge
+void DigiContainerCombine::have_merge_workers(size_t count)  const   {
+  if ( m_merge_workers.size() < count )   {
+    auto group = m_merge_workers.get_group(); // Lock worker group
+    for(size_t i=m_merge_workers.size(); i <= count; ++i)
+      m_merge_workers.insert(new MergeWorker(nullptr, i));
+  }
+}
+
 /// Decide if a continer is to merged based on the properties
 bool DigiContainerCombine::use_key(Key key)  const   {
   const auto& m = m_input_masks;
@@ -299,13 +674,33 @@ bool DigiContainerCombine::use_key(Key key)  const   {
   return true;
 }
 
+/// Merge deposits of identical cells of all selected deposit containers
+void DigiContainerCombine::merge_cells(DigiContext& context, merge_definition_t& def)  const   {
+  auto execute_step = [this, &context, &def](merge_definition_t::phase_t phase)   {
+    def.phase = phase;
+    std::size_t count = def.num_tasks();
+    if ( m_parallel && count > 1 )  {
+      have_merge_workers(count);
+      m_kernel.submit(context, m_merge_workers.get_group(), count, &def);
+      return;
+    }
+    for( std::size_t i = 0; i < count; ++i )
+      def.execute(i);
+  };
+  std::size_t num_ranges = m_merge_ranges > 0 ? m_merge_ranges : std::thread::hardware_concurrency();
+  execute_step(merge_definition_t::SORT);
+  def.define_ranges(std::max(num_ranges, std::size_t(1)));
+  execute_step(merge_definition_t::MERGE);
+  execute_step(merge_definition_t::FILL);
+}
+
 /// Combine selected containers to one single deposit container
 std::size_t DigiContainerCombine::combine_containers(DigiContext& context,
 						     DigiEvent&   event,
 						     DataSegment& inputs,
 						     DataSegment& outputs)  const
 {
-  work_definition_t def(this, event, inputs, outputs, m_used_keys_lock);
+  work_definition_t def(this, event, inputs, outputs);
   if ( m_parallel )  {
     have_workers(def.items.size());
     m_kernel.submit(context, m_workers.get_group(), def.items.size(), &def);
@@ -313,12 +708,32 @@ std::size_t DigiContainerCombine::combine_containers(DigiContext& context,
   else  {
     def.merge_all();
   }
+  def.reduce();
+  if ( m_merge_cells && m_merge_deposits )   {
+    merge_definition_t merge(this, def, m_merge_chunk);
+    merge_cells(context, merge);
+    def.used_keys.insert(def.used_keys.end(), merge.used_keys.begin(), merge.used_keys.end());
+    def.counts.cnt_depos += merge.cnt_depos;
+    def.counts.cnt_conts += merge.cnt_conts;
+  }
   if ( m_erase_combined )   {
     inputs.erase(def.used_keys);
   }
   info("%s+++ Merged %ld particles and %ld deposits from segment '%s' to segment '%s'",
-       event.id(), def.cnt_parts, def.cnt_depos, m_input.c_str(), m_output.c_str());
-  return def.cnt_depos;
+       event.id(), def.counts.cnt_parts, def.counts.cnt_depos, m_input.c_str(), m_output.c_str());
+  return def.counts.cnt_depos;
+}
+
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiContainerCombine::data_flow(data_items_t& inputs, data_items_t& outputs)  const   {
+  /// Combined input containers are modified if they are erased
+  data_items_t& modified = m_erase_combined ? outputs : inputs;
+  if ( m_input_masks.empty() )
+    modified.emplace_back(data_item_t{ m_input, ANY_MASK });
+  for( int mask : m_input_masks )
+    modified.emplace_back(data_item_t{ m_input, mask });
+  outputs.emplace_back(data_item_t{ m_output, m_deposit_mask });
+  return true;
 }
 
 /// Main functional callback
@@ -326,5 +741,6 @@ void DigiContainerCombine::execute(DigiContext& context)  const    {
   auto& event    = *context.event;
   auto& inputs   = event.get_segment(m_input);
   auto& outputs  = event.get_segment(m_output);
-  combine_containers(context, event, inputs, outputs);
+  std::size_t num_depos = combine_containers(context, event, inputs, outputs);
+  DigiProfiler::count(num_depos, num_depos * sizeof(DepositVector::value_type));
 }
@@ -141,6 +141,15 @@ bool DigiContainerDrop::use_key(Key key)  const   {
   return true;
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiContainerDrop::data_flow(data_items_t& /* inputs */, data_items_t& outputs)  const   {
+  if ( m_input_masks.empty() )
+    outputs.emplace_back(data_item_t{ m_input_segment, ANY_MASK });
+  for( int mask : m_input_masks )
+    outputs.emplace_back(data_item_t{ m_input_segment, mask });
+  return true;
+}
+
 /// Main functional callback
 void DigiContainerDrop::execute(DigiContext& context)  const    {
   auto& event    = *context.event;
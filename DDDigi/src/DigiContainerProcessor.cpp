@@ -16,11 +16,13 @@
 #include <DDDigi/DigiData.h>
 #include <DDDigi/DigiKernel.h>
 #include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiProfiler.h>
 #include <DDDigi/DigiContainerProcessor.h>
 #include <DDDigi/DigiSegmentSplitter.h>
 
 /// C/C++ include files
 #include <sstream>
+#include <algorithm>
 
 using namespace dd4hep::digi;
 
@@ -66,6 +68,10 @@ template       DepositVector*    DigiContainerProcessor::work_t::get_input(bool
 template const DepositVector*    DigiContainerProcessor::work_t::get_input(bool exc)  const;
 template       DepositMapping*   DigiContainerProcessor::work_t::get_input(bool exc);
 template const DepositMapping*   DigiContainerProcessor::work_t::get_input(bool exc)  const;
+template       DepositArrays*    DigiContainerProcessor::work_t::get_input(bool exc);
+template const DepositArrays*    DigiContainerProcessor::work_t::get_input(bool exc)  const;
+template       DepositView*      DigiContainerProcessor::work_t::get_input(bool exc);
+template const DepositView*      DigiContainerProcessor::work_t::get_input(bool exc)  const;
 template       ParticleMapping*  DigiContainerProcessor::work_t::get_input(bool exc);
 template const ParticleMapping*  DigiContainerProcessor::work_t::get_input(bool exc)  const;
 template       DetectorHistory*  DigiContainerProcessor::work_t::get_input(bool exc);
@@ -85,16 +91,73 @@ std::string DigiContainerProcessor::work_t::input_type_name()  const   {
 
 /// Access to default callback 
 const DigiContainerProcessor::predicate_t& DigiContainerProcessor::accept_all()  {
-  static predicate_t s_pred { std::bind(predicate_t::always_true, std::placeholders::_1), 0, nullptr };
+  static predicate_t s_pred { predicate_t::always_true, 0, nullptr };
   return s_pred;
 }
 
 /// Access to default callback 
 const DigiContainerProcessor::predicate_t& DigiContainerProcessor::accept_not_killed()  {
-  static predicate_t s_pred { std::bind(predicate_t::not_killed, std::placeholders::_1), 0, nullptr };
+  static predicate_t s_pred { predicate_t::not_killed, 0, nullptr };
   return s_pred;
 }
 
+/// Evaluate the predicate for all deposits of an array container
+std::size_t DigiContainerProcessor::predicate_t::select(const DepositArrays& deposits, std::vector<uint8_t>& selected)   const  {
+  using function_t = bool (*)(const deposit_t&);
+  const std::size_t len = deposits.size();
+  const function_t* func = this->callback.target<function_t>();
+  std::size_t count = 0;
+
+  selected.resize(len);
+  uint8_t* sel = selected.data();
+  /// The default predicates only look at the flags: no need to build deposits
+  if ( func && *func == predicate_t::always_true )   {
+    std::fill(sel, sel+len, 1);
+    return len;
+  }
+  else if ( func && *func == predicate_t::not_killed )   {
+    const uint64_t* flag = deposits.flag.data();
+    for( std::size_t i = 0; i < len; ++i )   {
+      sel[i] = 0 == (flag[i]&EnergyDeposit::KILLED);
+      count += sel[i];
+    }
+    return count;
+  }
+  for( std::size_t i = 0; i < len; ++i )   {
+    sel[i] = this->callback(deposit_t(deposits.cell[i], deposits.at(i)));
+    count += sel[i];
+  }
+  return count;
+}
+
+/// Evaluate the predicate for all deposits of a deposit view. Returns the number of selected entries
+std::size_t DigiContainerProcessor::predicate_t::select(const DepositView& deposits, std::vector<uint8_t>& selected)   const  {
+  using function_t = bool (*)(const deposit_t&);
+  const std::size_t len = deposits.size();
+  const function_t* func = this->callback.target<function_t>();
+  std::size_t count = 0;
+
+  selected.resize(len);
+  uint8_t* sel = selected.data();
+  /// The default predicates only look at the flags: no need to materialize deposits
+  if ( func && *func == predicate_t::always_true )   {
+    std::fill(sel, sel+len, 1);
+    return len;
+  }
+  else if ( func && *func == predicate_t::not_killed )   {
+    for( std::size_t i = 0; i < len; ++i )   {
+      sel[i] = 0 == (deposits.flag(i)&EnergyDeposit::KILLED);
+      count += sel[i];
+    }
+    return count;
+  }
+  for( std::size_t i = 0; i < len; ++i )   {
+    sel[i] = this->callback(deposit_t(deposits.cell(i), deposits.get(i)));
+    count += sel[i];
+  }
+  return count;
+}
+
 /// Standard constructor
 DigiContainerProcessor::DigiContainerProcessor(const kernel_t& kernel, const std::string& name)   
   : DigiAction(kernel, name)
@@ -126,6 +189,26 @@ void DigiDepositsProcessor::execute(context_t& context, work_t& work, const pred
     m_handleVector(context,  *vector_data, work, predicate);
   else if ( auto* mapped_data = work.get_input<DepositMapping>() )
     m_handleMapping(context, *mapped_data, work, predicate);
+  else if ( auto* array_data = m_handleArrays ? work.get_input<DepositArrays>() : nullptr )
+    m_handleArrays(context,  *array_data, work, predicate);
+  else if ( auto* view_data = work.get_input<DepositView>() )   {
+    if ( m_handleView )   {
+      m_handleView(context, *view_data, work, predicate);
+      return;
+    }
+    /// Processor without view support: the view is demoted once to a deposit vector,
+    /// which replaces the view in the input segment. Following processors use the vector.
+    std::size_t num_entries = view_data->size();
+    DepositVector deposits(view_data->name, view_data->key.mask(), view_data->data_type);
+    deposits.reserve(num_entries);
+    view_data->fill(deposits);
+    if ( !work.input.segment || !work.input.segment->replace(work.input_key(), std::move(deposits)) )   {
+      except("+++ Cannot replace deposit view %s by a deposit vector.", Key::key_name(work.input_key()).c_str());
+    }
+    info("+++ Demoted deposit view %s [%ld entries] to a deposit vector. [No view support]",
+         Key::key_name(work.input_key()).c_str(), num_entries);
+    m_handleVector(context, *work.get_input<DepositVector>(true), work, predicate);
+  }
   else
     except("Request to handle unknown data type: %s", work.input_type_name().c_str());
 }
@@ -169,6 +252,7 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
 				    std::size_t,
 				    DigiContainerSequence&>::execute(void* data) const  {
   calldata_t* arg  = reinterpret_cast<calldata_t*>(data);
+  DigiProfiler::count(*arg->input.data);
   action->execute(arg->environ.context, *arg, predicate.m_worker_predicate);
 }
 
@@ -194,7 +278,9 @@ DigiContainerSequenceAction::~DigiContainerSequenceAction() {
 void dd4hep::digi::DigiContainerSequenceAction::initialize()   {
   for( auto& ent : m_registered_processors )   {
     worker_t* w = new worker_t(ent.second, m_registered_workers.size(), *this);
+    Key key(ent.first);
     m_registered_workers.emplace(ent.first, w);
+    m_slot_workers.emplace_back(DataSlot(key.set_mask(m_input_mask)), w);
     m_workers.insert(w);
     ent.second->release();
   }
@@ -202,6 +288,7 @@ void dd4hep::digi::DigiContainerSequenceAction::initialize()   {
 
 /// Finalization callback
 void dd4hep::digi::DigiContainerSequenceAction::finalize()    {
+  m_slot_workers.clear();
   m_workers.clear();
 }
 
@@ -258,6 +345,14 @@ DigiContainerSequenceAction::need_registered_worker(Key key, bool exc)   const
   return nullptr;
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiContainerSequenceAction::data_flow(data_items_t& /* inputs */, data_items_t& outputs)  const   {
+  /// Processors may modify the input containers
+  outputs.emplace_back(data_item_t{ m_input_segment,  m_input_mask  });
+  outputs.emplace_back(data_item_t{ m_output_segment, m_output_mask });
+  return true;
+}
+
 /// Main functional callback if specific work is known
 void DigiContainerSequenceAction::execute(context_t& context)  const   {
   std::vector<ParallelWorker*> event_workers;
@@ -271,14 +366,12 @@ void DigiContainerSequenceAction::execute(context_t& context)  const   {
   work_t      arg { env, items, *this };
 
   arg.input_items.resize(m_workers.size(), itm);
-  event_workers.reserve(input.size());
-  for( auto& i : input )   {
-    Key key(i.first);
-    if ( key.mask() == m_input_mask )   {
-      if ( worker_t* w = need_registered_worker(key, false) )  {
-	event_workers.emplace_back(w);
-	arg.input_items[w->options] = { &input, key, &i.second };
-      }
+  event_workers.reserve(m_slot_workers.size());
+  for( const auto& s : m_slot_workers )   {
+    if ( auto* i = input.item(s.first) )   {
+      worker_t* w = s.second;
+      event_workers.emplace_back(w);
+      arg.input_items[w->options] = { &input, i->first, &i->second };
     }
   }
   if ( !event_workers.empty() )   {
@@ -294,6 +387,7 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
   auto* args = reinterpret_cast<calldata_t*>(data);
   auto& item = args->input_items[this->options];
   DigiContainerProcessor::work_t work { args->environ, item };
+  DigiProfiler::count(*item.data);
   action->execute(args->environ.context, work, predicate.m_worker_predicate);
 }
 
@@ -387,6 +481,17 @@ void DigiMultiContainerProcessor::adopt_processor(DigiContainerProcessor* action
   }
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiMultiContainerProcessor::data_flow(data_items_t& /* inputs */, data_items_t& outputs)  const   {
+  /// Processors may modify the input containers
+  if ( m_input_masks.empty() )
+    outputs.emplace_back(data_item_t{ m_input_segment, ANY_MASK });
+  for( int mask : m_input_masks )
+    outputs.emplace_back(data_item_t{ m_input_segment, mask });
+  outputs.emplace_back(data_item_t{ m_output_segment, m_output_mask });
+  return true;
+}
+
 /// Main functional callback
 void DigiMultiContainerProcessor::execute(context_t& context)  const  {
   work_items_t items;
@@ -432,11 +537,13 @@ template <> void DigiParallelWorker<DigiContainerProcessor,
       tag = "mask accepted";
       if ( keys.empty() )  {
 	DigiContainerProcessor::work_t  work { arg->environ, item };
+	DigiProfiler::count(*item.data);
 	action->execute(work.environ.context, work, predicate.m_worker_predicate);
 	continue;
       }
       else if ( std::find(keys.begin(), keys.end(), key) != keys.end() )    {
 	DigiContainerProcessor::work_t work { arg->environ, item };
+	DigiProfiler::count(*item.data);
 	action->execute(work.environ.context, work, predicate.m_worker_predicate);
 	continue;
       }
@@ -35,6 +35,12 @@ DigiContext::~DigiContext() {
   InstanceCount::decrement(this);
 }
 
+/// Counter based random stream of this event identified by a key
+DigiRandomStream DigiContext::randomStream(std::uint64_t key)  const   {
+  std::uint64_t seed = DigiRandomStream::combine(kernel.random_seed(), event->eventNumber);
+  return DigiRandomStream(seed, key);
+}
+
 /// Have a shared initializer lock
 std::mutex& DigiContext::initializer_lock()  const  {
   return kernel.initializer_lock();
@@ -20,6 +20,7 @@
 
 // C/C++ include files
 #include <mutex>
+#include <algorithm>
 
 namespace   {
   struct digi_keys   {
@@ -30,6 +31,16 @@ namespace   {
     static digi_keys k;
     return k;
   }
+  struct digi_slots   {
+    std::mutex  lock;
+    std::map<dd4hep::digi::Key::key_type, dd4hep::digi::DataSlot::index_t> map;
+    std::shared_ptr<const dd4hep::digi::DataSlot::table_t> table
+    { std::make_shared<const dd4hep::digi::DataSlot::table_t>() };
+  };
+  digi_slots& slots()  {
+    static digi_slots s;
+    return s;
+  }
 }
 
 using namespace dd4hep::digi;
@@ -224,6 +235,47 @@ std::size_t DepositVector::insert(const DepositMapping& updates)    {
   return update_size;
 }
 
+/// Merge shared pile-up deposits onto existing vector (shared inputs are kept)
+std::size_t DepositVector::merge(DepositOverlay&& updates)    {
+  return this->insert(updates);
+}
+
+/// Merge shared pile-up deposits onto existing vector (keep inputs)
+std::size_t DepositVector::insert(const DepositOverlay& updates)    {
+  std::size_t update_size = updates.size();
+  std::size_t newlen = std::max(2*data.size(), data.size()+update_size);
+  data.reserve(newlen);
+  for( const auto& src : updates.sources )    {
+    for( const auto& c : *src )    {
+      EnergyDeposit depo(c.second);
+      updates.apply(depo);
+      data.emplace_back(c.first, std::move(depo));
+    }
+  }
+  return update_size;
+}
+
+/// Merge deposit view onto existing vector (the deposits are materialized)
+std::size_t DepositVector::merge(DepositView&& updates)    {
+  std::size_t update_size = updates.size();
+  std::size_t newlen = std::max(2*data.size(), data.size()+update_size);
+  data.reserve(newlen);
+  for( std::size_t i = 0; i < update_size; ++i )    {
+    if ( updates.modified_deposit(i) )
+      data.emplace_back(updates.cell(i), std::move(updates.mutate(i)));
+    else
+      data.emplace_back(updates.cell(i), updates.source->materialize(i));
+  }
+  return update_size;
+}
+
+/// Merge deposit view onto existing vector (keep inputs)
+std::size_t DepositVector::insert(const DepositView& updates)    {
+  std::size_t newlen = std::max(2*data.size(), data.size()+updates.size());
+  data.reserve(newlen);
+  return updates.fill(*this);
+}
+
 /// Access energy deposit by key
 const EnergyDeposit& DepositVector::get(CellID cell)   const    {
   for( const auto& c : data )    {
@@ -405,10 +457,23 @@ std::size_t DetectorHistory::insert(const DetectorHistory& updates)   {
 DataSegment::DataSegment(std::mutex& l, Key::segment_type i)
   : data(), lock(l), id(i)
 {
+  m_slot_keys = DataSlot::table();
+  m_num_slots = m_slot_keys->size();
+  m_slots = std::make_unique<slot_t[]>(m_num_slots);
 }
 
-/// Remove data item from segment
+/// Slot index of a key known to the segment (lock-free)
+DataSlot::index_t DataSegment::slot_index(Key key)  const   {
+  return m_num_slots > 0 ? DataSlot::find(*m_slot_keys, key) : DataSlot::INVALID;
+}
+
+/// Emplace data item (locked)
 bool DataSegment::emplace_any(Key key, std::any&& item)    {
+  return this->emplace_item(key, std::move(item), nullptr);
+}
+
+/// Emplace data item and publish it to the slot table (locked)
+bool DataSegment::emplace_item(Key key, std::any&& item, void* (*address)(std::any*))    {
   bool has_value = item.has_value();
 #if DD4HEP_DDDIGI_DEBUG
   printout(INFO, "DataSegment", "PUT Key No.%4d: %-32s %016lX -> %04X %04X %08Xld Value:%s  %s",
@@ -416,12 +481,169 @@ bool DataSegment::emplace_any(Key key, std::any&& item)    {
 	   yes_no(has_value), digiTypeName(item.type()).c_str());
 #endif
   std::lock_guard<std::mutex> l(lock);
-  bool ret = data.emplace(key, std::move(item)).second;
-  if ( !ret )   {
+  auto ret = data.emplace(key, std::move(item));
+  if ( !ret.second )   {
     except("DataSegment","Error in DataSegment map. Duplicate ID: segment:%04X mask:%04X Number:%d Value:%s",
 	   key.mask(), key.item(), yes_no(has_value));
   }
-  return ret;
+  DataSlot::index_t idx = this->slot_index(key);
+  if ( idx < m_num_slots )   {
+    slot_t& s = m_slots[idx];
+    s.item    = &(*ret.first);
+    s.type    = &s.item->second.type();
+    s.object  = address ? address(&s.item->second) : nullptr;
+    s.valid.store(true, std::memory_order_release);
+  }
+  return ret.second;
+}
+
+/// Replace the data of an existing item and republish it to the slot table (locked)
+bool DataSegment::replace_item(Key key, std::any&& item, void* (*address)(std::any*))    {
+  std::lock_guard<std::mutex> l(lock);
+  auto iter = data.find(key);
+  if ( iter == data.end() )   {
+    return false;
+  }
+  DataSlot::index_t idx = this->slot_index(key);
+  slot_t* s = (idx < m_num_slots && m_slots[idx].item == &(*iter)) ? &m_slots[idx] : nullptr;
+  if ( s ) s->valid.store(false, std::memory_order_release);
+  iter->second = std::move(item);
+  if ( s )   {
+    s->type   = &iter->second.type();
+    s->object = address ? address(&iter->second) : nullptr;
+    s->valid.store(true, std::memory_order_release);
+  }
+  return true;
+}
+
+/// Emplace entry
+void DepositArrays::emplace(CellID cell_id, EnergyDeposit&& depo)   {
+  cell.emplace_back(cell_id);
+  deposit.emplace_back(depo.deposit);
+  depositError.emplace_back(depo.depositError);
+  time.emplace_back(depo.time);
+  length.emplace_back(depo.length);
+  position.emplace_back(depo.position);
+  momentum.emplace_back(depo.momentum);
+  flag.emplace_back(depo.flag);
+  mask.emplace_back(depo.mask);
+  history.emplace_back(std::move(depo.history));
+}
+
+/// Emplace entry
+void DepositArrays::emplace(CellID cell_id, const EnergyDeposit& depo)   {
+  cell.emplace_back(cell_id);
+  deposit.emplace_back(depo.deposit);
+  depositError.emplace_back(depo.depositError);
+  time.emplace_back(depo.time);
+  length.emplace_back(depo.length);
+  position.emplace_back(depo.position);
+  momentum.emplace_back(depo.momentum);
+  flag.emplace_back(depo.flag);
+  mask.emplace_back(depo.mask);
+  history.emplace_back(depo.history);
+}
+
+/// Reserve space for a given number of entries
+void DepositArrays::reserve(std::size_t len)   {
+  cell.reserve(len);
+  deposit.reserve(len);
+  depositError.reserve(len);
+  time.reserve(len);
+  length.reserve(len);
+  position.reserve(len);
+  momentum.reserve(len);
+  flag.reserve(len);
+  mask.reserve(len);
+  history.reserve(len);
+}
+
+/// Remove all entries
+void DepositArrays::clear()   {
+  cell.clear();
+  deposit.clear();
+  depositError.clear();
+  time.clear();
+  length.clear();
+  position.clear();
+  momentum.clear();
+  flag.clear();
+  mask.clear();
+  history.clear();
+}
+
+/// Append deposit vector (keep inputs)
+std::size_t DepositArrays::insert(const DepositVector& updates)   {
+  this->reserve(size()+updates.size());
+  for( const auto& c : updates )
+    this->emplace(c.first, c.second);
+  return updates.size();
+}
+
+/// Append deposit mapping (keep inputs)
+std::size_t DepositArrays::insert(const DepositMapping& updates)   {
+  this->reserve(size()+updates.size());
+  for( const auto& c : updates )
+    this->emplace(c.first, c.second);
+  return updates.size();
+}
+
+/// Append all deposits to a deposit vector
+std::size_t DepositArrays::fill(DepositVector& output)  const   {
+  for( std::size_t i = 0, n = size(); i < n; ++i )
+    output.emplace(cell[i], this->at(i));
+  return size();
+}
+
+/// Access energy deposit by index (Copies all attributes)
+EnergyDeposit DepositArrays::at(std::size_t entry)   const   {
+  EnergyDeposit depo;
+  depo.position     = position.at(entry);
+  depo.momentum     = momentum[entry];
+  depo.length       = length[entry];
+  depo.deposit      = deposit[entry];
+  depo.depositError = depositError[entry];
+  depo.time         = time[entry];
+  depo.flag         = flag[entry];
+  depo.mask         = mask[entry];
+  depo.history      = history[entry];
+  return depo;
+}
+
+/// Access number of deposits of all sources
+std::size_t DepositOverlay::size()  const    {
+  std::size_t len = 0;
+  for( const auto& src : sources )
+    len += src->size();
+  return len;
+}
+
+/// Write access to an entry: the deposit is materialized on first access
+EnergyDeposit& DepositView::mutate(std::size_t entry)   {
+  if ( this->modified.empty() )   {
+    this->modified.resize(this->size(), 0);
+  }
+  uint32_t& idx = this->modified.at(entry);
+  if ( 0 == idx )   {
+    this->materialized.emplace_back(this->source->cell(entry), this->source->materialize(entry));
+    idx = uint32_t(this->materialized.size());
+  }
+  return this->materialized[idx-1].second;
+}
+
+/// Copy of the deposit of an entry (materialized if not modified)
+EnergyDeposit DepositView::get(std::size_t entry)  const   {
+  if ( const EnergyDeposit* depo = this->modified_deposit(entry) )
+    return *depo;
+  return this->source->materialize(entry);
+}
+
+/// Append all deposits to a deposit vector
+std::size_t DepositView::fill(DepositVector& output)  const   {
+  std::size_t len = this->size();
+  for( std::size_t i = 0; i < len; ++i )
+    output.emplace(this->cell(i), this->get(i));
+  return len;
 }
 
 /// Access  data size
@@ -432,6 +654,9 @@ std::size_t DataParameters::size()  const    {
 template bool DataSegment::put(Key key, DataParameters&& data);
 template bool DataSegment::put(Key key, DepositVector&& data);
 template bool DataSegment::put(Key key, DepositMapping&& data);
+template bool DataSegment::put(Key key, DepositArrays&& data);
+template bool DataSegment::put(Key key, DepositOverlay&& data);
+template bool DataSegment::put(Key key, DepositView&& data);
 template bool DataSegment::put(Key key, ParticleMapping&& data);
 template bool DataSegment::put(Key key, DetectorHistory&& data);
 template bool DataSegment::put(Key key, DetectorResponse&& data);
@@ -441,6 +666,9 @@ bool DataSegment::erase(Key key)    {
   std::lock_guard<std::mutex> l(lock);
   auto iter = data.find(key);
   if ( iter != data.end() )   {
+    DataSlot::index_t idx = this->slot_index(key);
+    if ( idx < m_num_slots && m_slots[idx].item == &(*iter) )
+      m_slots[idx].valid.store(false, std::memory_order_release);
     data.erase(iter);
     return true;
   }
@@ -454,6 +682,9 @@ std::size_t DataSegment::erase(const std::vector<Key>& keys)   {
   for(const auto& key : keys)   {
     auto iter = data.find(key);
     if ( iter != data.end() )   {
+      DataSlot::index_t idx = this->slot_index(key);
+      if ( idx < m_num_slots && m_slots[idx].item == &(*iter) )
+	m_slots[idx].valid.store(false, std::memory_order_release);
       data.erase(iter);
       ++count;
     }
@@ -510,6 +741,84 @@ const std::any* DataSegment::get_item(Key key, bool exc)  const   {
   return nullptr;
 }
 
+/// Access published slot entry
+const DataSegment::slot_t* DataSegment::get_slot(const DataSlot& slot)  const   {
+  if ( slot.index() < m_num_slots )   {
+    const slot_t& s = m_slots[slot.index()];
+    if ( s.valid.load(std::memory_order_acquire) ) return &s;
+  }
+  return nullptr;
+}
+
+/// Access data by slot. If not existing, nullptr is returned
+std::any* DataSegment::entry(const DataSlot& slot)   {
+  if ( slot.index() < m_num_slots )   {
+    const slot_t* s = this->get_slot(slot);
+    return s ? &s->item->second : nullptr;
+  }
+  return this->get_item(slot.key(), false);
+}
+
+/// Access data by slot. If not existing, nullptr is returned
+const std::any* DataSegment::entry(const DataSlot& slot)  const   {
+  if ( slot.index() < m_num_slots )   {
+    const slot_t* s = this->get_slot(slot);
+    return s ? &s->item->second : nullptr;
+  }
+  return this->get_item(slot.key(), false);
+}
+
+/// Access data item (key and data) by slot. If not existing, nullptr is returned
+DataSegment::value_type* DataSegment::item(const DataSlot& slot)   {
+  if ( slot.index() < m_num_slots )   {
+    const slot_t* s = this->get_slot(slot);
+    return s ? s->item : nullptr;
+  }
+  Key key(slot.key());
+  auto it = this->data.find(key);
+  if ( it != this->data.end() ) return &(*it);
+  it = this->data.find(key.set_segment(0x0));
+  return it != this->data.end() ? &(*it) : nullptr;
+}
+
+/// Initializing constructor: register the key (if not yet registered)
+DataSlot::DataSlot(Key k) : m_key(k)   {
+  auto& s = slots();
+  std::lock_guard<std::mutex> lock(s.lock);
+  k.set_segment(0x0);
+  auto ret = s.map.emplace(k.value(), index_t(s.map.size()));
+  this->m_index = ret.first->second;
+  if ( ret.second )   {
+    // Publish a new snapshot. Segments keep the snapshot they were created with
+    s.table = std::make_shared<const table_t>(s.map.begin(), s.map.end());
+  }
+}
+
+/// Access the slot index of a registered key. Returns INVALID if the key is not registered
+DataSlot::index_t DataSlot::find(Key key)   {
+  return find(*table(), key);
+}
+
+/// Access the slot index of a key in a registry snapshot (lock-free). Returns INVALID if not registered
+DataSlot::index_t DataSlot::find(const table_t& table, Key key)   {
+  Key::key_type k = key.set_segment(0x0).value();
+  auto it = std::lower_bound(table.begin(), table.end(), k,
+                             [](const table_t::value_type& e, Key::key_type v) { return e.first < v; });
+  return it != table.end() && it->first == k ? it->second : INVALID;
+}
+
+/// Number of registered slots
+std::size_t DataSlot::count()   {
+  return table()->size();
+}
+
+/// Access the current snapshot of the registry
+std::shared_ptr<const DataSlot::table_t> DataSlot::table()   {
+  auto& s = slots();
+  std::lock_guard<std::mutex> lock(s.lock);
+  return s.table;
+}
+
 /// Intializing constructor
 DigiEvent::DigiEvent()
 {
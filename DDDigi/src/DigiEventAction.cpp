@@ -35,3 +35,7 @@ bool dd4hep::digi::DigiEventAction::setExecuteParallel(bool new_value)    {
   return old;
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool dd4hep::digi::DigiEventAction::data_flow(data_items_t& /* inputs */, data_items_t& /* outputs */)  const   {
+  return false;
+}
@@ -86,6 +86,12 @@ bool DigiInputAction::object_loading_is_enabled(const std::string& nam)  const
   return false;
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiInputAction::data_flow(data_items_t& /* inputs */, data_items_t& outputs)  const   {
+  outputs.emplace_back(data_item_t{ m_input_segment, m_input_mask });
+  return true;
+}
+
 /// Pre-track action callback
 void DigiInputAction::execute(DigiContext& /* context */)  const   {
   info("+++ Virtual method execute() --- Should not be called");
@@ -21,6 +21,8 @@
 
 #include <DDDigi/DigiKernel.h>
 #include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiProfiler.h>
+#include <DDDigi/DigiScheduler.h>
 #include <DDDigi/DigiActionSequence.h>
 #include <DDDigi/DigiMonitorHandler.h>
 
@@ -34,10 +36,12 @@ namespace tbb {  struct global_control { enum { max_allowed_parallelism = -1 };
 #include <TRandom.h>
 
 // C/C++ include files
+#include <condition_variable>
 #include <stdexcept>
 #include <algorithm>
 #include <memory>
 #include <chrono>
+#include <map>
 
 using namespace dd4hep::digi;
 
@@ -71,6 +75,17 @@ public:
   /// Lock for global output logging
   std::mutex            global_output_lock  { };
 
+  /// Lock to protect the output reorder buffer
+  std::mutex            output_lock         { };
+  /// Signal space in the output reorder buffer
+  std::condition_variable output_space      { };
+  /// Output reorder buffer: events waiting for their predecessors to be written
+  std::map<int, std::unique_ptr<DigiContext> > output_buffer { };
+  /// Number of the next event to be written
+  int                   next_output         { 1 };
+  /// Flag if a thread is writing the events of the reorder buffer
+  bool                  output_draining     { false };
+
   using callbacks_t    = std::vector<std::function<void()> >;
   using ev_callbacks_t = std::vector<std::function<void(DigiContext&)> >;
 
@@ -93,11 +108,15 @@ public:
   DigiActionSequence*   output_action        { nullptr };
   /// The histogram handler entity
   DigiMonitorHandler*   monitor_handler    { nullptr };
+  /// The timing instrumentation of the actions
+  DigiProfiler*         profiler           { nullptr };
 
   /// Random generator
   TRandom* root_random;
   /// Shared random number generator
   std::shared_ptr<DigiRandomGenerator> random  { };
+  /// Data flow scheduler of the event actions (if enabled)
+  std::unique_ptr<DigiScheduler> scheduler { };
   /// TBB initializer (If TBB is used)
   std::unique_ptr<tbb::global_control> tbb_init { };
   /// Property: Output level
@@ -110,6 +129,14 @@ public:
   int                   num_threads;
   /// Property: Allow to stop execution from interactive prompt
   bool                  stop = false;
+  /// Property: Seed of the counter based random streams
+  long                  random_seed = 0;
+  /// Property: Schedule the event actions according to their data dependencies
+  bool                  data_flow = false;
+  /// Property: Write the events in the order of the event numbers
+  bool                  ordered_output = false;
+  /// Flag if the output actions are part of the data flow graph
+  bool                  output_scheduled = false;
 
 public:
   /// Default constructor
@@ -133,12 +160,18 @@ template<typename ACTION, typename ARG> class DigiKernel::Wrapper  {
 public:
   ACTION*  action = 0;
   ARG   context;
-  Wrapper(ACTION* a, ARG c) : action(a), context(c) {}
+  DigiProfiler* profiler = 0;
+  const DigiAction* caller = 0;
+  int   event = 0;
+  Wrapper(ACTION* a, ARG c, DigiProfiler* p, const DigiAction* call, int e)
+    : action(a), context(c), profiler(p), caller(call), event(e) {}
   Wrapper(Wrapper&& copy) = default;
   Wrapper(const Wrapper& copy) = default;
   Wrapper& operator=(Wrapper&& copy) = delete;
   Wrapper& operator=(const Wrapper& copy) = delete;
   void operator()() const {
+    const DigiAction* worker = action->worker_action();
+    DigiProfiler::probe_t probe(profiler, worker, worker == caller, event);
     action->execute(context);
   }
 };
@@ -160,6 +193,13 @@ public:
     int todo = 1;
     while( todo >= 0 )   {
       todo = -1;
+      if ( kernel.internals->ordered_output )   {
+        /// Limit the number of events waiting in the output reorder buffer
+        std::size_t max_buffered = std::max(1, kernel.internals->maxEventsParallel);
+        std::unique_lock<std::mutex> lock(kernel.internals->output_lock);
+        kernel.internals->output_space.wait(lock, [this, max_buffered] {
+            return kernel.internals->output_buffer.size() < max_buffered;  });
+      }
       {
         std::lock_guard<std::mutex> lock(kernel.internals->counter_lock);
         if( !kernel.internals->stop && kernel.internals->events_todo > 0)
@@ -186,10 +226,17 @@ DigiKernel::DigiKernel(Detector& description_ref)
   declareProperty("numThreads",       internals->num_threads);
   declareProperty("numEvents",        internals->numEvents = 10);
   declareProperty("stop",             internals->stop = false);
+  declareProperty("randomSeed",       internals->random_seed = 0);
+  declareProperty("dataFlow",         internals->data_flow = false);
+  declareProperty("orderedOutput",    internals->ordered_output = false);
   declareProperty("OutputLevels",     internals->clientLevels);
   auto* h = new DigiMonitorHandler(*this, "MonitorData");
   properties().add("MonitorOutput", h->property("MonitorOutput"));
   internals->monitor_handler = h;
+  auto* p = new DigiProfiler(*this, "Profiler");
+  properties().add("Profile",      p->property("enable"));
+  properties().add("ProfileTrace", p->property("trace_file"));
+  internals->profiler = p;
 
   internals->input_action  = new DigiActionSequence(*this, "InputAction");
   internals->event_action  = new DigiActionSequence(*this, "EventAction");
@@ -207,7 +254,9 @@ DigiKernel::DigiKernel(Detector& description_ref)
 DigiKernel::~DigiKernel() {
   std::lock_guard<std::mutex> lock(Internals::kernel_mutex);
   internals->tbb_init.reset();
+  internals->scheduler.reset();
   detail::releasePtr(internals->monitor_handler);
+  detail::releasePtr(internals->profiler);
   detail::releasePtr(internals->output_action);
   detail::releasePtr(internals->event_action);
   detail::releasePtr(internals->input_action);
@@ -229,6 +278,16 @@ DigiKernel& DigiKernel::instance(Detector& description) {
   return *(s_main_instance.get());
 }
 
+/// Access the seed of the counter based random streams
+std::uint64_t DigiKernel::random_seed()  const   {
+  return internals->random_seed;
+}
+
+/// Access the timing instrumentation. Returns null if disabled
+DigiProfiler* DigiKernel::profiler()  const   {
+  return internals->profiler->enabled() ? internals->profiler : nullptr;
+}
+
 /// Have a shared initializer lock
 std::mutex& DigiKernel::initializer_lock()   const  {
   return internals->initializer_lock;
@@ -368,6 +427,12 @@ void DigiKernel::register_monitor(DigiAction* action, TNamed* object)  const
 /// Submit a bunch of actions to be executed in parallel
 void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[], std::size_t count, void* data, bool parallel)  const    {
   const char* tag = context.event->id();
+  DigiProfiler* prof = profiler();
+  int event = context.event->eventNumber;
+  /// Workers of the calling action are accounted separately
+  const DigiAction* caller = prof ? DigiProfiler::current_action() : nullptr;
+  /// The time waiting for the workers is excluded from the caller
+  DigiProfiler::probe_t wait_probe(prof, nullptr, false, event);
 #ifdef DD4HEP_USE_TBB
   bool para = parallel && (internals->tbb_init && internals->num_threads > 0);
   if ( para )   {
@@ -375,7 +440,7 @@ void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[],
     info("%s+++ Executing chunk of %3ld execution entries in parallel", tag, count);
     try   {
       for( std::size_t i=0; i<count && !internals->stop; ++i)
-	que.run( Wrapper<ParallelCall,void*>(algorithms[i], data) );
+	que.run( Wrapper<ParallelCall,void*>(algorithms[i], data, prof, caller, event) );
       que.wait();
     }
     catch(const std::exception& e)    {
@@ -391,7 +456,7 @@ void DigiKernel::submit (DigiContext& context, ParallelCall*const algorithms[],
 #endif
   info("%s+++ Executing chunk of %3ld execution entries sequentially", tag, count);
   for( std::size_t i=0; i<count; ++i)
-    algorithms[i]->execute(data);
+    Wrapper<ParallelCall,void*>(algorithms[i], data, prof, caller, event)();
 }
 
 /// Submit a bunch of actions to be executed in parallel
@@ -406,11 +471,45 @@ void DigiKernel::wait(DigiContext& context)   const  {
 /// Execute one single event
 void DigiKernel::executeEvent(std::unique_ptr<DigiContext>&& context)    {
   DigiContext& refContext = *context;
+  int event_number = refContext.event->eventNumber;
   try {
     for(auto& call : internals->start_event) call(refContext);
-    inputAction().execute(refContext);
-    eventAction().execute(refContext);
-    outputAction().execute(refContext);
+    if ( internals->scheduler )   {
+      internals->scheduler->execute(refContext);
+    }
+    else   {
+      DigiProfiler* prof = profiler();
+      {
+        DigiProfiler::probe_t probe(prof, &inputAction(), false, event_number);
+        inputAction().execute(refContext);
+      }
+      {
+        DigiProfiler::probe_t probe(prof, &eventAction(), false, event_number);
+        eventAction().execute(refContext);
+      }
+    }
+  }
+  catch(const std::exception& e)   {
+    notify(std::move(context), e);
+    if ( internals->ordered_output )   {
+      writeOrdered(event_number, nullptr);
+    }
+    return;
+  }
+  if ( internals->ordered_output )
+    writeOrdered(event_number, std::move(context));
+  else
+    finishEvent(std::move(context));
+}
+
+/// Execute the output actions of one single event and release the event
+void DigiKernel::finishEvent(std::unique_ptr<DigiContext>&& context)    {
+  DigiContext& refContext = *context;
+  try {
+    if ( !internals->output_scheduled )   {
+      DigiProfiler::probe_t probe(profiler(), &outputAction(), false, refContext.event->eventNumber);
+      outputAction().execute(refContext);
+    }
     for(auto& call : internals->end_event) call(refContext);
     notify(std::move(context));
   }
@@ -419,6 +518,34 @@ void DigiKernel::executeEvent(std::unique_ptr<DigiContext>&& context)    {
   }
 }
 
+/// Write events in the order of the event numbers using a reorder buffer
+void DigiKernel::writeOrdered(int event_number, std::unique_ptr<DigiContext>&& context)    {
+  std::unique_lock<std::mutex> lock(internals->output_lock);
+  internals->output_buffer.emplace(event_number, std::move(context));
+  if ( internals->output_draining )   {
+    /// The thread writing the buffer will pick up the event
+    return;
+  }
+  internals->output_draining = true;
+  while( true )   {
+    auto iter = internals->output_buffer.find(internals->next_output);
+    if ( iter == internals->output_buffer.end() )   {
+      break;
+    }
+    std::unique_ptr<DigiContext> ctxt = std::move(iter->second);
+    internals->output_buffer.erase(iter);
+    ++internals->next_output;
+    lock.unlock();
+    /// Failed events leave an empty entry to release their successors
+    if ( ctxt )   {
+      finishEvent(std::move(ctxt));
+    }
+    internals->output_space.notify_all();
+    lock.lock();
+  }
+  internals->output_draining = false;
+}
+
 /// Notify kernel that the execution of one single event finished
 void DigiKernel::notify(std::unique_ptr<DigiContext>&& context)   {
   if ( context )   {
@@ -444,7 +571,24 @@ int DigiKernel::run()   {
   internals->events_finished = 0;
   internals->events_submitted = 0;
   internals->events_todo = internals->numEvents;
+  /// Event numbers start at 1 (see Processor)
+  internals->next_output = 1;
+  internals->output_buffer.clear();
   info("+++ Total number of events:    %d",internals->numEvents);
+  if ( internals->data_flow && !internals->scheduler )   {
+    auto scheduler = std::make_unique<DigiScheduler>(*this);
+    scheduler->add(inputAction());
+    scheduler->add(eventAction());
+    /// Ordered output is written by the reorder buffer
+    internals->output_scheduled = !internals->ordered_output;
+    if ( internals->output_scheduled )   {
+      scheduler->add(outputAction());
+    }
+    scheduler->build();
+    internals->scheduler = std::move(scheduler);
+  }
+  info("+++ Data flow scheduling:      %s",yes_no(internals->data_flow));
+  info("+++ Ordered output:            %s",yes_no(internals->ordered_output));
 #ifdef DD4HEP_USE_TBB
   if ( !internals->tbb_init && internals->num_threads > 0 )   {
       using ctrl_t = tbb::global_control;
@@ -493,7 +637,11 @@ int DigiKernel::run()   {
 /// Terminate the digitization: call all registered terminators and release the allocated resources
 int DigiKernel::terminate() {
   info("++ Saving monitoring quantities.");
+  internals->profiler->save();
   internals->monitor_handler->save();
+  if ( internals->scheduler )   {
+    internals->scheduler->print_statistics();
+  }
   info("++ Terminate Digi and delete associated actions.");
   for(auto& call : internals->terminators) call();
   m_detDesc->destroyInstance();
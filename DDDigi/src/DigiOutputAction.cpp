@@ -110,6 +110,12 @@ void DigiOutputAction::adopt_processor(DigiContainerProcessor* action,
   DigiContainerSequenceAction::adopt_processor(action, containers);
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiOutputAction::data_flow(data_items_t& inputs, data_items_t& /* outputs */)  const   {
+  inputs.emplace_back(data_item_t{ m_input_segment, m_input_mask });
+  return true;
+}
+
 /// Pre-track action callback
 void DigiOutputAction::execute(DigiContext& context)  const   {
   std::lock_guard<std::mutex> lock(context.global_io_lock());
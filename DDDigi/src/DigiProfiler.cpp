@@ -0,0 +1,259 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiData.h>
+#include <DDDigi/DigiProfiler.h>
+
+/// ROOT include files
+#include <TH1D.h>
+
+/// C/C++ include files
+#include <ctime>
+#include <atomic>
+#include <fstream>
+#include <algorithm>
+
+using namespace dd4hep::digi;
+
+namespace {
+  /// Counter to give each profiler instance a unique identifier
+  std::atomic<std::size_t> s_num_instances { 0 };
+  /// Innermost probe of the current thread
+  thread_local DigiProfiler::probe_t*       s_top_probe   { nullptr };
+  /// Identifier of the profiler instance owning the cached thread data
+  thread_local std::size_t                  s_instance    { 0 };
+  /// Cached data of the current thread
+  thread_local DigiProfiler::thread_data_t* s_thread_data { nullptr };
+
+  /// CPU time of the current thread in seconds
+  double thread_cpu_time()   {
+    struct timespec ts;
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return double(ts.tv_sec) + 1e-9 * double(ts.tv_nsec);
+  }
+  /// Escape a string for the JSON output
+  std::string json_escape(const std::string& str)   {
+    std::string result;
+    result.reserve(str.length());
+    for( char c : str )   {
+      if ( c == '"' || c == '\\' ) result += '\\';
+      result += c;
+    }
+    return result;
+  }
+}
+
+/// Add the counters of another thread
+void DigiProfiler::counters_t::add(const counters_t& other)   {
+  if ( name.empty() ) name = other.name;
+  calls          += other.calls;
+  wall_inclusive += other.wall_inclusive;
+  wall_exclusive += other.wall_exclusive;
+  cpu_inclusive  += other.cpu_inclusive;
+  cpu_exclusive  += other.cpu_exclusive;
+  items          += other.items;
+  bytes          += other.bytes;
+}
+
+/// Initializing constructor: start the measurement
+DigiProfiler::probe_t::probe_t(DigiProfiler* prof, const DigiAction* act, bool wrk, int evt)
+  : profiler((prof && prof->enabled()) ? prof : nullptr), action(act), worker(wrk), event(evt)
+{
+  if ( profiler )   {
+    data        = profiler->thread_data();
+    parent      = s_top_probe;
+    s_top_probe = this;
+    cpu_start   = thread_cpu_time();
+    start       = clock_t::now();
+  }
+}
+
+/// Default destructor: stop the measurement and record the call
+DigiProfiler::probe_t::~probe_t()   {
+  if ( profiler )   {
+    double wall = std::chrono::duration<double>(clock_t::now() - start).count();
+    double cpu  = thread_cpu_time() - cpu_start;
+    s_top_probe = parent;
+    if ( parent )   {
+      parent->child_wall += wall;
+      parent->child_cpu  += cpu;
+    }
+    if ( action )   {
+      auto  key = std::make_pair(action, worker);
+      auto& cnt = data->counters[key];
+      if ( cnt.name.empty() )   {
+        cnt.name = worker ? action->name() + "/workers" : action->name();
+      }
+      ++cnt.calls;
+      cnt.wall_inclusive += wall;
+      cnt.wall_exclusive += std::max(0e0, wall - child_wall);
+      cnt.cpu_inclusive  += cpu;
+      cnt.cpu_exclusive  += std::max(0e0, cpu - child_cpu);
+      cnt.items          += items;
+      cnt.bytes          += bytes;
+      if ( !profiler->m_trace_file.empty() )   {
+        double t0 = std::chrono::duration<double, std::micro>(start - profiler->m_start).count();
+        data->trace.emplace_back(trace_t{ key, event, t0, 1e6 * wall });
+      }
+    }
+  }
+}
+
+/// Standard constructor
+DigiProfiler::DigiProfiler(const DigiKernel& krnl, const std::string& nam)
+  : DigiAction(krnl, nam)
+{
+  declareProperty("enable",     m_enable = false);
+  declareProperty("trace_file", m_trace_file);
+  m_instance = ++s_num_instances;
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiProfiler::~DigiProfiler()   {
+  m_threads.clear();
+  InstanceCount::decrement(this);
+}
+
+/// Access the data of the current thread
+DigiProfiler::thread_data_t* DigiProfiler::thread_data()   {
+  if ( s_instance != m_instance )   {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_threads.emplace_back(std::make_unique<thread_data_t>());
+    s_thread_data     = m_threads.back().get();
+    s_thread_data->id = int(m_threads.size());
+    s_instance        = m_instance;
+  }
+  return s_thread_data;
+}
+
+/// Access the action of the innermost probe of the current thread
+const DigiAction* DigiProfiler::current_action()   {
+  return s_top_probe ? s_top_probe->action : nullptr;
+}
+
+/// Add processed deposits and moved bytes to the innermost probe of the current thread
+void DigiProfiler::count(std::size_t items, std::size_t bytes)   {
+  if ( s_top_probe )   {
+    s_top_probe->items += items;
+    s_top_probe->bytes += bytes;
+  }
+}
+
+/// Add the deposits of a container to the innermost probe of the current thread
+void DigiProfiler::count(const std::any& container)   {
+  if ( s_top_probe )   {
+    if ( const auto* v = std::any_cast<DepositVector>(&container) )
+      count(v->size(), v->size() * sizeof(DepositVector::value_type));
+    else if ( const auto* m = std::any_cast<DepositMapping>(&container) )
+      count(m->size(), m->size() * sizeof(DepositMapping::value_type));
+    else if ( const auto* a = std::any_cast<DepositArrays>(&container) )
+      count(a->size(), a->size() * (sizeof(CellID) + sizeof(EnergyDeposit)));
+    else if ( const auto* w = std::any_cast<DepositView>(&container) )
+      count(w->size(), w->num_materialized() * sizeof(DepositView::value_type));
+  }
+}
+
+/// Aggregate the counters of all threads
+std::map<std::pair<const DigiAction*, bool>, DigiProfiler::counters_t>
+DigiProfiler::aggregate()  const   {
+  std::map<std::pair<const DigiAction*, bool>, counters_t> result;
+  for( const auto& thr : m_threads )   {
+    for( const auto& c : thr->counters )
+      result[c.first].add(c.second);
+  }
+  return result;
+}
+
+/// Write the Chrome trace file
+void DigiProfiler::write_trace()  const   {
+  std::ofstream out(m_trace_file);
+  if ( !out.good() )   {
+    except("+++ Failed to open trace file: %s", m_trace_file.c_str());
+  }
+  std::map<std::pair<const DigiAction*, bool>, std::string> names;
+  for( const auto& c : aggregate() )
+    names[c.first] = json_escape(c.second.name);
+
+  std::size_t num_events = 0;
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for( const auto& thr : m_threads )   {
+    for( const auto& t : thr->trace )   {
+      out << (num_events++ == 0 ? "\n" : ",\n")
+          << "{\"name\":\"" << names[t.key] << "\",\"cat\":\"" << (t.key.second ? "worker" : "action")
+          << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << thr->id
+          << ",\"ts\":" << std::fixed << t.start << ",\"dur\":" << t.duration
+          << ",\"args\":{\"event\":" << t.event << "}}";
+    }
+  }
+  out << "\n]}\n";
+  info("+++ Wrote %ld trace events of %ld threads to %s",
+       num_events, m_threads.size(), m_trace_file.c_str());
+}
+
+/// Print the summary, register the monitor histograms and write the trace file
+void DigiProfiler::save()   {
+  if ( !m_enable )   {
+    return;
+  }
+  auto counters = aggregate();
+  std::vector<const counters_t*> entries;
+  for( const auto& c : counters )
+    entries.emplace_back(&c.second);
+  std::sort(entries.begin(), entries.end(),
+            [](const counters_t* a, const counters_t* b)  {  return a->wall_exclusive > b->wall_exclusive; });
+
+  info("+++ Profile of %ld actions executed by %ld threads", entries.size(), m_threads.size());
+  info("+++ %-40s %8s %12s %12s %12s %12s %12s %10s", "Action", "Calls", "Wall/call",
+       "Wall excl.", "CPU excl.", "Deposits", "Deposits/s", "MBytes");
+  for( const auto* c : entries )   {
+    double per_call = c->calls > 0 ? 1e3 * c->wall_inclusive / double(c->calls) : 0e0;
+    double rate     = c->wall_inclusive > 0e0 ? double(c->items) / c->wall_inclusive : 0e0;
+    info("+++ %-40s %8ld %9.3f ms %10.3f s %10.3f s %12ld %12.4g %10.3f",
+         c->name.c_str(), c->calls, per_call, c->wall_exclusive, c->cpu_exclusive,
+         c->items, rate, double(c->bytes) / 1024e0 / 1024e0);
+  }
+
+  /// Summary histograms: one bin per action
+  if ( !entries.empty() )   {
+    struct quantity_t { const char* name; const char* title; double (*value)(const counters_t&); };
+    const quantity_t quantities[] = {
+      { "calls",          "Number of calls",             [](const counters_t& c) { return double(c.calls);  } },
+      { "wall_inclusive", "Inclusive wall time [s]",     [](const counters_t& c) { return c.wall_inclusive; } },
+      { "wall_exclusive", "Exclusive wall time [s]",     [](const counters_t& c) { return c.wall_exclusive; } },
+      { "cpu_inclusive",  "Inclusive CPU time [s]",      [](const counters_t& c) { return c.cpu_inclusive;  } },
+      { "cpu_exclusive",  "Exclusive CPU time [s]",      [](const counters_t& c) { return c.cpu_exclusive;  } },
+      { "deposits",       "Processed deposits",          [](const counters_t& c) { return double(c.items);  } },
+      { "deposit_rate",   "Processed deposits / second",
+        [](const counters_t& c) { return c.wall_inclusive > 0e0 ? double(c.items) / c.wall_inclusive : 0e0; } },
+      { "megabytes",      "Moved data [MBytes]",
+        [](const counters_t& c) { return double(c.bytes) / 1024e0 / 1024e0; } }
+    };
+    int nbins = int(entries.size());
+    for( const auto& q : quantities )   {
+      auto* h = new TH1D(q.name, q.title, nbins, 0e0, double(nbins));
+      h->SetDirectory(nullptr);
+      for( int i = 0; i < nbins; ++i )   {
+        h->GetXaxis()->SetBinLabel(i+1, entries[i]->name.c_str());
+        h->SetBinContent(i+1, q.value(*entries[i]));
+      }
+      m_kernel.register_monitor(this, h);
+    }
+  }
+  if ( !m_trace_file.empty() )   {
+    write_trace();
+  }
+}
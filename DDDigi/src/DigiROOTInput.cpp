@@ -14,12 +14,19 @@
 // Framework include files
 #include <DD4hep/InstanceCount.h>
 #include <DDDigi/DigiROOTInput.h>
+#include <DDDigi/DigiKernel.h>
 
 // ROOT include files
 #include <TROOT.h>
 #include <TFile.h>
 #include <TTree.h>
 
+// C/C++ include files
+#include <deque>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
+
 using namespace dd4hep::digi;
 
 class DigiROOTInput::inputsource_t
@@ -58,7 +65,26 @@ public:
  */
 class DigiROOTInput::internals_t   {
 public:
-  using source_t = std::unique_ptr<inputsource_t>;
+  using source_t = std::shared_ptr<inputsource_t>;
+  using clock_t  = std::chrono::steady_clock;
+
+  /// Event read ahead of time by the I/O thread
+  class frame_t   {
+  public:
+    /// Reference to the input source (keeps the file open while frames are queued)
+    source_t    source;
+    /// Private context holding the converted data of the event
+    DigiContext context;
+    /// Entry number inside the input source
+    Long64_t    entry  { -1 };
+    /// Number of bytes read
+    std::size_t bytes  { 0 };
+    /// Initializing constructor
+    frame_t(const DigiKernel& kernel, source_t src)
+      : source(src), context(kernel, std::make_unique<DigiEvent>(int(src->entry))), entry(src->entry) {}
+  };
+  using frame_ptr_t = std::unique_ptr<frame_t>;
+
   /// Reference to parent action
   DigiROOTInput* m_parent       { nullptr };
   /// Handle to input source
@@ -66,15 +92,54 @@ public:
   /// Pointer to current input source
   int            m_curr_input   { INPUT_START };
 
+  /// Prefetch queue of ready events
+  std::deque<frame_ptr_t>  m_queue       { };
+  /// Lock protecting the prefetch queue
+  std::mutex               m_queue_lock  { };
+  /// Condition signalled when a frame was added to the queue
+  std::condition_variable  m_queue_filled  { };
+  /// Condition signalled when a frame was taken from the queue
+  std::condition_variable  m_queue_drained { };
+  /// Prefetching I/O thread
+  std::thread              m_reader      { };
+  /// Flag to stop the I/O thread
+  bool                     m_stop        { false };
+  /// Flag set when the I/O thread stopped due to a failure
+  bool                     m_failed      { false };
+  /// Failure message of the I/O thread
+  std::string              m_failure     { };
+
+  /// Prefetch statistics: number of events read ahead
+  std::size_t              m_num_frames       { 0 };
+  /// Prefetch statistics: sum of the queue depths seen by the event tasks
+  std::size_t              m_sum_depth        { 0 };
+  /// Prefetch statistics: number of event tasks waiting for data
+  std::size_t              m_consumer_stalls  { 0 };
+  /// Prefetch statistics: number of times the I/O thread waited for queue space
+  std::size_t              m_producer_stalls  { 0 };
+  /// Prefetch statistics: total waiting time of the event tasks [ms]
+  double                   m_stall_time       { 0e0 };
+
 public:
   /// Default constructor
   internals_t (DigiROOTInput* p);
   /// Default destructor
-  ~internals_t () = default;
+  ~internals_t ();
   /// Access the next valid event entry
   inputsource_t& next();
   /// Open the next input source from the input list
-  std::unique_ptr<inputsource_t> open_source();
+  source_t open_source();
+
+  /// Start the prefetching I/O thread if not yet running
+  void start();
+  /// Stop the prefetching I/O thread
+  void halt();
+  /// I/O thread: read events ahead of time into the prefetch queue
+  void run();
+  /// Read and convert the next event into a new frame
+  frame_ptr_t read_frame();
+  /// Take the next ready frame from the prefetch queue. Waits if the queue is empty
+  frame_ptr_t dequeue();
 };
 
 /// Default constructor
@@ -83,8 +148,13 @@ DigiROOTInput::internals_t::internals_t (DigiROOTInput* p)
 {
 }
 
+/// Default destructor
+DigiROOTInput::internals_t::~internals_t ()   {
+  halt();
+}
+
 /// Open the next input source from the input list
-std::unique_ptr<DigiROOTInput::inputsource_t> DigiROOTInput::internals_t::open_source()   {
+DigiROOTInput::internals_t::source_t DigiROOTInput::internals_t::open_source()   {
   const auto& inputs    = m_parent->inputs();
   const auto& tree_name = m_parent->input_section();
   int len = inputs.size();
@@ -110,7 +180,7 @@ std::unique_ptr<DigiROOTInput::inputsource_t> DigiROOTInput::internals_t::open_s
 			tree_name.c_str(), fname.c_str());
 	continue;
       }
-      auto source   = std::make_unique<inputsource_t>();
+      auto source   = std::make_shared<inputsource_t>();
       source->file  = std::move(file);
       source->tree  = tree;
       auto* branches = tree->GetListOfBranches();
@@ -146,11 +216,113 @@ DigiROOTInput::inputsource_t& DigiROOTInput::internals_t::next()   {
   return src;
 }
 
+/// Start the prefetching I/O thread if not yet running
+void DigiROOTInput::internals_t::start()   {
+  std::lock_guard<std::mutex> lock(m_queue_lock);
+  if ( !m_reader.joinable() && !m_stop )   {
+    m_reader = std::thread([this]  {  this->run();  });
+  }
+}
+
+/// Stop the prefetching I/O thread
+void DigiROOTInput::internals_t::halt()   {
+  {
+    std::lock_guard<std::mutex> lock(m_queue_lock);
+    m_stop = true;
+  }
+  m_queue_drained.notify_all();
+  if ( m_reader.joinable() )   {
+    m_reader.join();
+  }
+  m_queue.clear();
+}
+
+/// Read and convert the next event into a new frame
+DigiROOTInput::internals_t::frame_ptr_t DigiROOTInput::internals_t::read_frame()   {
+  const DigiKernel& kernel = m_parent->m_kernel;
+  frame_ptr_t frame;
+  {
+    std::lock_guard<std::mutex> lock(kernel.global_io_lock());
+    next();
+    frame = std::make_unique<frame_t>(kernel, m_source);
+  }
+  auto& context = frame->context;
+  DataSegment& segment = context.event->get_segment(m_parent->m_input_segment);
+  for( auto& b : frame->source->branches )    {
+    auto& ent = b.second;
+    Long64_t bytes = 0;
+    {
+      std::lock_guard<std::mutex> lock(kernel.global_io_lock());
+      bytes = ent.branch.GetEntry( frame->entry );
+    }
+    /// The branch buffer is only re-used by this thread: convert without I/O lock
+    if ( bytes > 0 )  {
+      work_t work { segment, ent };
+      (*m_parent)(context, work);
+      frame->bytes += bytes;
+    }
+  }
+  return frame;
+}
+
+/// I/O thread: read events ahead of time into the prefetch queue
+void DigiROOTInput::internals_t::run()   {
+  const std::size_t depth = m_parent->m_prefetch_depth;
+  try  {
+    while( 1 )   {
+      {
+	std::unique_lock<std::mutex> lock(m_queue_lock);
+	if ( !m_stop && m_queue.size() >= depth )   {
+	  ++m_producer_stalls;
+	  m_queue_drained.wait(lock, [this, depth] { return m_stop || m_queue.size() < depth; });
+	}
+	if ( m_stop ) return;
+      }
+      frame_ptr_t frame = read_frame();
+      {
+	std::lock_guard<std::mutex> lock(m_queue_lock);
+	m_queue.emplace_back(std::move(frame));
+	++m_num_frames;
+      }
+      m_queue_filled.notify_one();
+    }
+  }
+  catch(const std::exception& e)   {
+    std::lock_guard<std::mutex> lock(m_queue_lock);
+    m_failure = e.what();
+    m_failed  = true;
+  }
+  m_queue_filled.notify_all();
+}
+
+/// Take the next ready frame from the prefetch queue. Waits if the queue is empty
+DigiROOTInput::internals_t::frame_ptr_t DigiROOTInput::internals_t::dequeue()   {
+  std::unique_lock<std::mutex> lock(m_queue_lock);
+  m_sum_depth += m_queue.size();
+  if ( m_queue.empty() && !m_failed )   {
+    auto start = clock_t::now();
+    ++m_consumer_stalls;
+    m_queue_filled.wait(lock, [this] { return !m_queue.empty() || m_failed || m_stop; });
+    m_stall_time += std::chrono::duration<double, std::milli>(clock_t::now() - start).count();
+  }
+  if ( m_queue.empty() )   {
+    m_parent->except("+++ Prefetching input stopped: %s",
+		     m_failed ? m_failure.c_str() : "I/O thread terminated");
+  }
+  frame_ptr_t frame = std::move(m_queue.front());
+  m_queue.pop_front();
+  lock.unlock();
+  m_queue_drained.notify_one();
+  return frame;
+}
+
 /// Standard constructor
 DigiROOTInput::DigiROOTInput(const DigiKernel& kernel, const std::string& nam)
   : DigiInputAction(kernel, nam)
 {
   imp = std::make_unique<internals_t>(this);
+  declareProperty("prefetch", m_prefetch_depth = 0);
+  m_kernel.register_terminate(std::bind(&DigiROOTInput::finalize,this));
   InstanceCount::increment(this);
 }
 
@@ -160,13 +332,40 @@ DigiROOTInput::~DigiROOTInput()   {
   InstanceCount::decrement(this);
 }
 
+/// Finalization callback: stop the I/O thread and print the prefetch statistics
+void DigiROOTInput::finalize()   {
+  if ( m_prefetch_depth > 0 )   {
+    imp->halt();
+    std::size_t reads = imp->m_num_frames;
+    std::size_t consumed = reads - imp->m_queue.size();
+    info("+++ Prefetched %ld events [depth: %d]. Mean queue depth: %.2f",
+	 reads, m_prefetch_depth, consumed > 0 ? double(imp->m_sum_depth)/double(consumed) : 0e0);
+    info("+++ Stalls: event tasks: %ld [%.1f ms total]  I/O thread: %ld",
+	 imp->m_consumer_stalls, imp->m_stall_time, imp->m_producer_stalls);
+  }
+}
+
 /// Pre-track action callback
 void DigiROOTInput::execute(DigiContext& context)  const   {
+  auto& event = context.event;
+  if ( m_prefetch_depth > 0 )   {
+    imp->start();
+    auto frame = imp->dequeue();
+    DataSegment& segment = event->get_segment(m_input_segment);
+    DataSegment& input   = frame->context.event->get_segment(m_input_segment);
+    for( auto& item : input )
+      segment.emplace_any(item.first, std::move(item.second));
+    info("%s+++ Read event %6ld [%ld bytes] from tree %s file: %s [prefetched]",
+	 event->id(), frame->entry, frame->bytes, frame->source->tree->GetName(), frame->source->file->GetName());
+    /// The last frame of an input source closes the file: requires the I/O lock
+    std::lock_guard<std::mutex> lock(context.global_io_lock());
+    frame.reset();
+    return;
+  }
   //
   //  We have to lock all ROOT based actions. Consequences are SEGV otherwise.
   //
   std::lock_guard<std::mutex> lock(context.global_io_lock());
-  auto& event = context.event;
   auto& source = imp->next();
   std::size_t input_len = 0;
 
@@ -0,0 +1,185 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DDDigi/DigiRandomStream.h>
+#include <DDDigi/DigiRandomGenerator.h>
+#include <Math/QuantFuncMathCore.h>
+
+// C/C++ include files
+#include <cmath>
+#include <vector>
+
+using namespace dd4hep::digi;
+
+namespace {
+  /// Philox-4x32 multipliers and Weyl sequence constants
+  constexpr std::uint32_t PHILOX_M0 = 0xD2511F53;
+  constexpr std::uint32_t PHILOX_M1 = 0xCD9E8D57;
+  constexpr std::uint32_t PHILOX_W0 = 0x9E3779B9;
+  constexpr std::uint32_t PHILOX_W1 = 0xBB67AE85;
+  /// Normalization of 53 bit integers to ] 0, 1 ]
+  constexpr double        NORM_53   = 1.0 / 9007199254740992.0;
+  constexpr double        TWOPI     = M_PI * 2.0;
+
+  /// Philox-4x32-10 bijection. Inlined to allow vectorization of the block loops
+  inline void philox_10(std::uint32_t& c0, std::uint32_t& c1, std::uint32_t& c2, std::uint32_t& c3,
+                        std::uint32_t k0, std::uint32_t k1)   {
+    for( int round = 0; round < 10; ++round )   {
+      std::uint64_t p0 = std::uint64_t(PHILOX_M0) * c0;
+      std::uint64_t p1 = std::uint64_t(PHILOX_M1) * c2;
+      std::uint32_t n0 = std::uint32_t(p1 >> 32) ^ c1 ^ k0;
+      std::uint32_t n2 = std::uint32_t(p0 >> 32) ^ c3 ^ k1;
+      c1 = std::uint32_t(p1);
+      c3 = std::uint32_t(p0);
+      c0 = n0;
+      c2 = n2;
+      k0 += PHILOX_W0;
+      k1 += PHILOX_W1;
+    }
+  }
+  /// Convert two random words to a double in ] 0, 1 ]
+  inline double to_uniform(std::uint32_t hi, std::uint32_t lo)   {
+    std::uint64_t bits = ((std::uint64_t(hi) << 32) | lo) >> 11;
+    return double(bits + 1) * NORM_53;
+  }
+}
+
+/// Initializing constructor
+DigiRandomStream::DigiRandomStream(std::uint64_t seed, std::uint64_t strm)
+  : m_key{ { std::uint32_t(seed), std::uint32_t(seed >> 32) } }, m_stream(strm)
+{
+}
+
+/// Philox-4x32-10 bijection of one counter block
+DigiRandomStream::block_t DigiRandomStream::philox(block_t ctr, key_t key)   {
+  philox_10(ctr[0], ctr[1], ctr[2], ctr[3], key[0], key[1]);
+  return ctr;
+}
+
+/// Combine two keys (e.g. run seed and event number) to a new seed
+std::uint64_t DigiRandomStream::combine(std::uint64_t first, std::uint64_t second)   {
+  /// splitmix64 finalizer applied to the combined keys
+  std::uint64_t z = first + 0x9E3779B97F4A7C15ULL * (second + 1);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/// Position the stream at a given block number
+void DigiRandomStream::seek(std::uint64_t block)   {
+  m_block  = block;
+  m_cached = false;
+}
+
+/// Generate 2*num_blocks uniforms starting at the current block
+void DigiRandomStream::i_fill_blocks(double* values, std::size_t num_blocks)   {
+  const std::uint32_t k0 = m_key[0], k1 = m_key[1];
+  const std::uint32_t s0 = std::uint32_t(m_stream), s1 = std::uint32_t(m_stream >> 32);
+  const std::uint64_t first = m_block;
+  for( std::size_t i = 0; i < num_blocks; ++i )   {
+    std::uint64_t blk = first + i;
+    std::uint32_t c0 = std::uint32_t(blk), c1 = std::uint32_t(blk >> 32), c2 = s0, c3 = s1;
+    philox_10(c0, c1, c2, c3, k0, k1);
+    values[2*i]   = to_uniform(c0, c1);
+    values[2*i+1] = to_uniform(c2, c3);
+  }
+  m_block += num_blocks;
+}
+
+/// Single uniform variate in ] 0, 1 ]
+double DigiRandomStream::uniform()   {
+  if ( m_cached )   {
+    m_cached = false;
+    return m_cache;
+  }
+  double block[2];
+  i_fill_blocks(block, 1);
+  m_cache  = block[1];
+  m_cached = true;
+  return block[0];
+}
+
+/// Single gaussian variate
+double DigiRandomStream::gaussian(double mean, double sigma)   {
+  double u1 = uniform();
+  double u2 = uniform();
+  return mean + sigma * std::sqrt(-2e0 * std::log(u1)) * std::cos(TWOPI * u2);
+}
+
+/// Fill buffer with uniform variates in ] 0, 1 ]
+void DigiRandomStream::uniform(double* values, std::size_t num)   {
+  if ( num == 0 ) return;
+  if ( m_cached )   {
+    *values++ = m_cache;
+    m_cached = false;
+    --num;
+  }
+  std::size_t num_blocks = num / 2;
+  i_fill_blocks(values, num_blocks);
+  if ( num & 1 )   {
+    values[num-1] = uniform();
+  }
+}
+
+/// Fill buffer with uniform variates in ] x1, x2 ]
+void DigiRandomStream::uniform(double* values, std::size_t num, double x1, double x2)   {
+  const double width = x2 - x1;
+  uniform(values, num);
+  for( std::size_t i = 0; i < num; ++i )
+    values[i] = x1 + width * values[i];
+}
+
+/// Fill buffer with exponential variates
+void DigiRandomStream::exponential(double* values, std::size_t num, double tau)   {
+  uniform(values, num);
+  for( std::size_t i = 0; i < num; ++i )
+    values[i] = -tau * std::log(values[i]);
+}
+
+/// Fill buffer with gaussian variates (Box-Muller)
+void DigiRandomStream::gaussian(double* values, std::size_t num, double mean, double sigma)   {
+  std::size_t pairs = num / 2;
+  uniform(values, 2*pairs);
+  for( std::size_t i = 0; i < pairs; ++i )   {
+    double u1  = values[2*i];
+    double u2  = values[2*i+1];
+    double rad = sigma * std::sqrt(-2e0 * std::log(u1));
+    double phi = TWOPI * u2;
+    values[2*i]   = mean + rad * std::cos(phi);
+    values[2*i+1] = mean + rad * std::sin(phi);
+  }
+  if ( num & 1 )   {
+    values[num-1] = gaussian(mean, sigma);
+  }
+}
+
+/// Fill buffer with landau variates
+void DigiRandomStream::landau(double* values, std::size_t num, double mean, double sigma)   {
+  if ( sigma <= 0 )   {
+    for( std::size_t i = 0; i < num; ++i ) values[i] = 0e0;
+    return;
+  }
+  uniform(values, num);
+  for( std::size_t i = 0; i < num; ++i )
+    values[i] = mean + ROOT::Math::landau_quantile(values[i], sigma);
+}
+
+/// Fill buffer with poisson variates
+void DigiRandomStream::poisson(double* values, std::size_t num, double mean)   {
+  /// The number of uniforms per variate is not fixed: use the scalar algorithm
+  DigiRandomGenerator generator;
+  generator.engine = [this]  {  return this->uniform();  };
+  for( std::size_t i = 0; i < num; ++i )
+    values[i] = generator.poisson(mean);
+}
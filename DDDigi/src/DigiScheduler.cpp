@@ -0,0 +1,262 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiProfiler.h>
+#include <DDDigi/DigiScheduler.h>
+#include <DDDigi/DigiActionSequence.h>
+
+#ifdef DD4HEP_USE_TBB
+#include <tbb/task_group.h>
+#endif
+
+// C/C++ include files
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <memory>
+#include <sstream>
+#include <algorithm>
+#include <exception>
+
+using namespace dd4hep::digi;
+
+namespace {
+  /// Identify the data segment of a name like DigiEvent::get_segment: e.g. "input" == "inputs"
+  int segment_id(const std::string& name)   {
+    if ( name.empty() )
+      return 0;
+    int id = ::toupper(name[0]);
+    if ( id == 'D' && name.length() > 1 )
+      return ::toupper(name[1]) == 'E' ? 'D' : 'd';
+    return id;
+  }
+  /// Check if two data items refer to the same data
+  bool same_item(const DigiEventAction::data_item_t& a, const DigiEventAction::data_item_t& b)   {
+    if ( segment_id(a.segment) != segment_id(b.segment) )
+      return false;
+    return a.mask == b.mask || a.mask == DigiEventAction::ANY_MASK || b.mask == DigiEventAction::ANY_MASK;
+  }
+  /// Check if any data item of the first list refers to data of the second list
+  bool overlap(const DigiEventAction::data_items_t& a, const DigiEventAction::data_items_t& b)   {
+    for( const auto& i : a )   {
+      for( const auto& j : b )   {
+        if ( same_item(i, j) ) return true;
+      }
+    }
+    return false;
+  }
+}
+
+/// State of the actions of one single event
+/*
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_DIGITIZATION
+ */
+class DigiScheduler::event_t  {
+public:
+  using clock_t = std::chrono::high_resolution_clock;
+  /// Reference to the event context
+  DigiContext&                                 context;
+  /// Start time of the event
+  clock_t::time_point                          start;
+  /// Number of unfinished predecessors per node
+  std::unique_ptr<std::atomic<std::size_t>[]> pending;
+  /// Start time of each node relative to the event start
+  std::vector<double>                          begin;
+  /// End time of each node relative to the event start
+  std::vector<double>                          end;
+  /// Flag set if any action failed. Remaining actions are skipped
+  std::atomic<bool>                            failed    { false };
+  /// First exception thrown by an action
+  std::exception_ptr                           exception { };
+  /// Lock to protect the exception
+  std::mutex                                   lock      { };
+#ifdef DD4HEP_USE_TBB
+  /// Task group of the event
+  tbb::task_group                              group     { };
+#endif
+
+  /// Initializing constructor
+  event_t(DigiContext& ctxt, std::size_t num_nodes)
+    : context(ctxt), start(clock_t::now()),
+      pending(new std::atomic<std::size_t>[num_nodes]),
+      begin(num_nodes, 0e0), end(num_nodes, 0e0)
+  {
+  }
+  /// Time since the event start in seconds
+  double now()  const   {
+    return std::chrono::duration<double>(clock_t::now() - start).count();
+  }
+};
+
+/// Initializing constructor
+DigiScheduler::DigiScheduler(const DigiKernel& krnl) : m_kernel(krnl)
+{
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiScheduler::~DigiScheduler()   {
+  InstanceCount::decrement(this);
+}
+
+/// Add the actions of a sequence to the graph
+void DigiScheduler::add(const DigiActionSequence& sequence)   {
+  std::vector<DigiEventAction*> actions;
+  /// Sequences with external callbacks are scheduled as a whole
+  if ( sequence.has_callbacks() )
+    actions.emplace_back(const_cast<DigiActionSequence*>(&sequence));
+  else
+    actions = sequence.actors();
+  for( auto* action : actions )   {
+    node_t node;
+    node.action   = action;
+    node.declared = action->data_flow(node.inputs, node.outputs);
+    m_nodes.emplace_back(std::move(node));
+  }
+}
+
+/// Check if the second node must be executed after the first node
+bool DigiScheduler::depends(const node_t& first, const node_t& second)   {
+  if ( !first.declared || !second.declared )
+    return true;
+  return overlap(first.outputs, second.inputs)  ||
+    overlap(first.outputs, second.outputs) ||
+    overlap(first.inputs,  second.outputs);
+}
+
+/// Build the dependencies of the graph
+void DigiScheduler::build()   {
+  for( std::size_t i = 0; i < m_nodes.size(); ++i )   {
+    auto& node = m_nodes[i];
+    node.predecessors.clear();
+    for( std::size_t j = 0; j < i; ++j )   {
+      if ( depends(m_nodes[j], node) )   {
+        node.predecessors.emplace_back(j);
+        m_nodes[j].successors.emplace_back(i);
+      }
+    }
+  }
+  m_stat.resize(m_nodes.size());
+  m_kernel.info("+++ Data flow scheduler: %ld actions", m_nodes.size());
+  for( std::size_t i = 0; i < m_nodes.size(); ++i )   {
+    const auto& node = m_nodes[i];
+    std::stringstream str;
+    for( auto p : node.predecessors )
+      str << " " << p;
+    m_kernel.info("+++   [%3ld] %-32s %-8s depends on:%s", i, node.action->c_name(),
+                  node.declared ? "" : "BARRIER", node.predecessors.empty() ? " ----" : str.str().c_str());
+  }
+}
+
+/// Execute one node and submit the successors which are ready
+void DigiScheduler::execute_node(event_t& event, std::size_t n)  const   {
+  const node_t& node = m_nodes[n];
+  event.begin[n] = event.now();
+  if ( !event.failed )   {
+    try   {
+      DigiProfiler::probe_t probe(m_kernel.profiler(), node.action, false, event.context.event->eventNumber);
+      node.action->execute(event.context);
+    }
+    catch(...)   {
+      std::lock_guard<std::mutex> lock(event.lock);
+      if ( !event.exception ) event.exception = std::current_exception();
+      event.failed = true;
+    }
+  }
+  event.end[n] = event.now();
+  for( auto s : node.successors )   {
+    if ( --event.pending[s] == 0 )   {
+#ifdef DD4HEP_USE_TBB
+      event.group.run([this, &event, s] { this->execute_node(event, s); });
+#endif
+    }
+  }
+}
+
+/// Execute all actions of one event according to their dependencies
+void DigiScheduler::execute(DigiContext& context)  const   {
+  const std::size_t num_nodes = m_nodes.size();
+  event_t event(context, num_nodes);
+  for( std::size_t i = 0; i < num_nodes; ++i )
+    event.pending[i] = m_nodes[i].predecessors.size();
+#ifdef DD4HEP_USE_TBB
+  for( std::size_t i = 0; i < num_nodes; ++i )   {
+    if ( m_nodes[i].predecessors.empty() )
+      event.group.run([this, &event, i] { this->execute_node(event, i); });
+  }
+  event.group.wait();
+#else
+  /// The order of the nodes is a topological order
+  for( std::size_t i = 0; i < num_nodes; ++i )
+    execute_node(event, i);
+#endif
+  if ( event.exception )   {
+    std::rethrow_exception(event.exception);
+  }
+  /// Critical path: longest chain of dependent actions
+  std::vector<double> path(num_nodes, 0e0);
+  double critical = 0e0, serial = 0e0;
+  for( std::size_t i = 0; i < num_nodes; ++i )   {
+    double previous = 0e0;
+    for( auto p : m_nodes[i].predecessors )
+      previous = std::max(previous, path[p]);
+    double duration = event.end[i] - event.begin[i];
+    path[i]  = previous + duration;
+    critical = std::max(critical, path[i]);
+    serial  += duration;
+  }
+  double wall = event.now();
+  std::lock_guard<std::mutex> lock(m_stat_lock);
+  for( std::size_t i = 0; i < num_nodes; ++i )   {
+    auto& stat = m_stat[i];
+    double duration = event.end[i] - event.begin[i];
+    stat.time += duration;
+    stat.max   = std::max(stat.max, duration);
+    ++stat.calls;
+  }
+  ++m_num_events;
+  m_wall_time         += wall;
+  m_serial_time       += serial;
+  m_critical_path     += critical;
+  m_max_critical_path  = std::max(m_max_critical_path, critical);
+}
+
+/// Print the execution statistics
+void DigiScheduler::print_statistics()  const   {
+  std::lock_guard<std::mutex> lock(m_stat_lock);
+  if ( 0 == m_num_events )   {
+    m_kernel.info("+++ Data flow scheduler: No events processed.");
+    return;
+  }
+  double num_events = double(m_num_events);
+  m_kernel.info("+++ Data flow scheduler: Wall time per action for %ld events", m_num_events);
+  for( std::size_t i = 0; i < m_nodes.size(); ++i )   {
+    const auto& stat = m_stat[i];
+    m_kernel.info("+++   [%3ld] %-32s calls: %6ld mean: %10.3f ms max: %10.3f ms total: %9.3f s",
+                  i, m_nodes[i].action->c_name(), stat.calls,
+                  stat.calls > 0 ? 1e3 * stat.time / double(stat.calls) : 0e0,
+                  1e3 * stat.max, stat.time);
+  }
+  m_kernel.info("+++ Data flow scheduler: Mean per event: wall time: %9.3f ms actions: %9.3f ms "
+                "critical path: %9.3f ms [max: %9.3f ms] Parallelism: %5.2f",
+                1e3 * m_wall_time / num_events, 1e3 * m_serial_time / num_events,
+                1e3 * m_critical_path / num_events, 1e3 * m_max_critical_path,
+                m_critical_path > 0e0 ? m_serial_time / m_critical_path : 0e0);
+}
@@ -274,6 +274,12 @@ void DigiStoreDump::dump_history(DigiContext& context,
       else if ( const auto* vector = std::any_cast<DepositVector>(&data) )   {
 	rec = dump_deposit_history(context, key, *vector);
       }
+      else if ( const auto* overlay = std::any_cast<DepositOverlay>(&data) )   {
+	rec = { format("|----  %s", data_header(key, "shared deposits", *overlay).c_str()) };
+      }
+      else if ( const auto* view = std::any_cast<DepositView>(&data) )   {
+	rec = { format("|----  %s", data_header(key, "deposit view", *view).c_str()) };
+      }
       else if ( const auto* parts = std::any_cast<ParticleMapping>(&data) )   {
 	rec = dump_particle_history(context, key, *parts);
       }
@@ -312,6 +318,10 @@ void DigiStoreDump::dump_headers(const std::string& tag,
       str = "| " + data_header(key, "deposits", *mapping);
     else if ( const auto* vector = std::any_cast<DepositVector>(&data) )
       str = "| " + data_header(key, "deposits", *vector);
+    else if ( const auto* overlay = std::any_cast<DepositOverlay>(&data) )
+      str = "| " + data_header(key, "deposits", *overlay);
+    else if ( const auto* view = std::any_cast<DepositView>(&data) )
+      str = "| " + data_header(key, "deposits", *view);
     else if ( const auto* parts = std::any_cast<ParticleMapping>(&data) )
       str = "| " + data_header(key, "particles", *parts);
     else if ( const auto* adcs = std::any_cast<DetectorResponse>(&data) )
@@ -333,6 +343,17 @@ void DigiStoreDump::dump_headers(const std::string& tag,
     info("%s|----  %s", event.id(), s.c_str());
 }
 
+/// Declare the data items read and written by the action (used by the data flow scheduler)
+bool DigiStoreDump::data_flow(data_items_t& inputs, data_items_t& /* outputs */)  const   {
+  for( const auto& segment : m_segments )   {
+    if ( m_masks.empty() )
+      inputs.emplace_back(data_item_t{ segment, ANY_MASK });
+    for( int mask : m_masks )
+      inputs.emplace_back(data_item_t{ segment, mask });
+  }
+  return true;
+}
+
 /// Main functional callback
 void DigiStoreDump::execute(DigiContext& context)  const    {
   const auto& event = context.event;
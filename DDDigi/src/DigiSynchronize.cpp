@@ -41,6 +41,26 @@ DigiSynchronize::~DigiSynchronize() {
   InstanceCount::decrement(this);
 }
 
+/// Access the adopted actions in the order of adoption
+std::vector<DigiEventAction*> DigiSynchronize::actors()  const   {
+  std::vector<DigiEventAction*> result;
+  if ( !m_actors.empty() )   {
+    auto group = m_actors.get_group();
+    for( const auto* w : group.actors() )
+      result.emplace_back(w->action);
+  }
+  return result;
+}
+
+/// Data flow of the sequence: union of the data items of all adopted actions
+bool DigiSynchronize::data_flow(data_items_t& inputs, data_items_t& outputs)  const   {
+  for( const auto* action : actors() )   {
+    if ( !action->data_flow(inputs, outputs) )
+      return false;
+  }
+  return true;
+}
+
 /// Pre-track action callback
 void DigiSynchronize::execute(DigiContext& context)  const   {
   auto start = std::chrono::high_resolution_clock::now();
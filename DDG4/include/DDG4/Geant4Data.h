@@ -230,6 +230,55 @@ namespace dd4hep {
       };
       typedef MonteCarloContrib Contribution;
       typedef std::vector<MonteCarloContrib> Contributions;
+
+      /// Statistics of the thread local hit pools
+      /**
+       *  Cross-thread rule:
+       *  Tracker and calorimeter hits are served by the pool of the allocating
+       *  thread only inside a PoolScope, i.e. while the sensitive detectors
+       *  process the event. All other hits (readers, I/O threads, derived hit
+       *  types) are allocated from the heap. Every allocation is tagged with its
+       *  origin: heap hits always return to the heap. Pooled hits deleted by
+       *  another thread are handed back to the pool of the allocating thread
+       *  and recycled there at its next allocation. Hence no pool grows if
+       *  hits are created and deleted by different threads.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class PoolStatistics  {
+      public:
+        /// Number of hits served by the pool of this thread
+        long allocated = 0;
+        /// Number of hits returned to the pool of this thread
+        long released  = 0;
+        /// Number of released hits handed back by other threads (included in 'released')
+        long remote    = 0;
+        /// Number of hits allocated from the heap by this thread
+        long heap      = 0;
+      };
+
+      /// Scope, in which new tracker and calorimeter hits are served by the thread local pools
+      /**
+       *  Opened by the sensitive detector sequences while processing the event.
+       *  Scopes may be nested.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class PoolScope  {
+        /// State of the calling thread before entering the scope
+        bool m_previous;
+      public:
+        /// Default constructor: enter the scope
+        PoolScope();
+        /// Default destructor: leave the scope
+        ~PoolScope();
+        /// Check if the calling thread is inside a pool scope
+        static bool active();
+      };
     public:
       /// Default constructor
       Geant4HitData();
@@ -287,6 +336,12 @@ namespace dd4hep {
 	Hit(const Geant4HitData::Contribution& contrib, const Direction& mom, double deposit);
         /// Default destructor
         virtual ~Hit();
+        /// Allocate the hit from the thread local hit pool inside a pool scope, otherwise from the heap
+        static void* operator new(std::size_t size);
+        /// Return the hit to the pool or the heap it was allocated from
+        static void operator delete(void* ptr, std::size_t size);
+        /// Access the hit pool statistics of the calling thread
+        static PoolStatistics poolStatistics();
         /// Move assignment operator
         Hit& operator=(Hit&& c) = delete;
         /// Copy assignment operator
@@ -341,6 +396,12 @@ namespace dd4hep {
         Hit(const Position& cell_pos);
         /// Default destructor
         virtual ~Hit();
+        /// Allocate the hit from the thread local hit pool inside a pool scope, otherwise from the heap
+        static void* operator new(std::size_t size);
+        /// Return the hit to the pool or the heap it was allocated from
+        static void operator delete(void* ptr, std::size_t size);
+        /// Access the hit pool statistics of the calling thread
+        static PoolStatistics poolStatistics();
         /// Move assignment operator
         Hit& operator=(Hit&& c) = delete;
         /// Copy assignment operator
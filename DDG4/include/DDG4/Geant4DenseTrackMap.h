@@ -0,0 +1,175 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4DENSETRACKMAP_H
+#define DDG4_GEANT4DENSETRACKMAP_H
+
+// C/C++ include files
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Dense map of objects keyed by non-negative track or particle identifiers
+    /**
+     *  Replacement of std::map<int,T> for the per-event track bookkeeping.
+     *  Geant4 assigns track identifiers sequentially, hence a vector indexed
+     *  by the identifier stays dense: lookups are a single index operation
+     *  and insertions do not allocate tree nodes.
+     *  The interface follows std::map: iteration is in key order and
+     *  dereferenced iterators give access to (key, value) pairs.
+     *  Insertions may invalidate iterators.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    template <typename T> class Geant4DenseTrackMap  {
+    public:
+      typedef int                     key_type;
+      typedef T                       mapped_type;
+      typedef std::pair<int, T>       value_type;
+      /// Key of empty slots
+      static constexpr int EMPTY = -1;
+
+      /// Bidirectional iterator skipping empty slots
+      template <typename V> class iterator_t  {
+      public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef V                               value_type;
+        typedef std::ptrdiff_t                  difference_type;
+        typedef V*                              pointer;
+        typedef V&                              reference;
+      protected:
+        V* m_ptr   = nullptr;
+        V* m_first = nullptr;
+        V* m_last  = nullptr;
+      public:
+        /// Default constructor
+        iterator_t() = default;
+        /// Initializing constructor
+        iterator_t(V* ptr, V* first, V* last) : m_ptr(ptr), m_first(first), m_last(last)  {}
+        /// Conversion to const iterator
+        template <typename Q> iterator_t(const iterator_t<Q>& c)
+          : m_ptr(c.ptr()), m_first(c.first()), m_last(c.last())  {}
+        V* ptr()   const  {  return m_ptr;    }
+        V* first() const  {  return m_first;  }
+        V* last()  const  {  return m_last;   }
+        reference operator*()  const  {  return *m_ptr;  }
+        pointer   operator->() const  {  return m_ptr;   }
+        iterator_t& operator++()  {
+          do { ++m_ptr; } while( m_ptr != m_last && m_ptr->first == EMPTY );
+          return *this;
+        }
+        iterator_t& operator--()  {
+          do { --m_ptr; } while( m_ptr != m_first && m_ptr->first == EMPTY );
+          return *this;
+        }
+        iterator_t operator++(int)  {  iterator_t tmp(*this); ++(*this); return tmp;  }
+        iterator_t operator--(int)  {  iterator_t tmp(*this); --(*this); return tmp;  }
+        template <typename Q> bool operator==(const iterator_t<Q>& c) const  {  return m_ptr == c.ptr();  }
+        template <typename Q> bool operator!=(const iterator_t<Q>& c) const  {  return m_ptr != c.ptr();  }
+      };
+      typedef iterator_t<value_type>                iterator;
+      typedef iterator_t<const value_type>          const_iterator;
+      typedef std::reverse_iterator<iterator>       reverse_iterator;
+      typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    protected:
+      /// Slots indexed by the key
+      std::vector<value_type> m_data;
+      /// Number of occupied slots
+      std::size_t             m_count = 0;
+
+      iterator make(value_type* p)  {
+        return iterator(p, m_data.data(), m_data.data() + m_data.size());
+      }
+      const_iterator make(const value_type* p)  const  {
+        return const_iterator(p, m_data.data(), m_data.data() + m_data.size());
+      }
+
+    public:
+      /// Number of entries
+      std::size_t size() const     {  return m_count;       }
+      /// Check if the map is empty
+      bool empty() const           {  return 0 == m_count;  }
+      /// Reserve slots for keys up to a given value
+      void reserve(std::size_t n)  {  m_data.reserve(n);    }
+      /// Remove all entries. The allocated slots are kept
+      void clear()                 {  m_data.clear(); m_count = 0;  }
+
+      iterator begin()  {
+        for( value_type& v : m_data )
+          if ( v.first != EMPTY ) return make(&v);
+        return end();
+      }
+      const_iterator begin()  const  {
+        for( const value_type& v : m_data )
+          if ( v.first != EMPTY ) return make(&v);
+        return end();
+      }
+      iterator end()                          {  return make(m_data.data() + m_data.size());  }
+      const_iterator end()  const             {  return make(m_data.data() + m_data.size());  }
+      reverse_iterator rbegin()               {  return reverse_iterator(end());        }
+      reverse_iterator rend()                 {  return reverse_iterator(begin());      }
+      const_reverse_iterator rbegin()  const  {  return const_reverse_iterator(end());  }
+      const_reverse_iterator rend()    const  {  return const_reverse_iterator(begin());}
+
+      /// Find entry by key
+      iterator find(int key)  {
+        if ( std::size_t(key) < m_data.size() && m_data[key].first != EMPTY )
+          return make(&m_data[key]);
+        return end();
+      }
+      /// Find entry by key (CONST)
+      const_iterator find(int key)  const  {
+        if ( std::size_t(key) < m_data.size() && m_data[key].first != EMPTY )
+          return make(&m_data[key]);
+        return end();
+      }
+      /// Access or insert entry by key
+      T& operator[](int key)  {
+        if ( key < 0 )
+          throw std::out_of_range("Geant4DenseTrackMap: negative key");
+        if ( std::size_t(key) >= m_data.size() )
+          m_data.resize(key + 1, value_type(EMPTY, T()));
+        value_type& v = m_data[key];
+        if ( v.first == EMPTY )  {
+          v.first = key;
+          ++m_count;
+        }
+        return v.second;
+      }
+      /// Insert new entry if the key is not present
+      std::pair<iterator, bool> emplace(int key, const T& value)  {
+        iterator i = find(key);
+        if ( i != end() ) return std::make_pair(i, false);
+        (*this)[key] = value;
+        return std::make_pair(find(key), true);
+      }
+      /// Remove entry
+      void erase(iterator i)  {
+        i->first  = EMPTY;
+        i->second = T();
+        --m_count;
+      }
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4DENSETRACKMAP_H
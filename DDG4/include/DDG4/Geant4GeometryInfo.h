@@ -56,6 +56,7 @@ namespace dd4hep {
     // Forward declarations
     class Geant4Mapping;
     class Geant4AssemblyVolume;
+    class Geant4VolumePathIndex;
 
     /// Helper namespace defining data types for the relation information between geant4 objects and dd4hep objects.
     /**
@@ -137,6 +138,8 @@ namespace dd4hep {
       std::map<SensitiveDetector,std::set<const TGeoVolume*> > sensitives;
       std::map<Region,           std::set<const TGeoVolume*> > regions;
       std::map<LimitSet,         std::set<const TGeoVolume*> > limits;
+      /// Flat touchable lookup index built from g4Paths
+      Geant4VolumePathIndex*                                   g4PathIndex = nullptr; //! Not ROOT persistent
       G4VPhysicalVolume*                                       m_world;
       PrintLevel                                               printLevel;
       bool                                                     valid;
@@ -25,6 +25,8 @@
 #include <climits>
 #include <typeinfo>
 #include <stdexcept>
+#include <functional>
+#include <unordered_map>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -168,6 +170,87 @@ namespace dd4hep {
       }
     };
 
+    /// Open addressing hash index of hit keys (cell identifiers) to hit indices
+    /**
+     *  Flat hash table with linear probing. The table size is a power of 2
+     *  and the load factor is kept below 0.5. Clearing the index keeps the
+     *  allocated table, so that a pre-reserved index never rehashes.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4HitKeyIndex  {
+    public:
+      /// Value of an empty slot and of unsuccessful lookups
+      static constexpr size_t INVALID = ~size_t(0);
+      /// Hash table slot
+      struct Entry  {
+        /// Hit key
+        VolumeID key   = 0;
+        /// Index of the hit in the collection. INVALID if the slot is empty
+        size_t   index = INVALID;
+      };
+
+    protected:
+      /// Hash table
+      std::vector<Entry> m_entries;
+      /// Bit mask to map hash values to slot indices
+      size_t             m_mask  = 0;
+      /// Number of occupied slots
+      size_t             m_count = 0;
+
+      /// Resize the hash table and re-insert all entries
+      void rehash(size_t num_slots);
+
+    public:
+      /// Hash function to spread the key bits over the slots
+      static inline size_t hash(VolumeID key)  {
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        key *= 0xc4ceb9fe1a85ec53ULL;
+        key ^= key >> 33;
+        return size_t(key);
+      }
+      /// Number of keys in the index
+      size_t size() const   {
+        return m_count;
+      }
+      /// Check if the index is empty
+      bool empty() const   {
+        return 0 == m_count;
+      }
+      /// Allocate the hash table for a given number of keys
+      void reserve(size_t num_keys);
+      /// Remove all keys. The hash table stays allocated
+      void clear();
+      /// Insert a new key. Returns false if the key is already present
+      inline bool insert(VolumeID key, size_t index)  {
+        if ( 2*(m_count+1) > m_entries.size() )
+          rehash(m_entries.empty() ? 16 : 2*m_entries.size());
+        for( size_t slot = hash(key) & m_mask; ; slot = (slot + 1) & m_mask )  {
+          Entry& e = m_entries[slot];
+          if ( e.index == INVALID )  {
+            e.key   = key;
+            e.index = index;
+            ++m_count;
+            return true;
+          }
+          if ( e.key == key ) return false;
+        }
+      }
+      /// Lookup the hit index of a key. Returns INVALID if the key is not present
+      inline size_t find(VolumeID key)  const  {
+        if ( 0 == m_count ) return INVALID;
+        for( size_t slot = hash(key) & m_mask; ; slot = (slot + 1) & m_mask )  {
+          const Entry& e = m_entries[slot];
+          if ( e.index == INVALID ) return INVALID;
+          if ( e.key == key ) return e.index;
+        }
+      }
+    };
+
     /// Generic hit container class using Geant4HitWrapper objects
     /**
      * Opaque hit collection.
@@ -206,7 +289,9 @@ namespace dd4hep {
       /// Hit manipulator
       typedef Geant4HitWrapper::HitManipulator Manip;
       /// Hit key map for fast random lookup
-      typedef std::map<VolumeID, size_t>  Keys;
+      typedef Geant4HitKeyIndex           Keys;
+      /// Secondary hit key map for position keyed collections: position hash -> hit index
+      typedef std::unordered_multimap<size_t, size_t> PositionKeys;
 
       /// Generic class template to compare/select hits in Geant4HitCollection objects
       /**
@@ -225,6 +310,25 @@ namespace dd4hep {
         virtual void* operator()(const Geant4HitWrapper& w) const = 0;
       };
 
+      /// Allocation statistics of the hits in this collection
+      /**
+       *  The hits of the DDG4 default hit types are served by thread local pools
+       *  (see Geant4HitData::PoolStatistics).
+       *
+       * \author  M.Frank
+       * \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Statistics  {
+      public:
+        /// Number of hits added to the collection
+        std::size_t numHits     = 0;
+        /// Memory occupied by the hit objects (without dynamic hit content)
+        std::size_t hitBytes    = 0;
+        /// Number of hits released to the caller (ownership transferred)
+        std::size_t numReleased = 0;
+      };
+
       /// Union defining the hit collection flags for processing
       union CollectionFlags  {
         /// Full value
@@ -247,8 +351,12 @@ namespace dd4hep {
       size_t                           m_lastHit;
       /// Hit key map for fast random lookup
       Keys                             m_keys;
+      /// Secondary hit key map for position keyed lookup
+      PositionKeys                     m_positionKeys;
       /// Optimization flags
       CollectionFlags                  m_flags;
+      /// Hit allocation statistics
+      Statistics                       m_statistics;
       
     protected:
       /// Notification to increase the instance counter
@@ -301,6 +409,8 @@ namespace dd4hep {
       const ComponentCast& vector_type() const;
       /// Clear the collection (Deletes all valid references to real hits)
       virtual void clear();
+      /// Reserve space for a given number of hits (e.g. the hit count of the previous event)
+      void reserve(size_t num_hits);
       /// Set optimization flags
       void setOptimize(int flag)  {
         m_flags.value |= flag;
@@ -313,6 +423,10 @@ namespace dd4hep {
       Geant4Sensitive* sensitive() const   {
         return m_detector;
       }
+      /// Access the hit allocation statistics
+      const Statistics& statistics() const   {
+        return m_statistics;
+      }
       /// Access individual hits
       virtual G4VHit* GetHit(size_t which) const {
         return (G4VHit*) &m_hits.at(which);
@@ -334,30 +448,66 @@ namespace dd4hep {
         Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
         m_lastHit = m_hits.size();
         m_hits.emplace_back(w);
+        ++m_statistics.numHits;
+        m_statistics.hitBytes += sizeof(TYPE);
       }
       /// Add a new hit with a check, that the hit is of the same type
       template <typename TYPE> void add(VolumeID key, TYPE* hit_pointer) {
         m_lastHit = m_hits.size();
-        std::pair<Keys::iterator,bool> ret = m_keys.emplace(key,m_lastHit);
-        if ( ret.second )  {
+        if ( m_keys.insert(key, m_lastHit) )  {
           Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
           m_hits.emplace_back(w);
+          ++m_statistics.numHits;
+          m_statistics.hitBytes += sizeof(TYPE);
           return;
         }
         throw std::runtime_error("Attempt to insert hit with same key to G4 hit-collection "+GetName());
       }
+      /// Add a new hit keyed by its position. Hits with identical positions are not checked
+      template <typename TYPE, typename POS> void addByPosition(const POS& pos, TYPE* hit_pointer) {
+        Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
+        m_lastHit = m_hits.size();
+        m_positionKeys.emplace(positionKey(pos), m_lastHit);
+        m_hits.emplace_back(w);
+        ++m_statistics.numHits;
+        m_statistics.hitBytes += sizeof(TYPE);
+      }
+      /// Hash key of a hit position. Positions must compare equal to be matched
+      template <typename POS> static size_t positionKey(const POS& pos)  {
+        std::hash<double> h;
+        size_t key = h(pos.X());
+        key ^= h(pos.Y()) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+        key ^= h(pos.Z()) + 0x9e3779b97f4a7c15ULL + (key << 6) + (key >> 2);
+        return key;
+      }
       /// Find hits in a collection by comparison of attributes
       template <typename TYPE> TYPE* find(const Compare& cmp) {
         return (TYPE*) findHit(cmp);
       }
       /// Find hits in a collection by comparison of key value
       template <typename TYPE> TYPE* findByKey(VolumeID key) {
-        Keys::const_iterator i=m_keys.find(key);
-        if ( i == m_keys.end() ) return 0;
-        m_lastHit = (*i).second;
-        TYPE* obj = m_hits.at(m_lastHit);
+        size_t idx = m_keys.find(key);
+        if ( idx == Keys::INVALID ) return 0;
+        m_lastHit = idx;
+        TYPE* obj = m_hits[idx];
         return obj;
       }
+      /// Find hits in a collection by their position using the secondary key map (hits added with addByPosition)
+      template <typename TYPE, typename POS> TYPE* findByPosition(const POS& pos) {
+        if ( m_flags.bits.repeatedLookup && m_lastHit < m_hits.size() )  {
+          TYPE* obj = m_hits[m_lastHit];
+          if ( obj->position == pos ) return obj;
+        }
+        auto range = m_positionKeys.equal_range(positionKey(pos));
+        for( auto i = range.first; i != range.second; ++i )  {
+          TYPE* obj = m_hits.at((*i).second);
+          if ( obj->position == pos )  {
+            m_lastHit = (*i).second;
+            return obj;
+          }
+        }
+        return 0;
+      }
       /// Release all hits from the Geant4 container and pass ownership to the caller
       template <typename TYPE> std::vector<TYPE*> releaseHits() {
         std::vector<TYPE*> vec;
@@ -366,6 +516,7 @@ namespace dd4hep {
         }
         m_lastHit = ULONG_MAX;
         m_keys.clear();
+        m_positionKeys.clear();
         return vec;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
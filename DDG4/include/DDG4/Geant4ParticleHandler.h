@@ -26,6 +26,7 @@
 
 // Framework include files
 #include "DDG4/Geant4Primary.h"
+#include "DDG4/Geant4DenseTrackMap.h"
 #include "DDG4/Geant4GeneratorAction.h"
 #include "DDG4/Geant4MonteCarloTruth.h"
 
@@ -65,6 +66,12 @@ namespace dd4hep {
      *  attached to the particle handler.
      *  See class {\tt{Geant4UserParticleHandler}} for details.
      *
+     *  During the event particles and track equivalents are kept in dense stores
+     *  indexed by the Geant4 track identifier. They are converted to the maps of the
+     *  {\tt{Geant4ParticleMap}} only when the record is adopted at the end of the event.
+     *  The parent and daughter lists remain the std::set members of {\tt{Geant4Particle}}:
+     *  they are part of the persistent particle layout seen by user handlers and writers.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
@@ -74,6 +81,10 @@ namespace dd4hep {
       typedef Geant4ParticleMap::Particle         Particle;
       typedef Geant4ParticleMap::ParticleMap      ParticleMap;
       typedef Geant4ParticleMap::TrackEquivalents TrackEquivalents;
+      /// Dense particle store indexed by the Geant4 track identifier
+      typedef Geant4DenseTrackMap<Particle*>      DenseParticleMap;
+      /// Flat track equivalence array indexed by the Geant4 track identifier
+      typedef Geant4DenseTrackMap<int>            DenseEquivalents;
 #if defined(__CINT__) || defined(__MAKECINT__) || defined(G__DICTIONARY)
       // Need to force to public for the ROOT dictionary
     public:
@@ -118,12 +129,12 @@ namespace dd4hep {
       /// Local buffer about the 'current' G4Track
       Particle          m_currTrack;
       /// Map with stored MC Particles
-      ParticleMap       m_particleMap;
+      DenseParticleMap  m_particleMap;
       /// Map with stored MC Particles that were suspended by the stepping action
       ParticleMap       m_suspendedPM;
       bool              m_haveSuspended = false;
       /// Map associating the G4Track identifiers with identifiers of existing MCParticles
-      TrackEquivalents  m_equivalentTracks;
+      DenseEquivalents  m_equivalentTracks;
 
       /// Recombine particles and associate the to parents with cleanup
       int recombineParents();
@@ -338,6 +338,8 @@ namespace dd4hep {
 
       /// Hit collection creators
       HitCollections m_collections;
+      /// Hit counts of the previous event to pre-size the hit collections
+      std::vector<std::size_t> m_collectionSizes;
       /// Reference to the sensitive detector element
       SensitiveDetector m_sensitive;
       /// Reference to G4 sensitive detector
@@ -22,6 +22,10 @@
 // Geant4 forward declarations
 class G4VPhysicalVolume;
 
+// C/C++ include files
+#include <cstdint>
+#include <vector>
+
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -33,6 +37,100 @@ namespace dd4hep {
     class Geant4VolumeManager;
     class Geant4GeometryInfo;
 
+    /// Flat hash index of the sensitive Geant4 placement paths
+    /**
+     *  Read-only open addressing hash table built from Geant4GeometryInfo::g4Paths
+     *  once the volume manager is populated. The touchable history is hashed
+     *  level by level directly from the touchable: no placement path vector
+     *  is allocated and no map lookups are necessary for parametrised or
+     *  replicated placements, since the contributing levels are resolved
+     *  when the index is built.
+     *
+     * @author  M.Frank
+     * @version 1.0
+     */
+    class Geant4VolumePathIndex  {
+    public:
+      typedef std::vector<const G4VPhysicalVolume*> Path;
+      /// Placement level contributing its copy number to the volume identifier
+      struct Level  {
+        /// Volume identifier field of the copy number
+        const BitFieldElement* field = nullptr;
+        /// Touchable history depth of the placement
+        int                    depth = 0;
+      };
+      /// Hash table slot
+      struct Entry  {
+        /// Full hash value of the placement path
+        std::size_t  hash     = 0;
+        /// Reference to the placement path (key of Geant4GeometryInfo::g4Paths). NULL if the slot is empty
+        const Path*  path     = nullptr;
+        /// Volume identifier of the placement
+        VolumeID     volumeID = 0;
+        /// Index of the first copy number level in the level table
+        std::uint32_t first   = 0;
+        /// Number of copy number levels
+        std::uint32_t count   = 0;
+      };
+      /// Open addressing hash table with linear probing. Size is a power of 2
+      std::vector<Entry>  entries;
+      /// Copy number levels of parametrised and replicated placements
+      std::vector<Level>  levels;
+      /// Bit mask to map hash values to slot indices
+      std::size_t         slotMask = 0;
+      /// Number of occupied slots
+      std::size_t         count    = 0;
+      /// Unique instance identifier to validate thread local caches
+      std::size_t         serial   = 0;
+
+    public:
+      /// Initializing constructor: build the index from the populated geometry information
+      Geant4VolumePathIndex(const Geant4GeometryInfo& info);
+      /// Default destructor
+      ~Geant4VolumePathIndex() = default;
+      /// Hash function to combine one placement level with the path hash
+      static inline std::size_t hash(std::size_t h, const G4VPhysicalVolume* pv)  {
+        std::size_t key = std::size_t(pv);
+        key ^= key >> 33;
+        key *= 0xff51afd7ed558ccdULL;
+        key ^= key >> 33;
+        return (h ^ key) * 0xc4ceb9fe1a85ec53ULL;
+      }
+      /// Hash value of the touchable history
+      static inline std::size_t hash(const G4VTouchable* touchable, int depth)  {
+        std::size_t h = std::size_t(depth);
+        for( int i = 0; i < depth; ++i )
+          h = hash(h, touchable->GetVolume(i));
+        return h ^ (h >> 29);
+      }
+      /// Check if the touchable history matches the placement path of an entry
+      static inline bool match(const Entry& e, const G4VTouchable* touchable, int depth)  {
+        const Path& path = *e.path;
+        if ( path.size() != std::size_t(depth) ) return false;
+        for( int i = 0; i < depth; ++i )
+          if ( path[i] != touchable->GetVolume(i) ) return false;
+        return true;
+      }
+      /// Lookup the entry of a touchable history
+      inline const Entry* find(const G4VTouchable* touchable, int depth)  const  {
+        std::size_t h = hash(touchable, depth);
+        for( std::size_t slot = h & slotMask; ; slot = (slot + 1) & slotMask )  {
+          const Entry& e = entries[slot];
+          if ( !e.path ) return nullptr;
+          if ( e.hash == h && match(e, touchable, depth) ) return &e;
+        }
+      }
+      /// Compute the volume identifier of a matching entry
+      inline VolumeID volumeID(const Entry& e, const G4VTouchable* touchable)  const  {
+        VolumeID volid = e.volumeID;
+        for( std::uint32_t i = e.first, n = e.first + e.count; i < n; ++i )  {
+          const Level& l = levels[i];
+          volid |= IDDescriptor::encode(l.field, touchable->GetCopyNumber(l.depth));
+        }
+        return volid;
+      }
+    };
+
     /// The Geant4VolumeManager to facilitate optimized lookups of cell IDs from touchables.
     /** @class Geant4VolumeManager Geant4VolumeManager.h DDG4/Geant4VolumeManager.h
      *
@@ -43,6 +141,8 @@ namespace dd4hep {
     protected:
       /// Check the validity of the information before accessing it.
       bool checkValidity() const;
+      /// Access CELLID by Geant4 touchable object using the placement path map (slow)
+      VolumeID pathVolumeID(const G4VTouchable* touchable) const;
 
     public:
       static const VolumeID InvalidPath = VolumeID(-1LL);
@@ -72,6 +172,8 @@ namespace dd4hep {
       //VolumeID volumeID(const std::vector<const G4VPhysicalVolume*>& path) const;
       /// Access CELLID by Geant4 touchable object
       VolumeID volumeID(const G4VTouchable* touchable) const;
+      /// Build the flat touchable lookup index if not yet present
+      void buildIndex() const;
       /// Accessfully decoded volume fields  by placement path
       void volumeDescriptor(const std::vector<const G4VPhysicalVolume*>& path,
                             std::pair<VolumeID,std::vector<std::pair<const BitFieldElement*, VolumeID> > >& volume_desc) const;
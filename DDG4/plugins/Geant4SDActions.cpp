@@ -359,11 +359,11 @@ namespace dd4hep {
         Geant4HitCollection*  coll    = collection(m_collectionID);
         HitContribution       contrib = Hit::extractContribution(step);
         Position              pos     = h.prePos();
-        Hit* hit = coll->find<Hit>(PositionCompare<Hit,Position>(pos));
+        Hit* hit = coll->findByPosition<Hit>(pos);
         if ( !hit ) {
           hit = new Hit(pos);
           hit->cellID = volumeID(step);
-          coll->add(hit);
+          coll->addByPosition(pos, hit);
           if ( 0 == hit->cellID )  {
             hit->cellID = volumeID(step);
             except("+++ Invalid CELL ID for hit!");
@@ -395,11 +395,11 @@ namespace dd4hep {
         Geant4HitCollection* coll = collection(m_collectionID);
         HitContribution   contrib = Hit::extractContribution(spot);
         Position          pos     = h.avgPosition();
-        Hit* hit = coll->find<Hit>(PositionCompare<Hit,Position>(pos));
+        Hit* hit = coll->findByPosition<Hit>(pos);
         if ( !hit ) {
           hit = new Hit(pos);
           hit->cellID = volumeID(h.touchable());
-          coll->add(hit);
+          coll->addByPosition(pos, hit);
           if ( 0 == hit->cellID )  {
             hit->cellID = volumeID(h.touchable());
             except("+++ Invalid CELL ID for hit!");
@@ -24,8 +24,128 @@
 #include <G4Allocator.hh>
 #include <G4OpticalPhoton.hh>
 
+// C/C++ include files
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
 using namespace dd4hep::sim;
 
+namespace {
+
+  /// Flag indicating that the calling thread is inside a hit pool scope
+  G4ThreadLocal bool s_poolScope = false;
+
+  /// Thread local pool for hits created by the DDG4 sensitive detectors
+  /**
+   *  Only objects of exactly the pooled type created inside a pool scope are
+   *  served by the pool. All other objects are allocated from the heap.
+   *  Every allocation is preceded by a header identifying the owning pool
+   *  (NULL for heap allocations). Pooled hits released by another thread are
+   *  queued to the owning pool and recycled by the owning thread.
+   *  Like the hit wrapper allocator the pool is never deleted: hits may be
+   *  released by any thread at any time (e.g. by output writers).
+   */
+  template <typename HIT> class HitPool  {
+  public:
+    /// Allocation header preceding every hit
+    struct alignas(std::max_align_t) Header  {
+      /// Owning pool. NULL for heap allocations
+      HitPool* owner;
+    };
+    /// Pooled memory block: header followed by the hit
+    struct Block  {
+      Header                 header;
+      alignas(HIT) unsigned char hit[sizeof(HIT)];
+    };
+    static_assert(offsetof(Block, hit) == sizeof(Header), "Hit must directly follow the header");
+
+    /// Geant4 single object allocator
+    G4Allocator<Block>            allocator;
+    /// Usage statistics
+    Geant4HitData::PoolStatistics statistics;
+    /// Blocks released by other threads, to be recycled by the owning thread
+    std::vector<Block*>           remote;
+    /// Lock protecting the queue of remotely released blocks
+    std::mutex                    remote_lock;
+    /// Flag indicating that remotely released blocks are queued
+    std::atomic<bool>             has_remote  { false };
+
+    /// Access the pool pointer of the calling thread
+    static HitPool*& local()  {
+      static G4ThreadLocal HitPool* pool = nullptr;
+      return pool;
+    }
+    /// Access the pool of the calling thread
+    static HitPool& instance()  {
+      HitPool*& pool = local();
+      if ( !pool ) pool = new HitPool();
+      return *pool;
+    }
+    /// Access the allocation header of a hit
+    static Header* header(void* ptr)  {
+      return reinterpret_cast<Header*>(static_cast<unsigned char*>(ptr) - sizeof(Header));
+    }
+    /// Return the blocks released by other threads to the allocator
+    void recycle()  {
+      std::lock_guard<std::mutex> guard(remote_lock);
+      for( Block* b : remote )
+        allocator.FreeSingle(b);
+      statistics.released += long(remote.size());
+      statistics.remote   += long(remote.size());
+      remote.clear();
+      has_remote = false;
+    }
+    /// Allocate memory for one hit
+    void* allocate(std::size_t size)  {
+      if ( size == sizeof(HIT) && s_poolScope )  {
+        if ( has_remote ) recycle();
+        Block* b = allocator.MallocSingle();
+        b->header.owner = this;
+        ++statistics.allocated;
+        return b->hit;
+      }
+      Header* h = static_cast<Header*>(::operator new(sizeof(Header) + size));
+      h->owner = nullptr;
+      ++statistics.heap;
+      return h + 1;
+    }
+    /// Release the memory of one hit to its origin
+    static void release(void* ptr)  {
+      Header*  h     = header(ptr);
+      HitPool* owner = h->owner;
+      if ( !owner )  {
+        ::operator delete(h);
+        return;
+      }
+      Block* b = reinterpret_cast<Block*>(h);
+      if ( owner == local() )  {
+        ++owner->statistics.released;
+        owner->allocator.FreeSingle(b);
+        return;
+      }
+      std::lock_guard<std::mutex> guard(owner->remote_lock);
+      owner->remote.emplace_back(b);
+      owner->has_remote = true;
+    }
+  };
+}
+
+/// Default constructor: enter the scope
+Geant4HitData::PoolScope::PoolScope() : m_previous(s_poolScope)  {
+  s_poolScope = true;
+}
+
+/// Default destructor: leave the scope
+Geant4HitData::PoolScope::~PoolScope()  {
+  s_poolScope = m_previous;
+}
+
+/// Check if the calling thread is inside a pool scope
+bool Geant4HitData::PoolScope::active()  {
+  return s_poolScope;
+}
+
 /// Default constructor
 SimpleRun::SimpleRun()
   : runID(-1), numEvents(0) {
@@ -133,6 +253,21 @@ Geant4Tracker::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
 
+/// Allocate the hit from the thread local hit pool inside a pool scope, otherwise from the heap
+void* Geant4Tracker::Hit::operator new(std::size_t size)   {
+  return HitPool<Hit>::instance().allocate(size);
+}
+
+/// Return the hit to the pool or the heap it was allocated from
+void Geant4Tracker::Hit::operator delete(void* ptr, std::size_t /* size */)   {
+  if ( ptr ) HitPool<Hit>::release(ptr);
+}
+
+/// Access the hit pool statistics of the calling thread
+Geant4HitData::PoolStatistics Geant4Tracker::Hit::poolStatistics()   {
+  return HitPool<Hit>::instance().statistics;
+}
+
 /// Explicit assignment operation
 void Geant4Tracker::Hit::copyFrom(const Hit& c) {
   if ( &c != this )  {
@@ -214,3 +349,18 @@ Geant4Calorimeter::Hit::Hit(const Position& pos)
 Geant4Calorimeter::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
+
+/// Allocate the hit from the thread local hit pool inside a pool scope, otherwise from the heap
+void* Geant4Calorimeter::Hit::operator new(std::size_t size)   {
+  return HitPool<Hit>::instance().allocate(size);
+}
+
+/// Return the hit to the pool or the heap it was allocated from
+void Geant4Calorimeter::Hit::operator delete(void* ptr, std::size_t /* size */)   {
+  if ( ptr ) HitPool<Hit>::release(ptr);
+}
+
+/// Access the hit pool statistics of the calling thread
+Geant4HitData::PoolStatistics Geant4Calorimeter::Hit::poolStatistics()   {
+  return HitPool<Hit>::instance().statistics;
+}
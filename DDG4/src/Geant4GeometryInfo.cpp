@@ -14,6 +14,7 @@
 // Framework include files
 #include <DDG4/Geant4GeometryInfo.h>
 #include <DDG4/Geant4AssemblyVolume.h>
+#include <DDG4/Geant4VolumeManager.h>
 #include <DD4hep/Printout.h>
 
 // Geant4 include files
@@ -46,6 +47,7 @@ Geant4GeometryInfo::~Geant4GeometryInfo() {
   for( auto& a : g4AssemblyVolumes )
     delete a.second;
   g4AssemblyVolumes.clear();
+  dd4hep::detail::deletePtr(g4PathIndex);
 }
 
 /// The world placement
@@ -17,6 +17,9 @@
 #include <DDG4/Geant4Data.h>
 #include <G4Allocator.hh>
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep::sim;
 
 G4ThreadLocal G4Allocator<Geant4HitWrapper>* HitWrapperAllocator = 0;
@@ -72,6 +75,39 @@ Geant4HitWrapper::Wrapper Geant4HitWrapper::releaseData() {
   return w;
 }
 
+/// Allocate the hash table for a given number of keys
+void Geant4HitKeyIndex::reserve(size_t num_keys)   {
+  size_t num_slots = m_entries.empty() ? 16 : m_entries.size();
+  while ( num_slots < 2*num_keys ) num_slots <<= 1;
+  if ( num_slots > m_entries.size() )
+    rehash(num_slots);
+}
+
+/// Remove all keys. The hash table stays allocated
+void Geant4HitKeyIndex::clear()   {
+  if ( m_count > 0 )  {
+    std::fill(m_entries.begin(), m_entries.end(), Entry());
+    m_count = 0;
+  }
+}
+
+/// Resize the hash table and re-insert all entries
+void Geant4HitKeyIndex::rehash(size_t num_slots)   {
+  std::vector<Entry> entries(num_slots);
+  m_mask = num_slots - 1;
+  for( const Entry& e : m_entries )  {
+    if ( e.index != INVALID )  {
+      for( size_t slot = hash(e.key) & m_mask; ; slot = (slot + 1) & m_mask )  {
+        if ( entries[slot].index == INVALID )  {
+          entries[slot] = e;
+          break;
+        }
+      }
+    }
+  }
+  m_entries.swap(entries);
+}
+
 /// Default destructor
 Geant4HitCollection::Compare::~Compare()  {
 }
@@ -80,6 +116,7 @@ Geant4HitCollection::Compare::~Compare()  {
 Geant4HitCollection::~Geant4HitCollection() {
   m_hits.clear();
   m_keys.clear();
+  m_positionKeys.clear();
   InstanceCount::decrement(this);
 }
 
@@ -103,6 +140,13 @@ void Geant4HitCollection::clear()   {
   m_lastHit = ULONG_MAX;
   m_hits.clear();
   m_keys.clear();
+  m_positionKeys.clear();
+}
+
+/// Reserve space for a given number of hits (e.g. the hit count of the previous event)
+void Geant4HitCollection::reserve(size_t num_hits)   {
+  m_hits.reserve(num_hits);
+  m_keys.reserve(num_hits);
 }
 
 /// Find hit in a collection by comparison of attributes
@@ -123,32 +167,44 @@ void* Geant4HitCollection::findHit(const Compare& cmp)  {
 
 /// Find hit in a collection by comparison of the key
 Geant4HitWrapper* Geant4HitCollection::findHitByKey(VolumeID key)   {
-  Keys::const_iterator i=m_keys.find(key);
-  if ( i == m_keys.end() ) return 0;
-  m_lastHit = (*i).second;
-  return &m_hits.at(m_lastHit);
+  size_t idx = m_keys.find(key);
+  if ( idx == Keys::INVALID ) return 0;
+  m_lastHit = idx;
+  return &m_hits[idx];
 }
 
 /// Release all hits from the Geant4 container and pass ownership to the caller
 void Geant4HitCollection::releaseData(const ComponentCast& cast, std::vector<void*>* result) {
+  /// All hits are wrapped with the collection's manipulator: check the type once
+  if ( &cast == &m_manipulator->cast )  {
+    releaseHitsUnchecked(*result);
+    return;
+  }
   result->reserve(m_hits.size());
   for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
-    Geant4HitWrapper& w = m_hits.at(j);
+    Geant4HitWrapper& w = m_hits[j];
     Manip* m = w.manip();
     if (&cast == &m->cast)
       result->emplace_back(w.release());
     else
       result->emplace_back(m->cast.apply_downCast(cast, w.release()));
   }
+  m_statistics.numReleased += m_hits.size();
   m_lastHit = ULONG_MAX;
   m_keys.clear();
+  m_positionKeys.clear();
 }
 
 /// Release all hits from the Geant4 container. Ownership stays with the container
 void Geant4HitCollection::getData(const ComponentCast& cast, std::vector<void*>* result) {
+  /// All hits are wrapped with the collection's manipulator: check the type once
+  if ( &cast == &m_manipulator->cast )  {
+    getHitsUnchecked(*result);
+    return;
+  }
   result->reserve(m_hits.size());
   for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
-    Geant4HitWrapper& w = m_hits.at(j);
+    Geant4HitWrapper& w = m_hits[j];
     Manip* m = w.manip();
     if (&cast == &m->cast)
       result->emplace_back(w.data());
@@ -159,20 +215,18 @@ void Geant4HitCollection::getData(const ComponentCast& cast, std::vector<void*>*
 
 /// Release all hits from the Geant4 container and pass ownership to the caller
 void Geant4HitCollection::releaseHitsUnchecked(std::vector<void*>& result) {
-  result.reserve(m_hits.size());
-  for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
-    Geant4HitWrapper& w = m_hits.at(j);
+  result.reserve(result.size() + m_hits.size());
+  for (Geant4HitWrapper& w : m_hits)
     result.emplace_back(w.release());
-  }
+  m_statistics.numReleased += m_hits.size();
   m_lastHit = ULONG_MAX;
   m_keys.clear();
+  m_positionKeys.clear();
 }
 
 /// Release all hits from the Geant4 container. Ownership stays with the container
 void Geant4HitCollection::getHitsUnchecked(std::vector<void*>& result) {
-  result.reserve(m_hits.size());
-  for (size_t j = 0, n = m_hits.size(); j < n; ++j) {
-    Geant4HitWrapper& w = m_hits.at(j);
+  result.reserve(result.size() + m_hits.size());
+  for (Geant4HitWrapper& w : m_hits)
     result.emplace_back(w.data());
-  }
 }
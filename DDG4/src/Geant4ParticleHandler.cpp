@@ -219,12 +219,12 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
       return;
     }
     //other particles might not be in the particleMap yet, so we take them from here
-    existingParticle = m_suspendedPM.find(h.id());
-    if(existingParticle != m_suspendedPM.end()) {
-      m_currTrack.get_data(*(existingParticle->second));
+    auto isuspended = m_suspendedPM.find(h.id());
+    if(isuspended != m_suspendedPM.end()) {
+      m_currTrack.get_data(*(isuspended->second));
       // make sure we delete a suspended particle in the map, fill it back later...
-      delete (*existingParticle).second;
-      m_suspendedPM.erase(existingParticle);
+      delete (*isuspended).second;
+      m_suspendedPM.erase(isuspended);
       return;
     }
   }
@@ -362,7 +362,7 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     dynamic_cast<Geant4ParticleInformation*>(track->GetUserInformation());
   if ( !mask.isNull() || track_info )   {
     m_equivalentTracks[g4_id] = g4_id;
-    ParticleMap::iterator ip = m_particleMap.find(g4_id);
+    DenseParticleMap::iterator ip = m_particleMap.find(g4_id);
     if ( mask.isSet(G4PARTICLE_PRIMARY) )   {
       ph.dump2(outputLevel()-1,name(),"Add Primary",h.id(),ip!=m_particleMap.end());
     }
@@ -386,7 +386,7 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     // Need to find the last stored particle and OR this particle's mask
     // with the mask of the last stored particle
     auto iend = m_equivalentTracks.end(), iequiv=m_equivalentTracks.end();
-    ParticleMap::iterator ip;
+    DenseParticleMap::iterator ip;
     for(ip=m_particleMap.find(pid); ip == m_particleMap.end(); ip=m_particleMap.find(pid))  {
       if (iequiv=m_equivalentTracks.find(pid); iequiv == iend) break;  // ERROR
       pid = (*iequiv).second;
@@ -427,7 +427,7 @@ void Geant4ParticleHandler::beginEvent(const G4Event* event)  {
 void Geant4ParticleHandler::dumpMap(const char* tag)  const  {
   const std::string& n = name();
   Geant4ParticleHandle::header4(INFO,n,tag);
-  for(ParticleMap::const_iterator iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
+  for(DenseParticleMap::const_iterator iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
     Geant4ParticleHandle((*i).second).dump4(INFO,n,tag);
   }
 }
@@ -454,8 +454,17 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
   setVertexEndpointBit();
 
   // Now export the data to the final record.
+  // The dense stores are ordered by key: the maps are filled in linear time.
+  ParticleMap      particles;
+  TrackEquivalents equivalents;
+  for( const auto& p : m_particleMap )
+    particles.emplace_hint(particles.end(), p.first, p.second);
+  for( const auto& e : m_equivalentTracks )
+    equivalents.emplace_hint(equivalents.end(), e.first, e.second);
+  m_particleMap.clear();
+  m_equivalentTracks.clear();
   Geant4ParticleMap* part_map = context()->event().extension<Geant4ParticleMap>();
-  part_map->adopt(m_particleMap, m_equivalentTracks);
+  part_map->adopt(particles, equivalents);
   m_primaryMap = 0;
   clear();
 }
@@ -463,9 +472,9 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
 /// Rebase the simulated tracks, so that they fit to the generator particles
 void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   /// No we have to update the map of equivalent tracks and assign the 'equivalentTrack' entry
-  TrackEquivalents equivalents, orgParticles;
-  ParticleMap      finalParticles;
-  ParticleMap::const_iterator ipar, iend, i;
+  DenseEquivalents equivalents, orgParticles;
+  DenseParticleMap finalParticles;
+  DenseParticleMap::const_iterator ipar;
   int count;
 
   Geant4PrimaryInteraction* interaction = context()->event().extension<Geant4PrimaryInteraction>();
@@ -473,8 +482,9 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
 
   // (1.0) Copy the pre-defined particle mapping for the simulated tracks
   //       It is assumed the mapping is ZERO based without holes.
-  for(count = 0, iend=pm.end(), i=pm.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
+  count = 0;
+  for( const auto& i : pm )  {
+    Particle* p = i.second;
     orgParticles[p->id] = p->id;
     finalParticles[p->id] = p;
     if ( p->id > count ) count = p->id;
@@ -483,8 +493,9 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
     }
   }
   // (1.1) Define the new particle mapping for the simulated tracks
-  for(++count, iend=m_particleMap.end(), i=m_particleMap.begin(); i!=iend; ++i)  {
-    Particle* p = (*i).second;
+  ++count;
+  for( const auto& i : m_particleMap )  {
+    Particle* p = i.second;
     if ( (p->reason&G4PARTICLE_PRIMARY) != G4PARTICLE_PRIMARY )  {
       //if ( orgParticles.find(p->id) == orgParticles.end() )  {
       orgParticles[p->id] = count;
@@ -494,16 +505,16 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
     }
   }
   // (2) Re-evaluate the corresponding geant4 track equivalents using the new mapping
-  for(TrackEquivalents::iterator ie=m_equivalentTracks.begin(),ie_end=m_equivalentTracks.end(); ie!=ie_end; ++ie)  {
+  for(DenseEquivalents::iterator ie=m_equivalentTracks.begin(),ie_end=m_equivalentTracks.end(); ie!=ie_end; ++ie)  {
     int g4_equiv = (*ie).first;
     while( (ipar=m_particleMap.find(g4_equiv)) == m_particleMap.end() )  {
-      TrackEquivalents::const_iterator iequiv = m_equivalentTracks.find(g4_equiv);
+      DenseEquivalents::const_iterator iequiv = m_equivalentTracks.find(g4_equiv);
       if ( iequiv == ie_end )  {
         break;  // ERROR !! Will be handled by printout below because ipar==end()
       }
       g4_equiv = (*iequiv).second;
     }
-    TrackEquivalents::mapped_type equiv = (*ie).second;
+    DenseEquivalents::mapped_type equiv = (*ie).second;
     if ( ipar != m_particleMap.end() )   {
       Geant4ParticleHandle p = (*ipar).second;
       equivalents[(*ie).first] = p->id;  // requires (1) to be filled properly!
@@ -533,7 +544,7 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   for( auto& part : finalParticles )  {
     auto& p = part.second;
     if ( p->g4Parent > 0 )  {
-      TrackEquivalents::iterator iequ = equivalents.find(p->g4Parent);
+      DenseEquivalents::iterator iequ = equivalents.find(p->g4Parent);
       if ( iequ != equivalents.end() )  {
         equiv_id = (*iequ).second;//equivalents[p->g4Parent];
         if ( (ipar=finalParticles.find(equiv_id)) != finalParticles.end() )  {
@@ -584,8 +595,8 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
     }
   }
 #endif
-  m_equivalentTracks = equivalents;
-  m_particleMap = finalParticles;
+  m_equivalentTracks = std::move(equivalents);
+  m_particleMap = std::move(finalParticles);
 }
 
 /// Default callback to be answered if the particle should be kept if NO user handler is installed
@@ -618,10 +629,10 @@ bool Geant4ParticleHandler::defaultKeepParticle(Particle& particle)   {
 /// Clean the monte carlo record. Remove all unwanted stuff.
 /// This is the core of the object executed at the end of each event action.
 int Geant4ParticleHandler::recombineParents()  {
-  std::set<int> remove;
+  std::vector<int> remove;
 
   /// Need to start from BACK, to clean first the latest produced stuff.
-  for(ParticleMap::reverse_iterator i=m_particleMap.rbegin(); i!=m_particleMap.rend(); ++i)  {
+  for(DenseParticleMap::reverse_iterator i=m_particleMap.rbegin(); i!=m_particleMap.rend(); ++i)  {
     Particle* p = (*i).second;
     PropertyMask mask(p->reason);
     // Allow the user to force the particle handling either by
@@ -654,7 +665,7 @@ int Geant4ParticleHandler::recombineParents()  {
       //continue;
     }
     else if ( mask.isSet(G4PARTICLE_KEEP_PROCESS) )  {
-      if(ParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
+      if(DenseParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
         Particle* parent_part = (*ip).second;
         PropertyMask parent_mask(parent_part->reason);
         if ( parent_mask.isSet(G4PARTICLE_ABOVE_ENERGY_THRESHOLD) )   {
@@ -669,9 +680,9 @@ int Geant4ParticleHandler::recombineParents()  {
     /// Remove this track from the list and also do the cleanup in the parent's children list
     if ( remove_me )  {
       int g4_id = (*i).first;
-      remove.insert(g4_id);
+      remove.emplace_back(g4_id);
       m_equivalentTracks[g4_id] = p->g4Parent;
-      if(ParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
+      if(DenseParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
         Particle* parent_part = (*ip).second;
         PropertyMask(parent_part->reason).set(mask.value());
         parent_part->steps += p->steps;
@@ -703,7 +714,7 @@ void Geant4ParticleHandler::checkConsistency()  const   {
     PropertyMask mask(p->reason);
     PropertyMask status(p->status);
     std::set<int>& daughters = p->daughters;
-    ParticleMap::const_iterator j;
+    DenseParticleMap::const_iterator j;
     // For all particles, the set of daughters must be contained in the record.
     for( int id_dau : daughters )   {
       if ( j=m_particleMap.find(id_dau); j == m_particleMap.end() )   {
@@ -743,7 +754,9 @@ void Geant4ParticleHandler::setVertexEndpointBit() {
   for( auto& part : m_particleMap )   {
     auto* p = part.second;
     if( !p->parents.empty() )   {
-      Geant4Particle *parent(m_particleMap[ *p->parents.begin() ]);
+      auto ipar = m_particleMap.find(*p->parents.begin());
+      if ( ipar == m_particleMap.end() ) continue;
+      Geant4Particle *parent((*ipar).second);
       const double X( parent->vex - p->vsx );
       const double Y( parent->vey - p->vsy );
       const double Z( parent->vez - p->vsz );
@@ -16,6 +16,7 @@
 #include <DD4hep/Primitives.h>
 #include <DD4hep/InstanceCount.h>
 
+#include <DDG4/Geant4Data.h>
 #include <DDG4/Geant4Kernel.h>
 #include <DDG4/Geant4Mapping.h>
 #include <DDG4/Geant4StepHandler.h>
@@ -439,6 +440,7 @@ bool Geant4SensDetActionSequence::accept(const Geant4FastSimSpot* spot) const {
 
 /// G4VSensitiveDetector interface: Method for generating hit(s) using the information of G4Step object.
 bool Geant4SensDetActionSequence::process(const G4Step* step, G4TouchableHistory* history) {
+  Geant4HitData::PoolScope pool_scope;
   bool result = false;
   for (Geant4Sensitive* sensitive : m_actors)  {
     if ( sensitive->accept(step) )
@@ -450,6 +452,7 @@ bool Geant4SensDetActionSequence::process(const G4Step* step, G4TouchableHistory
 
 /// GFLASH/FastSim interface: Method for generating hit(s) using the information of the Geant4FastSimSpot object.
 bool Geant4SensDetActionSequence::processFastSim(const Geant4FastSimSpot* spot, G4TouchableHistory* history)  {
+  Geant4HitData::PoolScope pool_scope;
   bool result = false;
   for (Geant4Sensitive* sensitive : m_actors)  {
     if ( sensitive->accept(spot) )
@@ -464,10 +467,13 @@ bool Geant4SensDetActionSequence::processFastSim(const Geant4FastSimSpot* spot,
  *  be set to the G4HCofThisEvent object at one of these two methods.
  */
 void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
+  Geant4HitData::PoolScope pool_scope;
   m_hce = hce;
   for (std::size_t count = 0; count < m_collections.size(); ++count) {
     const HitCollection& cr = m_collections[count];
     Geant4HitCollection* col = (*cr.second.second)(name(), cr.first, cr.second.first);
+    if ( count < m_collectionSizes.size() && m_collectionSizes[count] > 0 )
+      col->reserve(m_collectionSizes[count]);
     int id = m_detector->GetCollectionID(count);
     m_hce->AddHitsCollection(id, col);
   }
@@ -477,8 +483,20 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
 
 /// G4VSensitiveDetector interface: Method invoked at the end of each event.
 void Geant4SensDetActionSequence::end(G4HCofThisEvent* hce) {
+  Geant4HitData::PoolScope pool_scope;
   m_end(hce);
   m_actors(&Geant4Sensitive::end, hce);
+  m_collectionSizes.resize(m_collections.size(), 0);
+  for (std::size_t count = 0; count < m_collections.size(); ++count) {
+    const auto* col = hce ? dynamic_cast<const Geant4HitCollection*>(hce->GetHC(m_detector->GetCollectionID(count))) : nullptr;
+    if ( !col ) continue;
+    const Geant4HitCollection::Statistics& stat = col->statistics();
+    m_collectionSizes[count] = col->GetSize();
+    if ( outputLevel() <= DEBUG )  {
+      debug("+++ Collection %-24s hits: %8ld memory: %10ld bytes released: %8ld",
+            m_collections[count].first.c_str(), long(stat.numHits), long(stat.hitBytes), long(stat.numReleased));
+    }
+  }
   // G4HCofThisEvent must be availible until end-event. m_hce = 0;
 }
 
@@ -26,6 +26,7 @@
 #include <G4VPhysicalVolume.hh>
 
 // C/C++ include files
+#include <atomic>
 #include <sstream>
 
 using namespace dd4hep::sim::Geant4GeometryMaps;
@@ -36,6 +37,17 @@ using namespace dd4hep;
 typedef std::pair<VolumeID,std::vector<std::pair<const BitFieldElement*, VolumeID> > > VolIDDescriptor;
 namespace {
 
+  /// Per-thread cache of the last touchable lookup: consecutive steps mostly stay in the same sensor
+  struct LastHit  {
+    /// Serial number of the index the cached entry belongs to
+    std::size_t                         serial = 0;
+    /// Cached index entry
+    const Geant4VolumePathIndex::Entry* entry  = nullptr;
+  };
+  thread_local LastHit s_lastHit;
+  /// Serial numbers of the flat path indices
+  std::atomic<std::size_t> s_indexSerial { 0 };
+
   /// Helper class to populate the Geant4 volume manager
   struct Populator {
     typedef std::vector<const TGeoNode*> Chain;
@@ -219,11 +231,76 @@ Geant4VolumeManager::Geant4VolumeManager(const Detector& description, Geant4Geom
   if (info && info->valid && info->g4Paths.empty()) {
     Populator p(description, *info);
     p.populate(description.world());
+    buildIndex();
     return;
   }
   except("Geant4VolumeManager", "Attempt populate from invalid Geant4 geometry info [Invalid-Info]");
 }
 
+/// Initializing constructor: build the index from the populated geometry information
+Geant4VolumePathIndex::Geant4VolumePathIndex(const Geant4GeometryInfo& info)
+  : serial(++s_indexSerial)
+{
+  std::size_t num_slots = 16;
+  while ( num_slots < 2*info.g4Paths.size() ) num_slots <<= 1;
+  entries.assign(num_slots, Entry());
+  slotMask = num_slots - 1;
+  for( const auto& p : info.g4Paths )   {
+    const auto& path = p.first;
+    Entry ent;
+    ent.path     = &path;
+    ent.volumeID = p.second.volumeID;
+    ent.first    = std::uint32_t(levels.size());
+    if ( p.second.flags != 0 )   {
+      bool resolved = true;
+      for( std::size_t j = 0; j < path.size(); ++j )   {
+        const auto* phys = path[j];
+        const Geant4GeometryMaps::G4PlacementMap* placements = nullptr;
+        if ( phys->IsParameterised() )
+          placements = &info.g4Parameterised;
+        else if ( phys->IsReplicated() )
+          placements = &info.g4Replicated;
+        else
+          continue;
+        auto it = placements->find(phys);
+        if ( it == placements->end() )   {
+          resolved = false;
+          break;
+        }
+        levels.emplace_back(Level { (*it).second.data()->params->field, int(j) });
+      }
+      /// Unresolved paths are left to the placement path map lookup, which reports the error
+      if ( !resolved )   {
+        levels.resize(ent.first);
+        continue;
+      }
+    }
+    ent.count = std::uint32_t(levels.size()) - ent.first;
+    ent.hash  = std::size_t(path.size());
+    for( const auto* phys : path )
+      ent.hash = hash(ent.hash, phys);
+    ent.hash ^= ent.hash >> 29;
+    for( std::size_t slot = ent.hash & slotMask; ; slot = (slot + 1) & slotMask )  {
+      if ( !entries[slot].path )  {
+        entries[slot] = ent;
+        ++count;
+        break;
+      }
+    }
+  }
+}
+
+/// Build the flat touchable lookup index if not yet present
+void Geant4VolumeManager::buildIndex() const   {
+  if ( checkValidity() && !ptr()->g4PathIndex )   {
+    Geant4GeometryInfo* info = ptr();
+    info->g4PathIndex = new Geant4VolumePathIndex(*info);
+    printout(DEBUG, "Geant4VolumeManager", "+++ Built flat touchable index: %ld paths, %ld slots, %ld copy number levels.",
+             long(info->g4PathIndex->count), long(info->g4PathIndex->entries.size()),
+             long(info->g4PathIndex->levels.size()));
+  }
+}
+
 /// Helper: Generate placement path from touchable object
 std::vector<const G4VPhysicalVolume*>
 Geant4VolumeManager::placementPath(const G4VTouchable* touchable, bool exception) const {
@@ -264,6 +341,24 @@ VolumeID Geant4VolumeManager::volumeID(const std::vector<const G4VPhysicalVolume
 
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const {
+  const Geant4VolumePathIndex* index = ptr() ? ptr()->g4PathIndex : nullptr;
+  if ( index && touchable )   {
+    int depth = touchable->GetHistoryDepth();
+    LastHit& last = s_lastHit;
+    if ( last.serial == index->serial && Geant4VolumePathIndex::match(*last.entry, touchable, depth) )   {
+      return index->volumeID(*last.entry, touchable);
+    }
+    if ( const auto* e = index->find(touchable, depth) )   {
+      last.serial = index->serial;
+      last.entry  = e;
+      return index->volumeID(*e, touchable);
+    }
+  }
+  return pathVolumeID(touchable);
+}
+
+/// Access CELLID by Geant4 touchable object using the placement path map (slow)
+VolumeID Geant4VolumeManager::pathVolumeID(const G4VTouchable* touchable) const {
   Geant4TouchableHandler handler(touchable);
   std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
   if (!path.empty() && checkValidity()) {
@@ -21,6 +21,7 @@
 
 #include <set>
 #include <string>
+#include <vector>
 
 
 namespace dd4hep {
@@ -67,10 +68,26 @@ namespace dd4hep {
        */
       Position position(const CellID& cellID) const;
 
+      /** Return the nominal global positions for a batch of cellIDs of sensitive volumes.
+       *  The cellIDs are grouped by their volume context: the readout, the segmentation and
+       *  the combined volume-to-world transformation are resolved once per group and then
+       *  applied to all cells of the group.
+       *  The output buffer positions must have space for num entries.
+       *  No Alignment corrections are applied.
+       *  If no sensitive volume is found, (0,0,0) is returned for the cell.
+       */
+      void positionNominal(const CellID* cellIDs, std::size_t num, Position* positions) const;
+
+      /** Return the nominal global positions for a batch of cellIDs of sensitive volumes.
+       *  The output vector is resized to the number of cellIDs.
+       */
+      void positionNominal(const std::vector<CellID>& cellIDs, std::vector<Position>& positions) const;
+
 
       /** Return the global cellID for the given global position.
        *  Note: this call is rather slow - only use it when really needed !
-       *  
+       *  It is also not thread-safe, since it uses the navigator of the global TGeoManager.
+       *  See CellIDPositionLocator for a fast and thread-safe alternative.
        */
       CellID cellID(const Position& global) const;
 
@@ -0,0 +1,125 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_CELLIDPOSITIONLOCATOR_H
+#define DDREC_CELLIDPOSITIONLOCATOR_H
+
+#include "DD4hep/Detector.h"
+#include "DD4hep/VolumeManager.h"
+
+#include <cstdint>
+#include <vector>
+
+class TGeoShape;
+
+namespace dd4hep {
+  namespace rec {
+
+    typedef DDSegmentation::CellID CellID;
+
+    /** Fast and thread-safe point location: position to cellID conversion without
+     *  navigating the global TGeoManager.
+     *
+     *  At construction all sensitive placements known to the VolumeManager are collected
+     *  together with their world bounding boxes, their world-to-local transformations
+     *  and their encoded volume ID. A bounding volume hierarchy is then built over the
+     *  placements. The structure is immutable once constructed: lookups only read shared
+     *  data. All mutable navigation state is kept in a State object, which is either
+     *  supplied per thread by the caller or created on the stack.
+     *
+     *  The lookup result is identical to CellIDPositionConverter::cellID(const Position&)
+     *  for all points inside sensitive volumes registered to the VolumeManager.
+     */
+    class CellIDPositionLocator {
+    public:
+      /// Maximal depth of the bounding volume hierarchy
+      enum { MAX_DEPTH = 64 };
+
+      /// Per-thread navigation state
+      struct State {
+        /// Index of the last placement found. Checked first on the next lookup
+        std::uint32_t last  { ~0U } ;
+        /// Traversal stack of the bounding volume hierarchy
+        std::uint32_t stack[MAX_DEPTH] ;
+      } ;
+
+      /// Cached data of one sensitive placement
+      struct Placement {
+        /// World -> local transformation: row-major rotation [0..8], translation [9..11]
+        double                      toLocal[12] ;
+        /// Shape of the sensitive volume
+        const TGeoShape*            solid   { nullptr } ;
+        /// Daughter nodes of the sensitive volume, which must not contain the point
+        const TGeoNode*             node    { nullptr } ;
+        /// Volume manager context of the placement
+        const VolumeManagerContext* context { nullptr } ;
+        /// Encoded volume ID prefix of the placement
+        VolumeID                    volumeID { 0 } ;
+      } ;
+
+      /// Node of the bounding volume hierarchy. Leaves reference a range of placements
+      struct Node {
+        double        lower[3] ;
+        double        upper[3] ;
+        /// Leaf: first placement index. Inner node: index of the second child (first child follows)
+        std::uint32_t index { 0 } ;
+        /// Number of placements (0 for inner nodes)
+        std::uint32_t count { 0 } ;
+      } ;
+
+    public:
+      /// The constructor - builds the bounding volume hierarchy from the volume manager
+      CellIDPositionLocator(const Detector& description) ;
+      /// Inhibit copy constructor
+      CellIDPositionLocator(const CellIDPositionLocator&) = delete ;
+      /// Inhibit assignment
+      CellIDPositionLocator& operator=(const CellIDPositionLocator&) = delete ;
+      /// Destructor
+      virtual ~CellIDPositionLocator() = default ;
+
+      /** Return the cellID for the given global position.
+       *  If the point is not inside a sensitive volume, 0 is returned.
+       */
+      CellID cellID(const Position& global) const ;
+
+      /** Return the cellID for the given global position using the caller's navigation state.
+       *  If the point is not inside a sensitive volume, 0 is returned.
+       */
+      CellID cellID(const Position& global, State& state) const ;
+
+      /** Find the sensitive placement containing the global point and return its local
+       *  coordinates. Returns NULL if the point is not inside a sensitive volume.
+       */
+      const Placement* findPlacement(const double global[3], double local[3], State& state) const ;
+
+      /// Number of sensitive placements in the hierarchy
+      std::size_t numPlacements() const { return _placements.size() ; }
+      /// Number of nodes of the hierarchy
+      std::size_t numNodes() const { return _nodes.size() ; }
+
+    protected:
+      /// Check if the point is inside the placement. Fills the local coordinates
+      bool contains(const Placement& p, const double global[3], double local[3]) const ;
+      /// Recursively build the hierarchy for the placement boxes perm[begin, end)
+      std::uint32_t build(const std::vector<Node>& boxes, std::vector<std::uint32_t>& perm,
+                          std::uint32_t begin, std::uint32_t end, int depth) ;
+
+      /// Sensitive placements ordered by the leaves of the hierarchy
+      std::vector<Placement> _placements{} ;
+      /// Bounding volume hierarchy in depth-first order. Node 0 is the root
+      std::vector<Node>      _nodes{} ;
+    } ;
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_CELLIDPOSITIONLOCATOR_H
@@ -18,11 +18,37 @@
 
 #include "TGeoManager.h"
 
+#include <algorithm>
+#include <utility>
+
 namespace dd4hep {
   namespace rec {
 
     using std::set;
 
+    namespace {
+
+      /// Readout of a context: cached while populating the volume manager, else searched
+      Readout contextReadout( const CellIDPositionConverter& conv, const VolumeManagerContext* context ) {
+        return context->readout.isValid() ? context->readout : conv.findReadout( context->element ) ;
+      }
+
+      /// Apply the fused volume-to-world transformation to a block of points stored as structure of arrays
+      void transformPoints( const double* t, std::size_t n,
+                            const double* __restrict__ lx, const double* __restrict__ ly, const double* __restrict__ lz,
+                            double* __restrict__ gx, double* __restrict__ gy, double* __restrict__ gz ) {
+        const double r00 = t[0], r01 = t[1], r02 = t[2] ;
+        const double r10 = t[3], r11 = t[4], r12 = t[5] ;
+        const double r20 = t[6], r21 = t[7], r22 = t[8] ;
+        const double t0  = t[9], t1  = t[10], t2 = t[11] ;
+        for( std::size_t i = 0 ; i < n ; ++i ) {
+          gx[i] = r00*lx[i] + r01*ly[i] + r02*lz[i] + t0 ;
+          gy[i] = r10*lx[i] + r11*ly[i] + r12*lz[i] + t1 ;
+          gz[i] = r20*lx[i] + r21*ly[i] + r22*lz[i] + t2 ;
+        }
+      }
+    }
+
     const VolumeManagerContext*
     CellIDPositionConverter::findContext(const CellID& cellID) const {
       return _volumeManager.lookupContext( cellID ) ;
@@ -38,47 +64,74 @@ namespace dd4hep {
 
     Position CellIDPositionConverter::positionNominal(const CellID& cell) const {
 
-      double l[3], e[3], g[3];
+      double l[3];
 
       const VolumeManagerContext* context = findContext( cell ) ;
 
       if( context == NULL)
 	return Position() ;
 
-      DetElement det = context->element ;
-      
+      // the readout is cached in the context - the recursive search is only a fall-back
+      Readout r = contextReadout( *this, context ) ;
 
-#if 0  // this uses the deprecated VolumeManagerContext::placement
+      Segmentation seg = r.segmentation() ;
+      Position local = seg.position(cell);
       
-      PlacedVolume pv = context->placement ;
+      local.GetCoordinates(l);
 
-      if( ! pv.volume().isSensitive() )
-	return Position() ;
-	
-      SensitiveDetector sd = pv.volume().sensitiveDetector();
-      Readout r = sd.readout() ;
+      // fused volume -> element -> world transformation
+      return context->localToWorld(l) ;
+    }
 
-#else
+    void CellIDPositionConverter::positionNominal(const std::vector<CellID>& cellIDs,
+                                                  std::vector<Position>& positions) const {
+      positions.resize( cellIDs.size() ) ;
+      positionNominal( cellIDs.data(), cellIDs.size(), positions.data() ) ;
+    }
 
-      // use a recursive search for the Readout
-      
-      Readout r = findReadout( det ) ;
+    void CellIDPositionConverter::positionNominal(const CellID* cellIDs, std::size_t num,
+                                                  Position* positions) const {
 
-#endif
+      // group the cells by volume context - stable with respect to the input order
+      std::vector< std::pair<const VolumeManagerContext*, std::size_t> > order( num ) ;
+      for( std::size_t i = 0 ; i < num ; ++i )
+        order[i] = std::make_pair( findContext( cellIDs[i] ), i ) ;
 
-      Segmentation seg = r.segmentation() ;
-      Position local = seg.position(cell);
-      
-      local.GetCoordinates(l);
+      std::sort( order.begin(), order.end() ) ;
 
-      const TGeoMatrix& volToElement = context->toElement();
-      volToElement.LocalToMaster(l, e);
+      // local and global coordinates of one group as structure of arrays
+      std::vector<double> loc( 3*num ), glob( 3*num ) ;
 
-      const TGeoMatrix& elementToGlobal = det.nominal().worldTransformation();
-      elementToGlobal.LocalToMaster(e, g);
+      for( std::size_t begin = 0, end = 0 ; begin < num ; begin = end ) {
 
+        const VolumeManagerContext* context = order[begin].first ;
+        for( end = begin+1 ; end < num && order[end].first == context ; ++end ) ;
 
-      return Position(g[0], g[1], g[2]);
+        std::size_t n = end - begin ;
+        Readout r = ( context ? contextReadout( *this, context ) : Readout() ) ;
+
+        if( ! r.isValid() ) {
+          for( std::size_t k = begin ; k < end ; ++k )
+            positions[ order[k].second ] = Position() ;
+          continue ;
+        }
+
+        Segmentation seg = r.segmentation() ;
+        double* lx = loc.data(), *ly = lx + n, *lz = ly + n ;
+        double* gx = glob.data(), *gy = gx + n, *gz = gy + n ;
+
+        for( std::size_t k = 0 ; k < n ; ++k ) {
+          Position local = seg.position( cellIDs[ order[begin+k].second ] ) ;
+          lx[k] = local.X() ;
+          ly[k] = local.Y() ;
+          lz[k] = local.Z() ;
+        }
+
+        transformPoints( context->worldTransformation(), n, lx, ly, lz, gx, gy, gz ) ;
+
+        for( std::size_t k = 0 ; k < n ; ++k )
+          positions[ order[begin+k].second ] = Position( gx[k], gy[k], gz[k] ) ;
+      }
     }
 
 
@@ -342,7 +395,7 @@ namespace dd4hep {
     std::vector<double> CellIDPositionConverter::cellDimensions(const CellID& cell) const {
       auto context = findContext( cell ) ;
       if( context == nullptr ) return { };
-      dd4hep::Readout r  = findReadout( context->element ) ;
+      dd4hep::Readout r  = contextReadout( *this, context ) ;
       dd4hep::Segmentation seg = r.segmentation() ;
       return seg.cellDimensions( cell );
     }
@@ -0,0 +1,257 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+#include "DDRec/CellIDPositionLocator.h"
+
+#include "DD4hep/Printout.h"
+#include "DD4hep/detail/VolumeManagerInterna.h"
+
+#include "TGeoBBox.h"
+#include "TGeoMatrix.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      /// Maximal number of placements per leaf of the hierarchy
+      constexpr std::uint32_t LEAF_SIZE = 4 ;
+      /// Tolerance added to the world bounding boxes
+      constexpr double        BOX_TOLERANCE = 1e-9 ;
+
+      /// Apply a 3x4 affine transformation
+      inline void transform( const double* t, const double in[3], double out[3] ) {
+        out[0] = t[0]*in[0] + t[1]*in[1] + t[2]*in[2] + t[9] ;
+        out[1] = t[3]*in[0] + t[4]*in[1] + t[5]*in[2] + t[10] ;
+        out[2] = t[6]*in[0] + t[7]*in[1] + t[8]*in[2] + t[11] ;
+      }
+
+      /// Check if the point is inside the axis aligned box
+      inline bool inside( const CellIDPositionLocator::Node& n, const double p[3] ) {
+        return p[0] >= n.lower[0] && p[0] <= n.upper[0] &&
+               p[1] >= n.lower[1] && p[1] <= n.upper[1] &&
+               p[2] >= n.lower[2] && p[2] <= n.upper[2] ;
+      }
+
+      /// Centroid coordinate of a box along an axis
+      inline double center( const CellIDPositionLocator::Node& n, int axis ) {
+        return 0.5 * ( n.lower[axis] + n.upper[axis] ) ;
+      }
+    }
+
+    CellIDPositionLocator::CellIDPositionLocator(const Detector& description) {
+
+      VolumeManager mgr = VolumeManager::getVolumeManager( description ) ;
+      const detail::VolumeManagerObject& top = *mgr.data<detail::VolumeManagerObject>() ;
+
+      std::vector<const VolumeManagerContext*> contexts ;
+      for( const auto& v : top.volumes )
+        contexts.emplace_back( v.second ) ;
+      for( const auto& s : top.subdetectors ) {
+        for( const auto& v : s.second.data<detail::VolumeManagerObject>()->volumes )
+          contexts.emplace_back( v.second ) ;
+      }
+
+      std::vector<Node> boxes ;
+      std::vector<Placement> placements ;
+      boxes.reserve( contexts.size() ) ;
+      placements.reserve( contexts.size() ) ;
+
+      for( const VolumeManagerContext* context : contexts ) {
+
+        PlacedVolume pv = context->volumePlacement() ;
+        if( ! pv.isValid() || ! pv.volume().isSensitive() )
+          continue ;
+
+        const TGeoBBox* bbox = dynamic_cast<const TGeoBBox*>( pv.volume()->GetShape() ) ;
+        if( ! bbox ) {
+          printout( WARNING, "CellIDPositionLocator", "+++ Ignore placement %s: shape has no bounding box.",
+                    pv.name() ) ;
+          continue ;
+        }
+
+        Placement p ;
+        const double* trafo = context->worldTransformation() ;
+        TGeoHMatrix toWorld ;
+        toWorld.SetRotation( trafo ) ;
+        toWorld.SetTranslation( trafo+9 ) ;
+        TGeoHMatrix toLocal = toWorld.Inverse() ;
+        std::copy( toLocal.GetRotationMatrix(), toLocal.GetRotationMatrix()+9, p.toLocal ) ;
+        std::copy( toLocal.GetTranslation(), toLocal.GetTranslation()+3, p.toLocal+9 ) ;
+        p.solid    = bbox ;
+        p.node     = pv.ptr() ;
+        p.context  = context ;
+        p.volumeID = context->identifier ;
+
+        // world bounding box from the 8 transformed corners of the local bounding box
+        Node box ;
+        const double* o = bbox->GetOrigin() ;
+        const double  d[3] = { bbox->GetDX(), bbox->GetDY(), bbox->GetDZ() } ;
+        std::fill( box.lower, box.lower+3,  std::numeric_limits<double>::max() ) ;
+        std::fill( box.upper, box.upper+3, -std::numeric_limits<double>::max() ) ;
+        for( int corner = 0 ; corner < 8 ; ++corner ) {
+          double l[3], g[3] ;
+          for( int k = 0 ; k < 3 ; ++k )
+            l[k] = o[k] + ( ( corner >> k ) & 1 ? d[k] : -d[k] ) ;
+          transform( trafo, l, g ) ;
+          for( int k = 0 ; k < 3 ; ++k ) {
+            box.lower[k] = std::min( box.lower[k], g[k] - BOX_TOLERANCE ) ;
+            box.upper[k] = std::max( box.upper[k], g[k] + BOX_TOLERANCE ) ;
+          }
+        }
+        boxes.emplace_back( box ) ;
+        placements.emplace_back( p ) ;
+      }
+
+      if( placements.empty() ) {
+        printout( WARNING, "CellIDPositionLocator", "+++ No sensitive placements found in the volume manager." ) ;
+        return ;
+      }
+
+      std::vector<std::uint32_t> perm( placements.size() ) ;
+      for( std::uint32_t i = 0 ; i < perm.size() ; ++i )
+        perm[i] = i ;
+
+      _nodes.reserve( 2 * placements.size() / LEAF_SIZE + 1 ) ;
+      build( boxes, perm, 0, perm.size(), 0 ) ;
+
+      // store the placements in leaf order
+      _placements.reserve( placements.size() ) ;
+      for( std::uint32_t i : perm )
+        _placements.emplace_back( placements[i] ) ;
+
+      printout( INFO, "CellIDPositionLocator", "+++ Bounding volume hierarchy with %ld nodes over %ld sensitive placements.",
+                _nodes.size(), _placements.size() ) ;
+    }
+
+    std::uint32_t CellIDPositionLocator::build(const std::vector<Node>& boxes, std::vector<std::uint32_t>& perm,
+                                               std::uint32_t begin, std::uint32_t end, int depth) {
+      Node node ;
+      double clower[3], cupper[3] ;
+      std::fill( node.lower, node.lower+3,  std::numeric_limits<double>::max() ) ;
+      std::fill( node.upper, node.upper+3, -std::numeric_limits<double>::max() ) ;
+      std::copy( node.lower, node.lower+3, clower ) ;
+      std::copy( node.upper, node.upper+3, cupper ) ;
+
+      for( std::uint32_t i = begin ; i < end ; ++i ) {
+        const Node& b = boxes[ perm[i] ] ;
+        for( int k = 0 ; k < 3 ; ++k ) {
+          node.lower[k] = std::min( node.lower[k], b.lower[k] ) ;
+          node.upper[k] = std::max( node.upper[k], b.upper[k] ) ;
+          clower[k] = std::min( clower[k], center( b, k ) ) ;
+          cupper[k] = std::max( cupper[k], center( b, k ) ) ;
+        }
+      }
+
+      // split along the axis with the largest extent of the box centers
+      int axis = 0 ;
+      for( int k = 1 ; k < 3 ; ++k ) {
+        if( cupper[k] - clower[k] > cupper[axis] - clower[axis] )
+          axis = k ;
+      }
+
+      std::uint32_t self = _nodes.size() ;
+      _nodes.emplace_back( node ) ;
+
+      if( end - begin <= LEAF_SIZE || depth >= MAX_DEPTH-2 || cupper[axis] <= clower[axis] ) {
+        _nodes[self].index = begin ;
+        _nodes[self].count = end - begin ;
+        return self ;
+      }
+
+      std::uint32_t mid = begin + ( end - begin ) / 2 ;
+      std::nth_element( perm.begin()+begin, perm.begin()+mid, perm.begin()+end,
+                        [&boxes, axis]( std::uint32_t a, std::uint32_t b ) {
+                          return center( boxes[a], axis ) < center( boxes[b], axis ) ; } ) ;
+
+      build( boxes, perm, begin, mid, depth+1 ) ;            // first child follows the parent
+      std::uint32_t second = build( boxes, perm, mid, end, depth+1 ) ;
+      _nodes[self].index = second ;
+      return self ;
+    }
+
+    bool CellIDPositionLocator::contains(const Placement& p, const double global[3], double local[3]) const {
+
+      transform( p.toLocal, global, local ) ;
+
+      if( ! p.solid->Contains( local ) )
+        return false ;
+
+      // the point must not be inside one of the daughter volumes
+      for( int i = 0, n = p.node->GetNdaughters() ; i < n ; ++i ) {
+        const TGeoNode* daughter = p.node->GetDaughter( i ) ;
+        double d[3] ;
+        daughter->MasterToLocal( local, d ) ;
+        if( daughter->GetVolume()->GetShape()->Contains( d ) )
+          return false ;
+      }
+      return true ;
+    }
+
+    const CellIDPositionLocator::Placement*
+    CellIDPositionLocator::findPlacement(const double global[3], double local[3], State& state) const {
+
+      // consecutive lookups are often in the same sensitive volume
+      if( state.last < _placements.size() && contains( _placements[state.last], global, local ) )
+        return &_placements[state.last] ;
+
+      if( _nodes.empty() )
+        return nullptr ;
+
+      std::uint32_t depth = 0 ;
+      state.stack[depth++] = 0 ;
+
+      while( depth > 0 ) {
+        std::uint32_t current = state.stack[--depth] ;
+        const Node& node = _nodes[current] ;
+
+        if( ! inside( node, global ) )
+          continue ;
+
+        if( node.count > 0 ) {
+          for( std::uint32_t i = node.index, last = node.index + node.count ; i < last ; ++i ) {
+            if( i != state.last && contains( _placements[i], global, local ) ) {
+              state.last = i ;
+              return &_placements[i] ;
+            }
+          }
+          continue ;
+        }
+        state.stack[depth++] = node.index ;
+        state.stack[depth++] = current + 1 ;
+      }
+      return nullptr ;
+    }
+
+    CellID CellIDPositionLocator::cellID(const Position& global, State& state) const {
+
+      double g[3], l[3] ;
+      global.GetCoordinates( g ) ;
+
+      const Placement* p = findPlacement( g, l, state ) ;
+      if( ! p || ! p->context->readout.isValid() )
+        return 0 ;
+
+      return p->context->readout.segmentation().cellID( Position( l[0], l[1], l[2] ), global, p->volumeID ) ;
+    }
+
+    CellID CellIDPositionLocator::cellID(const Position& global) const {
+      State state ;
+      return cellID( global, state ) ;
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
@@ -18,6 +18,7 @@
 #include "DD4hep/DD4hepUnits.h"
 #include "DD4hep/BitFieldCoder.h"
 #include "DDRec/CellIDPositionConverter.h"
+#include "DDRec/CellIDPositionLocator.h"
 
 #include "lcio.h"
 #include "IO/LCReader.h"
@@ -57,6 +58,8 @@ struct TestCounter{
 struct TestCounters{
   TestCounter position{} ;
   TestCounter cellid{} ;
+  TestCounter batch{} ;
+  TestCounter locator{} ;
 };
 
 typedef std::map<std::string, TestCounters > TestMap ;
@@ -78,6 +81,9 @@ int main_wrapper(int argc, char** argv ){
 
   CellIDPositionConverter idposConv( description )  ;
 
+  CellIDPositionLocator idLocator( description )  ;
+  CellIDPositionLocator::State locatorState ;
+
   
   //---------------------------------------------------------------------
   //    open lcio file with SimCalorimeterHits
@@ -129,6 +135,8 @@ int main_wrapper(int argc, char** argv ){
 
       int nHit = std::min( col->getNumberOfElements(), maxHit )  ;
      
+      std::vector<CellID> batchIDs ;
+      std::vector<Position> singlePositions ;
       
       for(int i=0 ; i< nHit ; ++i){
 	
@@ -156,9 +164,24 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].cellid.passed++ ;
 	else
 	  tMap[ colNames[icol] ].cellid.failed++ ;
+
+	CellID idFromLocator = idLocator.cellID( point, locatorState ) ;
+
+	std::stringstream sstl ;
+	sstl << " compare locator ids: " << det.name() << " " <<  idDecoder0.valueString(id) << "  -  " << idDecoder1.valueString(idFromLocator) ;
+
+	test( id, idFromLocator,  sstl.str() ) ;
+
+	if( ! strcmp( test.last_test_status() , "PASSED" ) )
+	  tMap[ colNames[icol] ].locator.passed++ ;
+	else
+	  tMap[ colNames[icol] ].locator.failed++ ;
 	  
 	Position pointFromDecoder = idposConv.position( id ) ;
 
+	batchIDs.emplace_back( id ) ;
+	singlePositions.emplace_back( idposConv.positionNominal( id ) ) ;
+
 	double d = dist(pointFromDecoder, point)  ;
 	std::stringstream sst1 ;
 	sst1 << " dist " << d << " ( " <<  point << " ) - ( " << pointFromDecoder << " )  - detElement: "
@@ -172,6 +195,24 @@ int main_wrapper(int argc, char** argv ){
 	  tMap[ colNames[icol] ].position.failed++ ;
 
       }
+
+      // ====== test the batch conversion against the single cell conversion ==================
+      std::vector<Position> batchPositions ;
+      idposConv.positionNominal( batchIDs, batchPositions ) ;
+
+      for(unsigned i=0, n=batchIDs.size() ; i<n ; ++i){
+
+	double d = dist( batchPositions[i], singlePositions[i] ) ;
+	std::stringstream sst2 ;
+	sst2 << " batch dist " << d << " ( " <<  singlePositions[i] << " ) - ( " << batchPositions[i] << " )" ;
+
+	test( d < epsilon , true  , sst2.str()  ) ;
+
+	if( ! strcmp( test.last_test_status() , "PASSED" ) )
+	  tMap[ colNames[icol] ].batch.passed++ ;
+	else
+	  tMap[ colNames[icol] ].batch.failed++ ;
+      }
     }
     
   }
@@ -187,10 +228,12 @@ int main_wrapper(int argc, char** argv ){
     unsigned total = res.second.position.passed+res.second.position.failed ;
     unsigned pos_failed = res.second.position.failed ;
     unsigned id_failed = res.second.cellid.failed ;
+    unsigned batch_failed = res.second.batch.failed ;
+    unsigned locator_failed = res.second.locator.failed ;
 
     
-    printf(" %-30s \t  failed position: %5d  failed cellID:  %5d    of total: %5d   \n",
-	   name.c_str(), pos_failed , id_failed, total ) ;
+    printf(" %-30s \t  failed position: %5d  failed cellID:  %5d  failed batch:  %5d  failed locator:  %5d    of total: %5d   \n",
+	   name.c_str(), pos_failed , id_failed, batch_failed, locator_failed, total ) ;
 
   }
   std::cout << "\n -------------------------------------------------------- " << std::endl ;
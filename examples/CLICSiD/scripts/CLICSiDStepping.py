@@ -0,0 +1,115 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+"""
+
+   Stepping benchmark using CLICSid: measure the share of the event
+   processing time spent in the sensitive detector actions.
+
+   The identical event sample is simulated twice in separate processes:
+   once with the standard tracker and calorimeter actions and once with
+   all sensitive detectors served by the Geant4VoidSensitiveAction.
+   The difference of the event loop times is attributed to the
+   sensitive detector processing (volume ID lookup, hit creation...).
+
+   Usage:
+   $> python CLICSiDStepping.py [-events <n>] [-particle <name>] [-energy <GeV>]
+                                [-mode sd|void]
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+from __future__ import absolute_import, unicode_literals
+import sys
+import logging
+
+logging.basicConfig(format='%(levelname)s: %(message)s', level=logging.INFO)
+logger = logging.getLogger(__name__)
+
+
+# ---------------------------------------------------------------------------
+def option(args, name, default):
+  if name in args:
+    return args[args.index(name) + 1]
+  return default
+
+
+# ---------------------------------------------------------------------------
+def benchmark(args):
+  import re
+  import subprocess
+  result = {}
+  for mode in ('void', 'sd'):
+    cmd = [sys.executable, __file__] + args + ['-mode', mode]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True).stdout
+    match = re.search(r'BENCHMARK mode:\s*(\w+) events:\s*(\d+) time:\s*([\d.]+) s', out)
+    if not match:
+      print(out)
+      logger.error('+++ Stepping benchmark in mode %s FAILED', mode)
+      return 1
+    result[mode] = (int(match.group(2)), float(match.group(3)))
+  events, t_sd = result['sd']
+  t_void = result['void'][1]
+  share = 100.0 * max(t_sd - t_void, 0.0) / max(t_sd, 1e-6)
+  logger.info('+++ %-22s %8s %10s %12s', 'Sensitive actions', 'Events', 'Time [s]', 'ms/event')
+  logger.info('+++ %-22s %8d %10.3f %12.2f', 'Void', events, t_void, 1e3 * t_void / max(events, 1))
+  logger.info('+++ %-22s %8d %10.3f %12.2f', 'Tracker/Calorimeter', events, t_sd, 1e3 * t_sd / max(events, 1))
+  logger.info('+++ Share of the event processing time in sensitive detectors: %.1f %%', share)
+  logger.info('TEST_PASSED')
+  return 0
+
+
+# ---------------------------------------------------------------------------
+def run(args):
+  import time
+  import DDG4
+  import CLICSid
+  import g4units
+
+  mode = option(args, '-mode', 'sd')
+  sid = CLICSid.CLICSid()
+  sid.loadGeometry()
+  DDG4.Core.setPrintFormat(str("%-32s %6s %s"))
+  sid.geant4.setupCshUI(ui=None)
+  sid.setupRandom('R', seed=987654321)
+  if mode == 'void':
+    sid.geant4.sensitive_types['tracker'] = 'Geant4VoidSensitiveAction'
+    sid.geant4.sensitive_types['calorimeter'] = 'Geant4VoidSensitiveAction'
+  sid.geant4.setupGun('Gun',
+                      particle=option(args, '-particle', 'e-'),
+                      energy=float(option(args, '-energy', 10)) * g4units.GeV,
+                      position=(0, 0, 0),
+                      multiplicity=1,
+                      isotrop=True,
+                      Standalone=True)
+  sid.setupDetectors()
+  sid.setupPhysics('QGSP_BERT')
+  sid.test_config()
+  # Warm-up event to exclude the lazy initialization from the measurement
+  sid.kernel.NumEvents = 1
+  sid.kernel.run()
+  events = int(option(args, '-events', 20))
+  sid.kernel.NumEvents = events
+  start = time.time()
+  sid.kernel.run()
+  stop = time.time()
+  logger.info('BENCHMARK mode: %s events: %d time: %.3f s', mode, events, stop - start)
+  sid.kernel.terminate()
+
+
+# ---------------------------------------------------------------------------
+if __name__ == "__main__":
+  args = sys.argv[1:]
+  if '-mode' in args:
+    run(args)
+  else:
+    sys.exit(benchmark(args))
@@ -0,0 +1,183 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_IOV_select \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -iovs 100000
+
+   Benchmark the selection of conditions pools from a store with many IOVs:
+   Populate the store with one pool per run, one pool per fill of 50 runs
+   and one pool per period of 5000 runs. Then compare the indexed selections
+   of the ConditionsIOVPool with a linear scan of all IOV ranges.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+#include "TRandom3.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+  /// Register a single condition for the IOV range
+  void populate(ConditionsManager manager, const IOVType* iov_typ, DetElement de,
+                const string& name, long first, long last)
+  {
+    ConditionsPool* pool = manager.registerIOV(*iov_typ, IOV::Key(first,last));
+    Condition cond(de.path()+"#"+name, name);
+    cond.bind<int>() = int(first);
+    cond->hash = ConditionKey::hashCode(de,name);
+    manager.registerUnlocked(*pool, cond);
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_IOV_select
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_iov = 100000, num_select = 10000;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-selects",argv[i],4) )
+      num_select = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_iov < 1 || num_select < 1 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_IOV_select              \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of runs with individual IOVs.            \n"
+      "     -selects <number>        Number of selections to be timed.               \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Populate the conditions store *********************/
+  DetElement world = description.world();
+  TTimeStamp start;
+  for(long run=1; run<=num_iov; ++run)  {
+    populate(manager, iov_typ, world, "run_constant", run, run);
+    if ( (run%50) == 1 )
+      populate(manager, iov_typ, world, "fill_constant", run, run+49);
+    if ( (run%5000) == 1 )
+      populate(manager, iov_typ, world, "period_constant", run, run+4999);
+  }
+  TTimeStamp stop;
+  ConditionsIOVPool* iov_pool = manager.iovPool(*iov_typ);
+  size_t num_pools = iov_pool->elements.size();
+  printout(INFO,"Populate","Registered %ld IOV pools for %d runs  [%8.3f sec]",
+           num_pools, num_iov, stop.AsDouble()-start.AsDouble());
+
+  TRandom3 random(1234);
+  vector<long> runs;
+  for(int i=0; i<num_select; ++i)
+    runs.emplace_back(1+long(random.Rndm()*num_iov));
+
+  bool   ok = true;
+  size_t num_indexed = 0, num_linear = 0;
+  double time_indexed = 0e0, time_linear = 0e0;
+  Condition::key_type key = ConditionKey::hashCode(world,"fill_constant");
+
+  // ++++++++++++++++++++++++ Select all conditions valid for a run
+  start = TTimeStamp();
+  for(long run : runs)  {
+    RangeConditions conditions;
+    IOV req(iov_typ, run), validity(iov_typ);
+    validity.reset().invert();
+    num_indexed += iov_pool->select(req, conditions, validity);
+  }
+  stop = TTimeStamp();
+  time_indexed = stop.AsDouble()-start.AsDouble();
+  start = TTimeStamp();
+  for(long run : runs)  {
+    RangeConditions conditions;
+    IOV req(iov_typ, run);
+    for(const auto& e : iov_pool->elements)  {
+      if ( IOV::key_contains_range(e.first, req.keyData) )
+        num_linear += e.second->select_all(conditions);
+    }
+  }
+  stop = TTimeStamp();
+  time_linear = stop.AsDouble()-start.AsDouble();
+  ok = ok && num_indexed == num_linear;
+  printout(ALWAYS,"Benchmark","+  select:      Indexed:%10.3f usec  Linear:%10.3f usec  Speed-up:%9.1f  Conditions:%ld/%ld",
+           1e6*time_indexed/num_select, 1e6*time_linear/num_select, time_linear/time_indexed,
+           num_indexed, num_linear);
+
+  // ++++++++++++++++++++++++ Select a condition over a range of runs
+  num_indexed = num_linear = 0;
+  start = TTimeStamp();
+  for(long run : runs)  {
+    RangeConditions conditions;
+    IOV req(iov_typ, IOV::Key(run, run+100));
+    num_indexed += iov_pool->selectRange(key, req, conditions);
+  }
+  stop = TTimeStamp();
+  time_indexed = stop.AsDouble()-start.AsDouble();
+  start = TTimeStamp();
+  for(long run : runs)  {
+    RangeConditions conditions;
+    const IOV::Key range(run, run+100);
+    for(const auto& e : iov_pool->elements)  {
+      if ( IOV::key_is_contained(e.first,range) ||
+           IOV::key_overlaps_lower_end(e.first,range) ||
+           IOV::key_overlaps_higher_end(e.first,range) )
+        num_linear += e.second->select(key, conditions);
+    }
+  }
+  stop = TTimeStamp();
+  time_linear = stop.AsDouble()-start.AsDouble();
+  ok = ok && num_indexed == num_linear;
+  printout(ALWAYS,"Benchmark","+  selectRange: Indexed:%10.3f usec  Linear:%10.3f usec  Speed-up:%9.1f  Conditions:%ld/%ld",
+           1e6*time_indexed/num_select, 1e6*time_linear/num_select, time_linear/time_indexed,
+           num_indexed, num_linear);
+
+  printout(INFO,"Statistics","+=========================================================================");
+  printout(ok ? ALWAYS : ERROR,"Statistics","+  IOV selection benchmark %s  [%ld pools, %d selections]",
+           ok ? "PASSED" : "FAILED", num_pools, num_select);
+  printout(INFO,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_IOV_select,condition_example)
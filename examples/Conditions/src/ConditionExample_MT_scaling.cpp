@@ -0,0 +1,166 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_MT_scaling \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -threads 8
+
+   Populate the conditions store by hand for a set of IOVs.
+   Then measure the throughput of concurrent slice preparations
+   for an increasing number of threads. Each thread owns its slice
+   and changes the IOV at every preparation.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DD4hep/Factories.h"
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+
+  /// Prepare the slice for a sequence of IOVs. Each call changes the IOV
+  void run_prepares(ConditionsManager manager, const IOVType* iov_typ, ConditionsSlice* slice,
+                    int identifier, int num_iov, int num_prepare,
+                    mutex& guard, ConditionsManager::Result& totals)
+  {
+    ConditionsManager::Result sum;
+    for(int i=0; i<num_prepare; ++i)  {
+      long iov_val = 1 + ((identifier+i)%num_iov)*10 + (i%10);
+      IOV  iov(iov_typ, iov_val);
+      sum += manager.prepare(iov, *slice);
+    }
+    lock_guard<mutex> lock(guard);
+    totals += sum;
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_MT_scaling
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_iov = 10, num_threads = int(thread::hardware_concurrency()), num_prepare = 200;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-prepares",argv[i],4) )
+      num_prepare = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_iov < 1 || num_threads < 1 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_MT_scaling              \n"
+      "     -input    <string>       Geometry file                                   \n"
+      "     -iovs     <number>       Number of IOV slots.                            \n"
+      "     -prepares <number>       Number of slice preparations per thread.        \n"
+      "     -threads  <number>       Maximal number of execution threads.            \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slice ********************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+
+  /******************** Populate the conditions store *********************/
+  for(int i=0; i<num_iov; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool* pool = manager.registerIOV(*iov.iovType, iov.key());
+    int count = Scanner().scan(ConditionsCreator(*slice, *pool, DEBUG),description.world());
+    printout(INFO,"Example", "Setup %d conditions for IOV:%s", count, iov.str().c_str());
+  }
+
+  /******************** Initial pass: compute all derived conditions ******/
+  ConditionsManager::Result totals;
+  for(int i=0; i<num_iov; ++i)  {
+    IOV iov(iov_typ, 1+i*10);
+    totals += manager.prepare(iov, *slice);
+  }
+  printout(INFO,"Example", "Initial pass: (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+           totals.selected, totals.loaded, totals.computed, totals.missing);
+
+  // ++++++++++++++++++++++++ Now measure the scaling with the number of threads
+  mutex  guard;
+  double rate_1 = 0.0;
+  for(int n=1; ; n = min(2*n, num_threads))  {
+    vector<ConditionsSlice*> slices;
+    vector<thread*>          threads;
+    ConditionsManager::Result res;
+    for(int i=0; i<n; ++i)
+      slices.push_back(new ConditionsSlice(*slice));
+    auto start = chrono::high_resolution_clock::now();
+    for(int i=0; i<n; ++i)  {
+      ConditionsSlice* s = slices[i];
+      threads.push_back(new thread([&manager, iov_typ, s, i, num_iov, num_prepare, &guard, &res] {
+            run_prepares(manager, iov_typ, s, i, num_iov, num_prepare, guard, res); }));
+    }
+    for(thread* t : threads)  {
+      t->join();
+      delete t;
+    }
+    chrono::duration<double> secs = chrono::high_resolution_clock::now() - start;
+    for(ConditionsSlice* s : slices)
+      delete s;
+    double rate = double(n*num_prepare)/secs.count();
+    if ( n == 1 ) rate_1 = rate;
+    printout(ALWAYS,"Scaling",
+             "+  Threads:%3d  Prepares:%7d  Time:%8.3f sec  Rate:%10.1f prepares/sec  "
+             "Speed-up:%6.2f  (S:%8ld,L:%6ld,C:%6ld,M:%ld)",
+             n, n*num_prepare, secs.count(), rate, rate/rate_1,
+             res.selected, res.loaded, res.computed, res.missing);
+    totals += res;
+    if ( n == num_threads ) break;
+  }
+  printout(INFO,"Statistics","+=========================================================================");
+  printout(ALWAYS,"Statistics","+  Scaling test finished. Missing conditions: %ld", totals.missing);
+  printout(INFO,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_MT_scaling,condition_example)
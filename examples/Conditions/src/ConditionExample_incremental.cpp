@@ -0,0 +1,159 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_incremental \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -iovs 10 -changes 2
+
+   Populate the conditions store by hand: the conditions of most detector elements
+   are valid for all IOVs, the conditions of a few detector elements change
+   at every IOV. Then prepare the slice for a sequence of IOVs with full
+   and with incremental preparation and compare the timings.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DD4hep/Factories.h"
+#include "TStatistic.h"
+#include "TTimeStamp.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+  /// Prepare the slice for a sequence of IOVs and accumulate the results
+  ConditionsManager::Result prepare(ConditionsManager manager, ConditionsSlice& slice, const IOVType* iov_typ,
+                                    int first, int last, TStatistic& stat, vector<size_t>& totals)
+  {
+    ConditionsManager::Result sum;
+    for(int i=first; i<last; ++i)  {
+      IOV req_iov(iov_typ,i*10+5);
+      TTimeStamp start;
+      ConditionsManager::Result res = manager.prepare(req_iov,slice);
+      TTimeStamp stop;
+      stat.Fill(stop.AsDouble()-start.AsDouble());
+      printout(INFO,"Prepare","Total %-6ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%4ld,R:%6ld) of type %-25s [%8.3f sec]",
+               res.total(), res.selected, res.loaded, res.computed, res.missing, res.reused,
+               req_iov.str().c_str(), stop.AsDouble()-start.AsDouble());
+      totals.emplace_back(res.total());
+      sum += res;
+    }
+    return sum;
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_incremental
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_iov = 10, num_change = 2;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-changes",argv[i],4) )
+      num_change = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || num_iov < 2 || num_change < 1 )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_incremental             \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of IOVs for each of the two passes.      \n"
+      "     -changes <number>        Number of detector elements with conditions     \n"
+      "                              changing at every IOV.                          \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slice ********************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice> slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+
+  /******************** Populate the conditions store *********************/
+  // Conditions of the first detector elements change at every IOV, all others are static
+  vector<DetElement> elements;
+  Scanner(detElementsCollector(elements),description.world());
+  num_change = min(num_change, int(elements.size()));
+  IOV static_iov(iov_typ, IOV::Key(1,2*num_iov*10));
+  ConditionsPool* static_pool = manager.registerIOV(*static_iov.iovType, static_iov.key());
+  ConditionsCreator static_creator(*slice, *static_pool, DEBUG);
+  for(size_t j=num_change; j<elements.size(); ++j)
+    static_creator(elements[j], 0);
+  for(int i=0; i<2*num_iov; ++i)  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool* pool = manager.registerIOV(*iov.iovType, iov.key());
+    ConditionsCreator creator(*slice, *pool, DEBUG);
+    for(int j=0; j<num_change; ++j)
+      creator(elements[j], 0);
+  }
+
+  vector<size_t> full_totals, incr_totals;
+  TStatistic full_stat("Full"), incr_stat("Incremental");
+  // ++++++++++++++++++++++++ Full selection at every IOV change
+  manager["IncrementalPrepare"] = false;
+  ConditionsManager::Result full = prepare(manager, *slice, iov_typ, 0, num_iov, full_stat, full_totals);
+  // ++++++++++++++++++++++++ Incremental update at every IOV change
+  manager["IncrementalPrepare"] = true;
+  ConditionsManager::Result incr = prepare(manager, *slice, iov_typ, num_iov, 2*num_iov, incr_stat, incr_totals);
+
+  // The first preparation computes the derived conditions of the static detector elements.
+  // Afterwards every preparation must see the identical number of conditions.
+  bool ok = full.missing == 0 && incr.missing == 0 && full.reused == 0 && incr.reused > 0;
+  for(int i=1; i<num_iov; ++i)
+    ok = ok && full_totals[i] == incr_totals[i] && full_totals[i] == full_totals[0];
+  printout(INFO,"Statistics","+======= Summary: # of IOV: %3d  # of changing elements: %3d ==============",
+           num_iov, num_change);
+  printout(INFO,"Statistics","+  %-12s:  %11.5g +- %11.4g  RMS = %11.5g  N = %lld",
+           full_stat.GetName(), full_stat.GetMean(), full_stat.GetMeanErr(), full_stat.GetRMS(), full_stat.GetN());
+  printout(INFO,"Statistics","+  %-12s:  %11.5g +- %11.4g  RMS = %11.5g  N = %lld",
+           incr_stat.GetName(), incr_stat.GetMean(), incr_stat.GetMeanErr(), incr_stat.GetRMS(), incr_stat.GetN());
+  printout(INFO,"Statistics","+  Full:        (S:%6ld,L:%6ld,C:%6ld,M:%ld,R:%ld)",
+           full.selected, full.loaded, full.computed, full.missing, full.reused);
+  printout(INFO,"Statistics","+  Incremental: (S:%6ld,L:%6ld,C:%6ld,M:%ld,R:%ld)  Speed-up: %6.2f",
+           incr.selected, incr.loaded, incr.computed, incr.missing, incr.reused,
+           full_stat.GetMean()/incr_stat.GetMean());
+  printout(ok ? INFO : ERROR,"Statistics","+  Incremental preparation test %s",ok ? "PASSED" : "FAILED");
+  printout(INFO,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_incremental,condition_example)
@@ -0,0 +1,349 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_mmap \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml \
+   -mode save -conditions Conditions.root -snapshot Conditions.snap -iovs 30
+
+   Test the memory mapped conditions snapshots:
+   -mode save:     Populate the conditions store and save the IOV pools
+                   to a ROOT snapshot and to a memory mapped snapshot.
+   -mode compare:  Read both snapshots and compare every condition
+                   of the ROOT snapshot with the mapped one.
+   -mode load:     Prepare the slices for all IOVs loading the required
+                   conditions on demand from the mapped snapshot.
+   -mode lazy:     Prepare the slices for all IOVs with lazy loading and access
+                   only the conditions of the first detector element.
+   -mode shared:   Prepare two slices for each IOV with lazy loading and access
+                   the same conditions from both slices concurrently.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DDCond/ConditionsManager.h"
+#include "DDCond/ConditionsIOVPool.h"
+#include "DDCond/ConditionsSlice.h"
+#include "DDCond/ConditionsDataLoader.h"
+#include "DDCond/ConditionsRootPersistency.h"
+#include "DDCond/ConditionsMmapPersistency.h"
+#include "DD4hep/detail/ConditionsInterna.h"
+#include "DD4hep/Factories.h"
+
+// C/C++ include files
+#include <thread>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+  typedef cond::ConditionsMmapPersistency MmapPersistency;
+
+  /// Flat binary representation of a condition payload for comparisons
+  string flat_payload(Condition cond)  {
+    string buffer;
+    uint64_t count = 0;
+    const auto* codec = MmapPersistency::codec(cond.typeInfo());
+    if ( codec ) codec->write(cond.ptr()->data.ptr(), buffer, count);
+    return buffer;
+  }
+
+  /// Save the IOV pools to a ROOT snapshot and to a mapped snapshot
+  int save_snapshots(Detector& description, ConditionsManager manager, const IOVType* iov_typ,
+                     int num_iov, const string& conditions, const string& snapshot)
+  {
+    shared_ptr<ConditionsContent> content(new ConditionsContent());
+    shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+    Scanner(ConditionsKeys(*content,INFO),description.world());
+    Scanner(ConditionsDependencyCreator(*content,DEBUG,true),description.world());
+    for(int i=0; i<num_iov; ++i)  {
+      IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+      ConditionsPool* iov_pool = manager.registerIOV(*iov.iovType, iov.key());
+      Scanner(ConditionsCreator(*slice, *iov_pool, INFO),description.world(),0,true);
+    }
+    ConditionsManager::Result total;
+    for(int i=0; i<num_iov; ++i)  {
+      IOV req_iov(iov_typ,i*10+5);
+      total += manager.prepare(req_iov,*slice);
+    }
+    cond::ConditionsRootPersistency root("DD4hep Conditions");
+    MmapPersistency mmap;
+    size_t num_root = root.add("ConditionsIOVPool No 1",*manager.iovPool(*iov_typ));
+    size_t num_mmap = mmap.add(*manager.iovPool(*iov_typ));
+    int  root_bytes = root.save(conditions);
+    long mmap_bytes = mmap.save(snapshot);
+    printout(ALWAYS,"Example","+++ ROOT snapshot: Wrote %d Bytes (%ld conditions) to '%s' [%8.3f seconds].",
+             root_bytes, num_root, conditions.c_str(), root.duration);
+    printout(ALWAYS,"Example","+++ Mapped snapshot: Wrote %ld Bytes (%ld conditions) to '%s' [%8.3f seconds].",
+             mmap_bytes, num_mmap, snapshot.c_str(), mmap.duration);
+    if ( root_bytes > 0 && mmap_bytes > 0 && num_root == num_mmap )  {
+      printout(ALWAYS,"Example","+++ Successfully saved %ld conditions to snapshots.",num_mmap);
+    }
+    printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+             total.total(), total.selected, total.loaded, total.computed, total.missing);
+    return 1;
+  }
+
+  /// Compare every condition of the ROOT snapshot with the mapped snapshot
+  int compare_snapshots(const string& conditions, const string& snapshot)   {
+    auto root = cond::ConditionsRootPersistency::load(conditions.c_str(),"DD4hep Conditions");
+    auto mmap = MmapPersistency::load(snapshot);
+    size_t num_ok = 0, num_bad = 0, num_mapped = 0;
+    printout(ALWAYS,"Statistics","+  Loaded ROOT snapshot in %8.3f seconds, mapped snapshot in %8.3f seconds.",
+             root->duration, mmap->duration);
+    for( auto& p : root->iovPools )  {
+      const IOV::Key& key = p.first.second.second;
+      const cond::ConditionsMmapPersistency::PoolRecord* pool = 0;
+      for( size_t i=0; i<mmap->numPools(); ++i )  {
+        const auto& rec = mmap->pool(i);
+        if ( rec.lower == key.first && rec.upper == key.second &&
+             p.first.second.first.first == mmap->string(rec.iov_name) )  {
+          pool = &rec;
+          break;
+        }
+      }
+      num_mapped += pool ? pool->num_entries : 0;
+      for( Condition c : p.second )   {
+        const auto* entry = pool ? mmap->find(*pool, c.key()) : 0;
+        Condition m = entry ? mmap->get(*entry) : Condition();
+        if ( m.isValid() && m.typeInfo() == c.typeInfo() && m->flags == c->flags &&
+             m->value == c->value && flat_payload(m) == flat_payload(c) &&
+             m.data().str() == c.data().str() )  {
+          ++num_ok;
+          continue;
+        }
+        printout(ERROR,"Compare","+++ Condition %016llX differs between the snapshots.",c.key());
+        ++num_bad;
+      }
+    }
+    bool ok = num_bad == 0 && num_ok > 0 && num_ok == num_mapped;
+    printout(INFO,"Statistics","+=========================================================================");
+    printout(ok ? ALWAYS : ERROR,"Statistics","+  Snapshot round-trip %s: %ld identical, %ld different conditions.",
+             ok ? "PASSED" : "FAILED", num_ok, num_bad);
+    printout(INFO,"Statistics","+=========================================================================");
+    return 1;
+  }
+
+  /// Prepare the slices loading the required conditions from the mapped snapshot
+  int load_snapshot(Detector& description, ConditionsManager manager, const IOVType* iov_typ,
+                    int num_iov, const string& snapshot)
+  {
+    shared_ptr<ConditionsContent> content(new ConditionsContent());
+    shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+    Scanner(ConditionsKeys(*content,INFO),description.world());
+    Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+    manager.loader().addSource(snapshot);
+    ConditionsManager::Result total;
+    for(int i=0; i<num_iov; ++i)  {
+      IOV req_iov(iov_typ,i*10+5);
+      ConditionsManager::Result r = manager.prepare(req_iov,*slice);
+      total += r;
+      printout(INFO,"Prepare","Total %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) of IOV %s",
+               r.total(), r.selected, r.loaded, r.computed, r.missing, req_iov.str().c_str());
+    }
+    bool ok = total.missing == 0 && total.loaded > 0;
+    printout(ALWAYS,"Statistics","+=========================================================================");
+    printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+             total.total(), total.selected, total.loaded, total.computed, total.missing);
+    printout(ok ? ALWAYS : ERROR,"Statistics","+  Snapshot load %s",ok ? "PASSED" : "FAILED");
+    printout(ALWAYS,"Statistics","+=========================================================================");
+    return 1;
+  }
+
+  /// Number of conditions registered to the conditions manager
+  size_t num_registered(ConditionsManager manager, const IOVType* iov_typ)   {
+    size_t count = 0;
+    ConditionsIOVPool* iov_pool = manager.iovPool(*iov_typ);
+    if ( iov_pool )  {
+      for( const auto& e : iov_pool->elements )
+        count += e.second->size();
+    }
+    return count;
+  }
+
+  /// Prepare the slices with lazy loading and access the conditions of one detector element
+  int lazy_snapshot(Detector& description, ConditionsManager manager, const IOVType* iov_typ,
+                    int num_iov, const string& snapshot)
+  {
+    shared_ptr<ConditionsContent> content(new ConditionsContent());
+    shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
+    auto   reference = MmapPersistency::load(snapshot);
+    size_t num_bad = 0, num_access = 0, num_prepare = 0;
+    DetElement de = description.world().children().begin()->second;
+
+    Scanner(ConditionsKeys(*content,INFO),description.world());
+    manager.loader().addSource(snapshot);
+    ConditionsManager::Result total;
+    for(int i=0; i<num_iov; ++i)  {
+      IOV req_iov(iov_typ,i*10+5);
+      size_t num_before = num_registered(manager, iov_typ);
+      ConditionsManager::Result r = manager.prepare(req_iov,*slice);
+      total += r;
+      // Nothing is loaded while preparing: only the accessed conditions are loaded
+      num_prepare += num_registered(manager, iov_typ) - num_before;
+      vector<size_t> pools;
+      reference->select(req_iov, pools);
+      for( Condition c : slice->get(de) )   {
+        const auto* entry = pools.empty() ? 0 : reference->find(reference->pool(pools[0]), c.key());
+        Condition m = entry ? reference->get(*entry) : Condition();
+        ++num_access;
+        if ( !c.isValid() || !m.isValid() || c->testFlag(Condition::ONDEMAND) ||
+             flat_payload(c) != flat_payload(m) )  {
+          printout(ERROR,"Lazy","+++ Condition %016llX was not properly loaded.",c.isValid() ? c.key() : 0ULL);
+          ++num_bad;
+        }
+      }
+      printout(INFO,"Prepare","Total %ld conditions (S:%ld,L:%ld,C:%ld,M:%ld) of IOV %s",
+               r.total(), r.selected, r.loaded, r.computed, r.missing, req_iov.str().c_str());
+    }
+    size_t num_loaded = num_registered(manager, iov_typ);
+    bool ok = total.missing == 0 && num_bad == 0 && num_prepare == 0 &&
+      num_access > 0 && num_loaded == num_access && num_loaded < total.loaded;
+    printout(ALWAYS,"Statistics","+=========================================================================");
+    printout(ALWAYS,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+             total.total(), total.selected, total.loaded, total.computed, total.missing);
+    printout(ALWAYS,"Statistics","+  Loaded %ld out of %ld deferred conditions on access.",
+             num_loaded, total.loaded);
+    printout(ok ? ALWAYS : ERROR,"Statistics","+  Lazy snapshot load %s",ok ? "PASSED" : "FAILED");
+    printout(ALWAYS,"Statistics","+=========================================================================");
+    return 1;
+  }
+
+  /// Prepare two slices for the same IOV and resolve the same placeholders concurrently
+  int shared_snapshot(Detector& description, ConditionsManager manager, const IOVType* iov_typ,
+                      int num_iov, const string& snapshot)
+  {
+    shared_ptr<ConditionsContent> content(new ConditionsContent());
+    shared_ptr<ConditionsSlice>   slice1(new ConditionsSlice(manager,content));
+    shared_ptr<ConditionsSlice>   slice2(new ConditionsSlice(manager,content));
+    size_t num_bad = 0, num_access = 0;
+    DetElement de = description.world().children().begin()->second;
+
+    Scanner(ConditionsKeys(*content,INFO),description.world());
+    manager.loader().addSource(snapshot);
+    for(int i=0; i<num_iov; ++i)  {
+      IOV req_iov(iov_typ,i*10+5);
+      vector<Condition> cond1, cond2;
+      manager.prepare(req_iov,*slice1);
+      manager.prepare(req_iov,*slice2);
+      // Both slices hold placeholders for the same keys: resolve them at the same time
+      thread t1([&cond1, &slice1, de]()  {  cond1 = slice1->get(de);  });
+      thread t2([&cond2, &slice2, de]()  {  cond2 = slice2->get(de);  });
+      t1.join();
+      t2.join();
+      if ( cond1.size() != cond2.size() )  {
+        printout(ERROR,"Shared","+++ The slices of IOV %s differ in size.",req_iov.str().c_str());
+        ++num_bad;
+        continue;
+      }
+      for( size_t j=0; j<cond1.size(); ++j, ++num_access )  {
+        Condition c1 = cond1[j], c2 = cond2[j];
+        if ( !c1.isValid() || c1.ptr() != c2.ptr() || c1->testFlag(Condition::ONDEMAND) )  {
+          printout(ERROR,"Shared","+++ Condition %016llX was not resolved to the same object.",
+                   c1.isValid() ? c1.key() : 0ULL);
+          ++num_bad;
+        }
+      }
+    }
+    // Every condition accessed by both slices must be registered exactly once
+    size_t num_loaded = num_registered(manager, iov_typ);
+    bool ok = num_bad == 0 && num_access > 0 && num_loaded == num_access;
+    printout(ALWAYS,"Statistics","+=========================================================================");
+    printout(ALWAYS,"Statistics","+  Resolved %ld conditions from two slices. Registered %ld conditions.",
+             num_access, num_loaded);
+    printout(ok ? ALWAYS : ERROR,"Statistics","+  Shared lazy snapshot load %s",ok ? "PASSED" : "FAILED");
+    printout(ALWAYS,"Statistics","+=========================================================================");
+    return 1;
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_mmap
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input, conditions, snapshot, mode;
+  int    num_iov = 10;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-conditions",argv[i],4) )
+      conditions = argv[++i];
+    else if ( 0 == ::strncmp("-snapshot",argv[i],4) )
+      snapshot = argv[++i];
+    else if ( 0 == ::strncmp("-mode",argv[i],4) )
+      mode = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() || snapshot.empty() ||
+       !(mode == "save" || mode == "compare" || mode == "load" || mode == "lazy" || mode == "shared") ||
+       ((mode == "save" || mode == "compare") && conditions.empty()) )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_mmap                    \n"
+      "     -input       <string>    Geometry file                                   \n"
+      "     -mode        <string>    save, compare, load, lazy or shared.            \n"
+      "     -conditions  <string>    ROOT snapshot file (save and compare).          \n"
+      "     -snapshot    <string>    Memory mapped snapshot file.                    \n"
+      "     -iovs        <number>    Number of parallel IOV slots for processing.    \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+  if ( mode == "compare" )  {
+    return compare_snapshots(conditions, snapshot);
+  }
+
+  /******************** Initialize the conditions manager *****************/
+  description.apply("DD4hep_ConditionsManagerInstaller",0,(char**)0);
+  ConditionsManager manager = ConditionsManager::from(description);
+  manager["PoolType"]       = "DD4hep_ConditionsLinearPool";
+  manager["UserPoolType"]   = "DD4hep_ConditionsMapUserPool";
+  manager["UpdatePoolType"] = "DD4hep_ConditionsLinearUpdatePool";
+  if ( mode == "load" || mode == "lazy" || mode == "shared" )  {
+    manager["LoaderType"]   = "DD4hep_Conditions_mmap_snapshot_Loader";
+  }
+  if ( mode == "lazy" || mode == "shared" )  {
+    manager["LazyLoading"]  = true;
+  }
+  manager.initialize();
+  const IOVType* iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  if ( mode == "save" )
+    return save_snapshots(description, manager, iov_typ, num_iov, conditions, snapshot);
+  else if ( mode == "lazy" )
+    return lazy_snapshot(description, manager, iov_typ, num_iov, snapshot);
+  else if ( mode == "shared" )
+    return shared_snapshot(description, manager, iov_typ, num_iov, snapshot);
+  return load_snapshot(description, manager, iov_typ, num_iov, snapshot);
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_mmap,condition_example)
@@ -0,0 +1,135 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_ConditionExample_parallel \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml -threads 4
+
+   Populate the conditions store by hand for a set of IOVs.
+   Then compute the derived conditions for half of the IOVs serially
+   and for the other half in parallel and compare the timings.
+
+*/
+// Framework include files
+#include "ConditionExampleObjects.h"
+#include "DD4hep/Factories.h"
+#include "TStatistic.h"
+#include "TTimeStamp.h"
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::ConditionExamples;
+
+namespace {
+  /// Populate the IOV and prepare the slice for it. Returns the prepare result
+  ConditionsManager::Result prepare(Detector& description, ConditionsManager manager, ConditionsSlice& slice,
+                                    const IOVType* iov_typ, int i, TStatistic& stat)
+  {
+    IOV iov(iov_typ, IOV::Key(1+i*10,(i+1)*10));
+    ConditionsPool* iov_pool = manager.registerIOV(*iov.iovType, iov.key());
+    Scanner().scan(ConditionsCreator(slice, *iov_pool, DEBUG),description.world());
+    TTimeStamp start;
+    IOV req_iov(iov_typ,i*10+5);
+    ConditionsManager::Result res = manager.prepare(req_iov,slice);
+    TTimeStamp stop;
+    stat.Fill(stop.AsDouble()-start.AsDouble());
+    printout(INFO,"Compute","Total %-6ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%4ld) of type %-25s [%8.3f sec]",
+             res.total(), res.selected, res.loaded, res.computed, res.missing,
+             req_iov.str().c_str(), stop.AsDouble()-start.AsDouble());
+    return res;
+  }
+}
+
+/// Plugin function: Condition program example
+/**
+ *  Factory: DD4hep_ConditionExample_parallel
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static int condition_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_iov = 10, num_threads = 4;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-iovs",argv[i],4) )
+      num_iov = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_ConditionExample_parallel                \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -iovs    <number>        Number of IOVs for each of the two passes.      \n"
+      "     -threads <number>        Number of threads for the parallel pass.        \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  /******************** Initialize the conditions manager *****************/
+  ConditionsManager manager = installManager(description);
+  const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
+  if ( 0 == iov_typ )
+    except("ConditionsPrepare","++ Unknown IOV type supplied.");
+
+  /******************** Now as usual: create the slice ********************/
+  shared_ptr<ConditionsContent> content(new ConditionsContent());
+  shared_ptr<ConditionsSlice> slice(new ConditionsSlice(manager,content));
+  Scanner(ConditionsKeys(*content,INFO),description.world());
+  Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+
+  ConditionsManager::Result serial, parallel;
+  TStatistic ser_stat("Serial"), par_stat("Parallel");
+  // ++++++++++++++++++++++++ Serial computation of the derived conditions
+  manager["NumberOfThreads"] = 0;
+  for(int i=0; i<num_iov; ++i)
+    serial += prepare(description, manager, *slice, iov_typ, i, ser_stat);
+  // ++++++++++++++++++++++++ Parallel computation of the derived conditions
+  manager["NumberOfThreads"] = num_threads;
+  for(int i=num_iov; i<2*num_iov; ++i)
+    parallel += prepare(description, manager, *slice, iov_typ, i, par_stat);
+
+  bool ok = serial.computed == parallel.computed && serial.missing == 0 && parallel.missing == 0;
+  printout(INFO,"Statistics","+======= Summary: # of IOV: %3d  # of Threads: %3d ========================",
+           num_iov, num_threads);
+  printout(INFO,"Statistics","+  %-12s:  %11.5g +- %11.4g  RMS = %11.5g  N = %lld",
+           ser_stat.GetName(), ser_stat.GetMean(), ser_stat.GetMeanErr(), ser_stat.GetRMS(), ser_stat.GetN());
+  printout(INFO,"Statistics","+  %-12s:  %11.5g +- %11.4g  RMS = %11.5g  N = %lld",
+           par_stat.GetName(), par_stat.GetMean(), par_stat.GetMeanErr(), par_stat.GetRMS(), par_stat.GetN());
+  printout(INFO,"Statistics","+  Serial:   (S:%6ld,L:%6ld,C:%6ld,M:%ld)",
+           serial.selected, serial.loaded, serial.computed, serial.missing);
+  printout(INFO,"Statistics","+  Parallel: (S:%6ld,L:%6ld,C:%6ld,M:%ld)  Speed-up: %6.2f",
+           parallel.selected, parallel.loaded, parallel.computed, parallel.missing,
+           ser_stat.GetMean()/par_stat.GetMean());
+  printout(ok ? INFO : ERROR,"Statistics","+  Parallel derivation test %s",ok ? "PASSED" : "FAILED");
+  printout(INFO,"Statistics","+=========================================================================");
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_ConditionExample_parallel,condition_example)
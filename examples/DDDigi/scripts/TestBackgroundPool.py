@@ -0,0 +1,49 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+from g4units import ns
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+
+  input_action = digi.input_action('DigiParallelActionSequence/READER')
+  # ========================================================================================================
+  signal = input_action.adopt_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()])
+  digi.info('Created SIGNAL input')
+  # ========================================================================================================
+  pileup = input_action.adopt_action('DigiBackgroundPool/PileupPool',
+                                     mask=0x1,
+                                     input=[digi.next_input()],
+                                     pool_size=10,
+                                     mu=5.0,
+                                     crossings=[-25 * ns, 0 * ns, 25 * ns])
+  digi.check_creation([signal, pileup])
+  digi.info('Created pile-up background pool')
+  # ========================================================================================================
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  combine = event.adopt_action('DigiContainerCombine/Combine',
+                               parallel=True,
+                               input_masks=[0x0, 0x1, 0x2, 0x3],
+                               output_mask=0xFEED,
+                               output_segment='deposits',
+                               merge_cells=True,
+                               erase_combined=False)
+  dump = event.adopt_action('DigiStoreDump/StoreDump')
+  digi.check_creation([combine, dump])
+  digi.info('Created event.dump')
+  # ========================================================================================================
+  digi.run_checked(num_events=10, num_threads=5, parallel=3)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,54 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+  kernel = digi.kernel()
+  kernel.dataFlow = True        # Schedule the actions according to their data dependencies
+  kernel.orderedOutput = True   # Write the events in order of the event number
+  # ========================================================================================================
+  # The readers write to different masks: they are independent and run concurrently
+  readers = []
+  for mask in range(4):
+    readers.append(digi.input_action('DigiDDG4ROOT/Reader-%d' % (mask,), mask=mask, input=[digi.next_input()]))
+  digi.check_creation(readers)
+  # ========================================================================================================
+  # The combination depends on all readers, the dump on the combination
+  combine = digi.event_action('DigiContainerCombine/Combine',
+                              parallel=True,
+                              input_masks=[0x0, 0x1, 0x2, 0x3],
+                              output_mask=0xFEED,
+                              output_segment='deposits',
+                              erase_combined=False)
+  dump = digi.event_action('DigiStoreDump/StoreDump', segments=['deposits'], parallel=False)
+  digi.check_creation([combine, dump])
+  # ========================================================================================================
+  writ = digi.output_action('Digi2ROOTWriter/EventWriter',
+                            parallel=True,
+                            input_mask=0x0,
+                            input_segment='inputs',
+                            output='dddigi_data_flow.root')
+  proc = digi.create_action('Digi2ROOTProcessor/Writer')
+  hit_type = 'TrackerHits'
+  if digi.hit_type:
+    hit_type = digi.hit_type
+  cont = [c + '/' + hit_type for c in digi.containers()]
+  writ.adopt_container_processor(proc, cont)
+  digi.info('Created data flow setup')
+  # ========================================================================================================
+  digi.run_checked(num_events=10, num_threads=10, parallel=4)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,61 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+from g4units import keV, ns
+
+
+def run():
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+
+  input_action = digi.input_action('DigiParallelActionSequence/READER')
+  # ========================================================================================================
+  signal = input_action.adopt_action('DigiDDG4ROOT/SignalReader',
+                                     mask=0x0,
+                                     input=[digi.next_input()],
+                                     deposit_view=True)
+  digi.info('Created SIGNAL input with deposit views')
+  # ========================================================================================================
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  # The energy cut only materializes the killed deposits of the views
+  proc = event.adopt_action('DigiContainerSequenceAction/Cut',
+                            parallel=True,
+                            input_mask=0x0,
+                            input_segment='inputs',
+                            output_mask=0x0,
+                            output_segment='inputs')
+  cut = digi.create_action('DigiDepositEnergyCut/Cut', deposit_cutoff=5 * keV)
+  proc.adopt_container_processor(cut, digi.containers())
+  # The time smearing has no view support: the views are demoted once to deposit vectors
+  smear = event.adopt_action('DigiContainerSequenceAction/Smear',
+                             parallel=True,
+                             input_mask=0x0,
+                             input_segment='inputs',
+                             output_mask=0x0,
+                             output_segment='inputs')
+  smear_time = digi.create_action('DigiDepositSmearTime/SmearTime', resolution_time=1 * ns)
+  smear.adopt_container_processor(smear_time, digi.containers()[:1])
+  # Combining the remaining views creates the deposit vectors
+  combine = event.adopt_action('DigiContainerCombine/Combine',
+                               parallel=True,
+                               input_masks=[0x0],
+                               output_mask=0xFEED,
+                               output_segment='deposits',
+                               erase_combined=True)
+  dump = event.adopt_action('DigiStoreDump/StoreDump')
+  digi.check_creation([signal, proc, smear, combine, dump])
+  digi.info('Created event.dump')
+  # ========================================================================================================
+  digi.run_checked(num_events=5, num_threads=5, parallel=3)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,100 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#  Write digi output with the parallel, cluster based mode of Digi2ROOTWriter.
+#
+#  Usage:
+#  $> python TestWriteDigiParallel.py [-threads <n>] [-events <n>]
+#             [-algorithm ZLIB|LZMA|LZ4|ZSTD] [-level <n>] [-benchmark <n1,n2,...>]
+#
+#  With -benchmark the test is re-executed for every thread count given
+#  and the table of events/s versus thread count is printed at the end.
+#
+# ==========================================================================
+from __future__ import absolute_import
+import sys
+
+
+# ---------------------------------------------------------------------------
+def option(args, name, default):
+  if name in args:
+    return args[args.index(name) + 1]
+  return default
+
+
+# ---------------------------------------------------------------------------
+def strip(args, name):
+  if name in args:
+    idx = args.index(name)
+    return args[:idx] + args[idx + 2:]
+  return args
+
+
+# ---------------------------------------------------------------------------
+def benchmark(args, threads):
+  import re
+  import subprocess
+  result = []
+  base = strip(strip(args, '-benchmark'), '-threads')
+  for t in threads:
+    cmd = [sys.executable, __file__] + base + ['-threads', str(t)]
+    out = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True).stdout
+    match = re.search(r'BENCHMARK threads:\s*(\d+) events:\s*(\d+) time:\s*([\d.]+) s rate:\s*([\d.]+)', out)
+    if not match:
+      print(out)
+      print('+++ Benchmark with %d threads FAILED' % (t,))
+      return 1
+    result.append(match.groups())
+  print('+++ %-8s %8s %10s %12s' % ('Threads', 'Events', 'Time [s]', 'Events/s'))
+  for r in result:
+    print('+++ %-8s %8s %10s %12s' % r)
+  print('+++ Benchmark PASSED')
+  return 0
+
+
+# ---------------------------------------------------------------------------
+def run(args):
+  import time
+  import DigiTest
+  threads = int(option(args, '-threads', 10))
+  events = int(option(args, '-events', 20))
+  digi = DigiTest.Test(geometry=None)
+  read = digi.input_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()])
+  writ = digi.output_action('Digi2ROOTWriter/EventWriter',
+                            parallel=True,
+                            input_mask=0x0,
+                            input_segment='input',
+                            output='dddigi_write_digi_parallel.root')
+  writ.parallel_output = True
+  writ.cluster_size = 5
+  writ.compression_algorithm = option(args, '-algorithm', 'ZSTD')
+  writ.compression_level = int(option(args, '-level', 4))
+  proc = digi.create_action('Digi2ROOTProcessor/Writer')
+  hit_type = 'TrackerHits'
+  if digi.hit_type:
+    hit_type = digi.hit_type
+  cont = [c + '/' + hit_type for c in digi.containers()]
+  writ.adopt_container_processor(proc, cont)
+  writ.adopt_container_processor(proc, 'MCParticles/MCParticles')
+  digi.check_creation([read])
+  start = time.time()
+  done = digi.run_checked(num_events=events, num_threads=threads, parallel=threads)
+  stop = time.time()
+  digi.always('BENCHMARK threads: %d events: %d time: %.3f s rate: %.2f'
+              % (threads, done, stop - start, done / max(stop - start, 1e-6)))
+
+
+# ---------------------------------------------------------------------------
+if __name__ == '__main__':
+  args = sys.argv[1:]
+  if '-benchmark' in args:
+    sys.exit(benchmark(args, [int(t) for t in option(args, '-benchmark', '1,2,4,8').split(',')]))
+  run(args)
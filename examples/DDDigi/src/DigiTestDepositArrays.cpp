@@ -0,0 +1,172 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/DD4hepUnits.h>
+#include <DDDigi/DigiData.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiPlugins.h>
+#include <DDDigi/DigiRandomGenerator.h>
+#include <DDDigi/DigiContainerProcessor.h>
+
+/// C/C++ include files
+#include <chrono>
+#include <random>
+#include <iostream>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+namespace {
+
+  /// Event context with a private, reproducible random generator
+  class BenchmarkContext : public DigiContext   {
+    std::mt19937_64 m_generator;
+  public:
+    BenchmarkContext(const DigiKernel& krnl, unsigned long seed)
+      : DigiContext(krnl, std::make_unique<DigiEvent>(1)), m_generator(seed)
+    {
+      auto random = std::make_shared<DigiRandomGenerator>();
+      random->engine = [this] {
+        return 1e0 - std::generate_canonical<double, 64>(m_generator); // uniform on ] 0, 1 ]
+      };
+      this->set_random_generator(random);
+    }
+  };
+
+  /// Execute the processor chain on one deposit container. Returns the elapsed time in ms
+  template <typename CONTAINER>
+  double execute_chain(const DigiKernel& krnl, const std::vector<DigiContainerProcessor*>& chain, CONTAINER& cont, unsigned long seed)  {
+    using processor_t = DigiContainerProcessor;
+    BenchmarkContext context(krnl, seed);
+    PropertyManager  properties;
+    processor_t::output_t output { 0, context.event->get_segment("outputs") };
+    processor_t::env_t    env    { context, properties, output };
+    Key      key  = cont.key;
+    std::any data = std::move(cont);
+    processor_t::work_t   work   { env, { &context.event->get_segment("inputs"), key, &data } };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    chain[0]->execute(context, work, processor_t::accept_all());
+    for( std::size_t i = 1; i < chain.size(); ++i )
+      chain[i]->execute(context, work, processor_t::accept_not_killed());
+    auto stop = std::chrono::high_resolution_clock::now();
+    cont = std::move(*std::any_cast<CONTAINER>(&data));
+    return std::chrono::duration<double, std::milli>(stop - start).count();
+  }
+}
+
+/// Plugin to benchmark deposit processing on vectors and on structures of arrays
+/**
+ *  The same deposits are processed by the energy cut, energy smearing,
+ *  time smearing and zero suppression actions once stored in a DepositVector
+ *  and once in DepositArrays. Both results must be identical.
+ *
+ *  Factory: DD4hep_DigiDepositArraysBenchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static long benchmark_deposit_arrays(Detector& description, int argc, char** argv) {
+  using namespace dd4hep::detail;
+  std::size_t num_deposits = 1000000;
+  std::size_t num_loops    = 1;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-deposits",argv[i],3) )
+      num_deposits = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-loops",argv[i],3) )
+      num_loops    = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiDepositArraysBenchmark -arg [-arg]                 \n"
+        "     -deposits <value>  Number of energy deposits [default: 1000000]         \n"
+        "     -loops    <value>  Number of benchmark iterations [default: 1]          \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+
+  DigiKernel& krnl = DigiKernel::instance(description);
+  std::vector<DigiContainerProcessor*> chain;
+  chain.emplace_back(createAction<DigiContainerProcessor>("DigiDepositEnergyCut",    krnl, "EnergyCut"));
+  chain.emplace_back(createAction<DigiContainerProcessor>("DigiDepositSmearEnergy",  krnl, "SmearEnergy"));
+  chain.emplace_back(createAction<DigiContainerProcessor>("DigiDepositSmearTime",    krnl, "SmearTime"));
+  chain.emplace_back(createAction<DigiContainerProcessor>("DigiDepositZeroSuppress", krnl, "ZeroSuppress"));
+  for( auto* proc : chain )  {
+    if ( !proc ) except("DepositArrays","+++ Failed to create deposit processor!");
+    proc->property("OutputLevel").set(int(WARNING));
+  }
+  chain[0]->property("deposit_cutoff").set(0.05*dd4hep::MeV);
+  chain[1]->property("intrinsic_fluctuation").set(0.005);
+  chain[1]->property("systematic_resolution").set(0.01);
+  chain[2]->property("resolution_time").set(1e0*dd4hep::ns);
+  chain[2]->property("window_time").set(std::make_pair(-3e0*dd4hep::ns, 3e0*dd4hep::ns));
+  chain[3]->property("threshold").set(0.1*dd4hep::MeV);
+
+  std::mt19937_64 generator(12345);
+  std::uniform_real_distribution<double> energy(0e0, 1e0*dd4hep::MeV);
+  std::uniform_real_distribution<double> time(0e0, 25e0*dd4hep::ns);
+  std::uniform_real_distribution<double> coord(-1e0*dd4hep::m, 1e0*dd4hep::m);
+  DepositVector input("deposits", 0xFEED, SegmentEntry::TRACKER_HITS);
+  for( std::size_t i = 0; i < num_deposits; ++i )  {
+    EnergyDeposit depo;
+    depo.deposit  = energy(generator);
+    depo.time     = time(generator);
+    depo.position = Position(coord(generator), coord(generator), coord(generator));
+    depo.momentum = Direction(0e0, 0e0, 1e0);
+    depo.length   = 1e0*dd4hep::mm;
+    depo.mask     = 0xFEED;
+    input.emplace(generator(), std::move(depo));
+  }
+
+  double time_vector = 0e0, time_arrays = 0e0;
+  std::size_t errors = 0;
+  printout(INFO, "DepositArrays", "Processing %ld deposits in %ld loops ....", num_deposits, num_loops);
+  for( std::size_t loop = 0; loop < num_loops; ++loop )  {
+    DepositVector vector(input);
+    DepositArrays arrays("deposits", 0xFEED, SegmentEntry::TRACKER_HITS);
+    arrays.insert(input);
+    time_vector += execute_chain(krnl, chain, vector, loop+1);
+    time_arrays += execute_chain(krnl, chain, arrays, loop+1);
+
+    for( std::size_t i = 0; i < num_deposits; ++i )  {
+      const auto& depo = vector.at(i);
+      if ( depo.deposit      != arrays.deposit[i]      ||
+           depo.depositError != arrays.depositError[i] ||
+           depo.time         != arrays.time[i]         ||
+           depo.flag         != arrays.flag[i] )   {
+        if ( ++errors < 10 )  {
+          printout(ERROR, "DepositArrays", "Deposit %ld differs: E: %g <> %g  T: %g <> %g flag: %lX <> %lX",
+                   i, depo.deposit, arrays.deposit[i], depo.time, arrays.time[i], depo.flag, arrays.flag[i]);
+        }
+      }
+    }
+  }
+  for( auto* proc : chain )
+    proc->release();
+
+  printout(INFO, "DepositArrays", "DepositVector (AoS) processing time: %10.3f ms", time_vector/double(num_loops));
+  printout(INFO, "DepositArrays", "DepositArrays (SoA) processing time: %10.3f ms", time_arrays/double(num_loops));
+  printout(INFO, "DepositArrays", "Speedup of the SoA processing:       %10.2f",
+           time_arrays > 0e0 ? time_vector/time_arrays : 0e0);
+  if ( errors > 0 )  {
+    printout(ERROR, "DepositArrays", "+++ %ld deposits differ between AoS and SoA processing.", errors);
+    return 0;
+  }
+  printout(INFO, "DepositArrays", "+++ Deposit arrays benchmark PASSED");
+  return 1;
+}
+DECLARE_APPLY(DD4hep_DigiDepositArraysBenchmark,benchmark_deposit_arrays)
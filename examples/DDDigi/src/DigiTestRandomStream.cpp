@@ -0,0 +1,152 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DD4hep/Factories.h>
+#include <DD4hep/Printout.h>
+#include <DDDigi/DigiRandomStream.h>
+#include <DDDigi/DigiRandomGenerator.h>
+
+/// C/C++ include files
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+#include <TRandom.h>
+
+using namespace dd4hep;
+using namespace dd4hep::digi;
+
+namespace {
+  using clock_t = std::chrono::high_resolution_clock;
+
+  /// Throughput in million variates per second
+  double throughput(std::size_t num, clock_t::time_point start, clock_t::time_point stop)  {
+    double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+    return ms > 0e0 ? double(num) / ms / 1e3 : 0e0;
+  }
+  /// Print mean and RMS of a gaussian sample. Returns false if the sample is off
+  bool check_gaussian(const char* tag, const std::vector<double>& values)  {
+    double sum = 0e0, sum2 = 0e0;
+    for( double v : values )  {
+      sum  += v;
+      sum2 += v*v;
+    }
+    double num  = double(values.size());
+    double mean = sum/num;
+    double rms  = std::sqrt(sum2/num - mean*mean);
+    double err  = 5e0/std::sqrt(num);
+    printout(INFO, "RandomStream", "%-28s Mean: %9.5f RMS: %9.5f", tag, mean, rms);
+    return std::abs(mean) < err && std::abs(rms-1e0) < err;
+  }
+}
+
+/// Plugin to test and benchmark the counter based random streams
+/**
+ *  - Check the Philox-4x32-10 known answers.
+ *  - Check that a stream is independent of the processing order of other streams
+ *    and that bulk generation in pieces reproduces the bulk generation at once.
+ *  - Compare the throughput of scalar gaussian generation with the
+ *    DigiRandomGenerator to the bulk generation of the random streams.
+ *
+ *  Factory: DD4hep_DigiRandomStreamBenchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ */
+static long benchmark_random_stream(Detector& , int argc, char** argv) {
+  using namespace dd4hep::detail;
+  std::size_t num_values = 10000000;
+  std::size_t num_cells  = 1000;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-numbers",argv[i],3) )
+      num_values = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-cells",argv[i],3) )
+      num_cells  = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_DigiRandomStreamBenchmark -arg [-arg]                  \n"
+        "     -numbers  <value>  Number of variates to be generated [default: 10^7]   \n"
+        "     -cells    <value>  Number of cell streams [default: 1000]               \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  std::size_t errors = 0;
+
+  /// Known answers of the Philox-4x32-10 bijection (Random123 distribution)
+  auto kat0 = DigiRandomStream::philox({0, 0, 0, 0}, {0, 0});
+  auto kat1 = DigiRandomStream::philox({0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF}, {0xFFFFFFFF, 0xFFFFFFFF});
+  if ( kat0 != DigiRandomStream::block_t{0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8} ||
+       kat1 != DigiRandomStream::block_t{0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD} )  {
+    printout(ERROR, "RandomStream", "+++ Philox known answer test FAILED.");
+    ++errors;
+  }
+
+  /// Per-cell streams must not depend on the processing order of the cells
+  std::size_t per_cell = 64;
+  std::uint64_t seed = DigiRandomStream::combine(12345, 1);
+  std::vector<double> forward(num_cells*per_cell), backward(num_cells*per_cell);
+  for( std::size_t c = 0; c < num_cells; ++c )  {
+    DigiRandomStream stream(seed, c);
+    stream.gaussian(&forward[c*per_cell], per_cell);
+  }
+  for( std::size_t c = num_cells; c > 0; --c )  {
+    DigiRandomStream stream(seed, c-1);
+    for( std::size_t i = 0; i < per_cell; i += 16 )
+      stream.gaussian(&backward[(c-1)*per_cell+i], 16);
+  }
+  if ( forward != backward )  {
+    printout(ERROR, "RandomStream", "+++ Random streams are not reproducible.");
+    ++errors;
+  }
+
+  /// Throughput: scalar generation through the DigiRandomGenerator
+  TRandom root_random;
+  DigiRandomGenerator generator;
+  generator.engine = [&root_random] {  return root_random.Uniform(1.0);  };
+  std::vector<double> values(num_values);
+  auto start = clock_t::now();
+  for( std::size_t i = 0; i < num_values; ++i )
+    values[i] = generator.gaussian(0e0, 1e0);
+  auto stop  = clock_t::now();
+  double rate_scalar = throughput(num_values, start, stop);
+  if ( !check_gaussian("DigiRandomGenerator gaussian", values) ) ++errors;
+
+  /// Throughput: bulk uniform generation of the random streams
+  DigiRandomStream stream(seed, 0);
+  start = clock_t::now();
+  stream.uniform(values.data(), num_values);
+  stop  = clock_t::now();
+  double rate_uniform = throughput(num_values, start, stop);
+
+  /// Throughput: bulk gaussian generation of the random streams
+  stream.seek(0);
+  start = clock_t::now();
+  stream.gaussian(values.data(), num_values);
+  stop  = clock_t::now();
+  double rate_gauss = throughput(num_values, start, stop);
+  if ( !check_gaussian("DigiRandomStream gaussian", values) ) ++errors;
+
+  printout(INFO, "RandomStream", "Scalar gaussian  (DigiRandomGenerator): %8.2f Mvariates/s", rate_scalar);
+  printout(INFO, "RandomStream", "Bulk uniform     (DigiRandomStream):    %8.2f Mvariates/s", rate_uniform);
+  printout(INFO, "RandomStream", "Bulk gaussian    (DigiRandomStream):    %8.2f Mvariates/s", rate_gauss);
+  if ( errors > 0 )  {
+    printout(ERROR, "RandomStream", "+++ Random stream test FAILED with %ld errors.", errors);
+    return 0;
+  }
+  printout(INFO, "RandomStream", "+++ Random stream test PASSED");
+  return 1;
+}
+DECLARE_APPLY(DD4hep_DigiRandomStreamBenchmark,benchmark_random_stream)